@@ -0,0 +1,80 @@
+#pragma once
+
+// Bench.hpp
+// Minimal benchmark harness: registration, timing and reporting
+//
+// Usage (in any bench/*.cpp file):
+//   BENCHMARK(spatialQueries) {
+//       reportResult(measure("grid/countAt", [&](std::uint64_t n) {
+//           for (std::uint64_t i = 0; i < n; ++i) doNotOptimize(grid.countAt(r, c));
+//       }));
+//   }
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Timing result for one measured operation
+struct BenchResult {
+    std::string name;          // Benchmark label
+    std::uint64_t iterations;  // Operations timed in the final batch
+    double nsPerOp;            // Mean wall time per operation
+};
+
+// Run fn with growing batch sizes until one batch takes at least minSeconds
+// Parameters:
+//   - name: Label for the result
+//   - fn: Called as fn(n); must perform n operations
+//   - minSeconds: Minimum duration of the measured batch
+// Returns: Time per operation from the final batch
+template <typename Fn>
+BenchResult measure(const std::string& name, Fn&& fn, double minSeconds = 0.2) {
+    using clock = std::chrono::steady_clock;
+
+    std::uint64_t n = 1;
+    while (true) {
+        auto start = clock::now();
+        fn(n);
+        double seconds = std::chrono::duration<double>(clock::now() - start).count();
+
+        if (seconds >= minSeconds || n >= (1ULL << 40)) {
+            return BenchResult{name, n, seconds * 1e9 / static_cast<double>(n)};
+        }
+
+        // Aim straight for the target instead of doubling from tiny batches
+        double scale = seconds > 0.0 ? (minSeconds * 1.2) / seconds : 100.0;
+        if (scale < 2.0) scale = 2.0;
+        if (scale > 100.0) scale = 100.0;
+        n = static_cast<std::uint64_t>(static_cast<double>(n) * scale);
+    }
+}
+
+// Print a result as one aligned line
+void reportResult(const BenchResult& result);
+
+// Keep a value alive so the optimizer cannot delete the work producing it
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Registration
+
+using BenchFunction = void (*)();
+
+// All registered benchmark groups, in registration order
+std::vector<std::pair<const char*, BenchFunction>>& benchRegistry();
+
+struct BenchRegistration {
+    BenchRegistration(const char* name, BenchFunction fn) {
+        benchRegistry().emplace_back(name, fn);
+    }
+};
+
+// Define and register a benchmark group
+#define BENCHMARK(name)                                             \
+    static void name();                                             \
+    static BenchRegistration name##Registration{#name, name};       \
+    static void name()
@@ -0,0 +1,83 @@
+#include "Bench.hpp"
+#include "Camera.hpp"
+#include "CellGrid.hpp"
+#include "GameState.hpp"
+#include "RenderSnapshot.hpp"
+#include "Renderer.hpp"
+#include "TileMap.hpp"
+
+#include <cstdio>
+#include <memory>
+
+// ============================================================================
+// CameraBench.cpp
+// Dead-zone scrolling, and frame cost against world size
+// ============================================================================
+
+namespace {
+
+// Walk the player right across a wide world and count camera scrolls;
+// returns false if the player ever leaves the view or the view the world
+bool walkStaysInView(int& scrolls) {
+    const int WORLD_ROWS = 100;
+    const int WORLD_COLS = 1000;
+    Camera camera{20, 40};
+    camera.follow(50, 1, WORLD_ROWS, WORLD_COLS);
+    scrolls = 0;
+    for (int col = 1; col < WORLD_COLS - 1; ++col) {
+        int before = camera.left();
+        camera.follow(50, col, WORLD_ROWS, WORLD_COLS);
+        scrolls += camera.left() != before;
+        if (!camera.contains(50, col) || camera.left() + camera.cols() > WORLD_COLS) {
+            return false;
+        }
+    }
+    // Stepping back and forth inside the dead zone never scrolls
+    Camera centred{20, 40};
+    centred.follow(50, WORLD_COLS / 2, WORLD_ROWS, WORLD_COLS);
+    const int settled = centred.left();
+    for (int i = 0; i < 100; ++i) {
+        centred.follow(50, WORLD_COLS / 2 - (i % 5), WORLD_ROWS, WORLD_COLS);
+        if (centred.left() != settled) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+BENCHMARK(camera) {
+    int scrolls = 0;
+    bool ok = walkStaysInView(scrolls);
+    std::printf("  player always in view: %s (%d scrolls over 998 steps)\n", ok ? "yes" : "NO", scrolls);
+
+    // A terminal-sized frame over ever larger worlds
+    struct World {
+        const char* name;
+        int rows;
+        int cols;
+    };
+    const World worlds[] = {
+        {"camera/composeMap 50x160, world 100x200", 100, 200},
+        {"camera/composeMap 50x160, world 250x250 (flat)", 250, 250},
+        {"camera/composeMap 50x160, world 4096x4096 (chunked)", 4096, 4096},
+        {"camera/composeMap 50x160, world 16384x16384 (chunked)", 16384, 16384},
+    };
+    // The map view is the frame less the HUD (what the default frame has
+    // below its map)
+    CellGrid frame{50, 160};
+    RenderSnapshot snapshot;
+    const int hudRows = frameRows() - GameState::MAP_ROWS;
+    for (const World& world : worlds) {
+        GameState state{100, 10, 16, std::make_shared<TileMap>(world.rows, world.cols)};
+        Camera camera{frame.rows() - hudRows, frame.cols()};
+        reportResult(measure(world.name, [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) {
+                captureRenderSnapshot(state, camera, snapshot);
+                composeMap(snapshot, frame);
+                doNotOptimize(frame.at(0, 0));
+            }
+        }));
+    }
+}
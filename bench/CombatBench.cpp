@@ -0,0 +1,78 @@
+#include "Bench.hpp"
+#include "CombatKernel.hpp"
+#include "EnemyStore.hpp"
+
+#include <cstdio>
+#include <random>
+#include <string>
+
+// ============================================================================
+// CombatBench.cpp
+// Batched combat pass: vector kernel vs. scalar reference
+// ============================================================================
+
+namespace {
+
+constexpr int ROWS = 512;
+constexpr int COLS = 512;
+constexpr int PLAYER_ROW = 100;
+constexpr int PLAYER_COL = 200;
+
+// Enemies scattered over the map, with a fraction placed on the player's tile
+// Health is high enough that repeated rounds never kill them
+EnemyStore makeEnemies(std::size_t count, double onPlayerTile) {
+    std::mt19937 rng{7};
+    std::uniform_int_distribution<int> pickRow{0, ROWS - 1};
+    std::uniform_int_distribution<int> pickCol{0, COLS - 1};
+    std::uniform_real_distribution<double> chance{0.0, 1.0};
+
+    EnemyStore enemies{ROWS, COLS, count};
+    for (std::size_t i = 0; i < count; ++i) {
+        bool fighting = chance(rng) < onPlayerTile;
+        enemies.add(1'000'000'000, 1,
+                    fighting ? PLAYER_ROW : pickRow(rng),
+                    fighting ? PLAYER_COL : pickCol(rng));
+    }
+    return enemies;
+}
+
+// Both kernels must agree before their timings mean anything
+bool kernelsAgree(std::size_t count) {
+    EnemyStore a = makeEnemies(count, 0.3);
+    for (std::size_t i = 0; i < count; i += 3) {
+        a.health[i] = 1 + static_cast<int>(i % 5);  // Some die this round
+    }
+    EnemyStore b = a;
+
+    CombatResult ra, rb;
+    resolveCombat(PLAYER_ROW, PLAYER_COL, 3, a, ra);
+    resolveCombatScalar(PLAYER_ROW, PLAYER_COL, 3, b, rb);
+    return ra.struck == rb.struck && ra.killed == rb.killed &&
+           ra.damageToPlayer == rb.damageToPlayer && a.health == b.health;
+}
+
+}  // namespace
+
+BENCHMARK(combatKernel) {
+    std::printf("  kernel isa: %s, matches scalar: %s\n", combatKernelIsa(),
+                kernelsAgree(100'003) ? "yes" : "NO");
+
+    CombatResult result;
+    for (double fraction : {0.0, 0.01, 1.0}) {
+        EnemyStore enemies = makeEnemies(100'000, fraction);
+        std::string label = "n=100000 onTile=" + std::to_string(static_cast<int>(fraction * 100)) + "%";
+
+        reportResult(measure("combat/simd   " + label, [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) {
+                resolveCombat(PLAYER_ROW, PLAYER_COL, 0, enemies, result);
+                doNotOptimize(result.damageToPlayer);
+            }
+        }));
+        reportResult(measure("combat/scalar " + label, [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) {
+                resolveCombatScalar(PLAYER_ROW, PLAYER_COL, 0, enemies, result);
+                doNotOptimize(result.damageToPlayer);
+            }
+        }));
+    }
+}
@@ -0,0 +1,107 @@
+#include "Bench.hpp"
+#include "Enemy.hpp"
+#include "EnemyStore.hpp"
+#include "FlowField.hpp"
+#include "Pathfinder.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+
+// ============================================================================
+// EnemyAIBench.cpp
+// Enemy AI update: scaling with thread count
+// ============================================================================
+
+namespace {
+
+constexpr int ROWS = 1024;
+constexpr int COLS = 1024;
+
+// Enemies scattered over a large map, some close enough to chase
+EnemyStore makeEnemies(std::size_t count) {
+    std::mt19937 rng{11};
+    std::uniform_int_distribution<int> pickRow{1, ROWS - 2};
+    std::uniform_int_distribution<int> pickCol{1, COLS - 2};
+
+    EnemyStore enemies{ROWS, COLS, count};
+    for (std::size_t i = 0; i < count; ++i) {
+        enemies.add(EnemyStore::DEFAULT_HEALTH, EnemyStore::DEFAULT_ATTACK,
+                    pickRow(rng), pickCol(rng));
+    }
+    return enemies;
+}
+
+// Open map with a border wall, rooted at the centre
+FlowField makeField() {
+    FlowField field{ROWS, COLS};
+    field.setWalls([](int r, int c) {
+        return r >= 1 && r < ROWS - 1 && c >= 1 && c < COLS - 1;
+    });
+    field.setRoot(ROWS / 2, COLS / 2);
+    return field;
+}
+
+// Route service over the same open map
+Pathfinder makePaths() {
+    Pathfinder paths{ROWS, COLS};
+    paths.setWalls([](int r, int c) {
+        return r >= 1 && r < ROWS - 1 && c >= 1 && c < COLS - 1;
+    });
+    return paths;
+}
+
+// A few updates on every thread count must land every enemy on the same tile
+bool threadCountsAgree(std::size_t count, const FlowField& chase, unsigned maxThreads) {
+    EnemyStore reference = makeEnemies(count);
+    Pathfinder referencePaths = makePaths();
+    setEnemyAIThreads(1);
+    for (std::uint64_t tick = 0; tick < 4; ++tick) {
+        updateEnemyAI(reference, chase, referencePaths, tick);
+    }
+
+    for (unsigned threads = 2; threads <= maxThreads; threads *= 2) {
+        EnemyStore enemies = makeEnemies(count);
+        Pathfinder paths = makePaths();
+        setEnemyAIThreads(threads);
+        for (std::uint64_t tick = 0; tick < 4; ++tick) {
+            updateEnemyAI(enemies, chase, paths, tick);
+        }
+        if (enemies.row != reference.row || enemies.col != reference.col) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+BENCHMARK(enemyAI) {
+    // Always try a few threads so the parallel path runs even on small machines
+    const unsigned maxThreads = std::max(4u, std::min(32u, std::thread::hardware_concurrency()));
+    FlowField chase = makeField();
+    Pathfinder paths = makePaths();
+
+    std::printf("  hardware threads: %u, matches single-threaded: %s\n",
+                std::thread::hardware_concurrency(),
+                threadCountsAgree(200'003, chase, maxThreads) ? "yes" : "NO");
+
+    for (std::size_t count : {100'000u, 1'000'000u}) {
+        EnemyStore enemies = makeEnemies(count);
+        for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+            setEnemyAIThreads(threads);
+            std::uint64_t tick = 0;
+            std::string label = "enemyAI n=" + std::to_string(count) +
+                                " threads=" + std::to_string(threads);
+            reportResult(measure(label, [&](std::uint64_t n) {
+                for (std::uint64_t i = 0; i < n; ++i) {
+                    updateEnemyAI(enemies, chase, paths, tick++);
+                }
+                doNotOptimize(enemies.row[0]);
+            }));
+        }
+    }
+    setEnemyAIThreads(0);
+}
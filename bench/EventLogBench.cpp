@@ -0,0 +1,115 @@
+#include "Bench.hpp"
+#include "EventLog.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+// ============================================================================
+// EventLogBench.cpp
+// Cost of logging a message, reads racing the writer, and the file sink
+// ============================================================================
+
+namespace {
+
+// Read the ring as fast as possible while another thread floods it; every
+// event that reads back must be the one pushed with that sequence number.
+// Returns the number of bad reads (should be 0)
+std::uint64_t readsWhileWriting(std::uint64_t pushes, std::uint64_t& good, std::uint64_t& missed) {
+    EventLog log;
+    std::atomic<bool> done{false};
+    std::thread writer{[&] {
+        for (std::uint64_t i = 0; i < pushes; ++i) {
+            log.setTick(i);
+            const int value = static_cast<int>(i);
+            log.push(LogEventType::ExperienceGained, value, value + 1, value + 2);
+        }
+        done.store(true, std::memory_order_release);
+    }};
+
+    std::uint64_t bad = 0;
+    good = 0;
+    missed = 0;
+    std::uint64_t seq = 0;
+    LogEvent event;
+    while (!done.load(std::memory_order_acquire) || seq < log.written()) {
+        const std::uint64_t end = log.written();
+        if (end - seq > EventLog::CAPACITY) {
+            missed += end - EventLog::CAPACITY - seq;
+            seq = end - EventLog::CAPACITY;
+        }
+        for (; seq < end; ++seq) {
+            if (!log.read(seq, event)) {
+                missed++;
+                continue;
+            }
+            const int value = static_cast<int>(seq);
+            bad += event.tick != seq || event.type != LogEventType::ExperienceGained ||
+                   event.a != value || event.b != value + 1 || event.c != value + 2;
+            good++;
+        }
+    }
+    writer.join();
+    return bad;
+}
+
+}  // namespace
+
+BENCHMARK(eventLog) {
+    std::uint64_t good = 0;
+    std::uint64_t missed = 0;
+    const std::uint64_t bad = readsWhileWriting(2000000, good, missed);
+    std::printf("  reads racing the writer: %llu good, %llu overwritten first, %llu torn%s\n",
+                static_cast<unsigned long long>(good), static_cast<unsigned long long>(missed),
+                static_cast<unsigned long long>(bad), bad == 0 ? "" : " (BROKEN)");
+
+    {
+        EventLog log;
+        reportResult(measure("eventLog/push", [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) {
+                log.push(LogEventType::PlayerAttack, static_cast<int>(i));
+            }
+            doNotOptimize(log.written());
+        }));
+    }
+
+    {
+        EventLog log;
+        for (int i = 0; i < 5; ++i) {
+            log.push(LogEventType::EnemyAttack, i);
+        }
+        char text[128];
+        LogEvent event;
+        reportResult(measure("eventLog/read+format (one panel line)", [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) {
+                log.read(i % 5, event);
+                doNotOptimize(formatLogEvent(event, text, sizeof(text)));
+            }
+        }));
+    }
+
+    // Push while the file sink drains to /dev/null; the push cost should
+    // stay as above since the sink never holds up the writer. A writer this
+    // fast laps the ring between batches, so most events are lost here; the
+    // game writes a few per tick.
+    {
+        auto log = std::make_shared<EventLog>();
+        auto file = std::make_unique<EventLogFile>(log, "/dev/null");
+        reportResult(measure("eventLog/push with file sink running", [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) {
+                log->push(LogEventType::Healed, static_cast<int>(i));
+            }
+        }));
+        // Give it time for a last batch, then check every event is accounted for
+        std::this_thread::sleep_for(std::chrono::milliseconds{3 * EventLogFile::FLUSH_INTERVAL_MS});
+        const std::uint64_t pushed = log->written();
+        const std::uint64_t accounted = file->eventsWritten() + file->eventsLost();
+        std::printf("  file sink: %llu of %llu events written, %llu lost%s\n",
+                    static_cast<unsigned long long>(file->eventsWritten()),
+                    static_cast<unsigned long long>(pushed),
+                    static_cast<unsigned long long>(file->eventsLost()),
+                    accounted == pushed ? "" : " (UNACCOUNTED)");
+    }
+}
@@ -0,0 +1,112 @@
+#include "Bench.hpp"
+#include "Camera.hpp"
+#include "CellGrid.hpp"
+#include "Enemy.hpp"
+#include "FieldOfView.hpp"
+#include "GameState.hpp"
+#include "RenderSnapshot.hpp"
+#include "Renderer.hpp"
+#include "TileMap.hpp"
+
+#include <cstdio>
+#include <memory>
+#include <random>
+
+// ============================================================================
+// FieldOfViewBench.cpp
+// Shadowcasting cost, the symmetry guarantee, and fog-of-war frame drawing
+// ============================================================================
+
+namespace {
+
+constexpr int ROWS = 200;
+constexpr int COLS = 200;
+
+// Scattered pillars (about 1 tile in 8) inside the default walled room
+std::shared_ptr<TileMap> pillarMap(int rows, int cols) {
+    auto map = std::make_shared<TileMap>(rows, cols);
+    std::mt19937 rng{4};
+    for (int r = 1; r < rows - 1; ++r) {
+        for (int c = 1; c < cols - 1; ++c) {
+            if (rng() % 8 == 0) {
+                map->setWalkable(r, c, false);
+            }
+        }
+    }
+    return map;
+}
+
+// For random floor pairs within sight: A sees B exactly when B sees A
+bool isSymmetric(const TileMap& map, int pairs) {
+    std::mt19937 rng{8};
+    FieldOfView fromA{12, 12};
+    FieldOfView fromB{12, 12};
+    int tested = 0;
+    while (tested < pairs) {
+        int aRow = 1 + static_cast<int>(rng() % (ROWS - 2));
+        int aCol = 1 + static_cast<int>(rng() % (COLS - 2));
+        int bRow = aRow + static_cast<int>(rng() % 25) - 12;
+        int bCol = aCol + static_cast<int>(rng() % 25) - 12;
+        if (!map.contains(bRow, bCol) || !map.isWalkable(aRow, aCol) || !map.isWalkable(bRow, bCol)) {
+            continue;
+        }
+        fromA.update(map, aRow, aCol);
+        fromB.update(map, bRow, bCol);
+        if (fromA.isVisible(bRow, bCol) != fromB.isVisible(aRow, aCol)) {
+            return false;
+        }
+        tested++;
+    }
+    return true;
+}
+
+}  // namespace
+
+BENCHMARK(fieldOfView) {
+    std::shared_ptr<TileMap> map = pillarMap(ROWS, COLS);
+    std::printf("  symmetric over 20000 pairs: %s\n", isSymmetric(*map, 20000) ? "yes" : "NO");
+
+    // Screen-sized sight, as the game uses
+    FieldOfView sight{GameState::MAP_ROWS - 1, GameState::MAP_COLS - 1};
+    int step = 0;
+    reportResult(measure("fov/update, player steps (pillars)", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            step++;
+            sight.update(*map, ROWS / 2, COLS / 2 + (step & 1));
+        }
+    }));
+    std::printf("  visible tiles: %zu of %d in reach\n", sight.visibleCount(),
+                (2 * sight.radiusRows() + 1) * (2 * sight.radiusCols() + 1));
+
+    reportResult(measure("fov/update, player still (cached)", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            doNotOptimize(sight.update(*map, ROWS / 2, COLS / 2));
+        }
+    }));
+
+    auto room = std::make_shared<TileMap>(ROWS, COLS);
+    reportResult(measure("fov/update, player steps (open room)", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            step++;
+            sight.update(*room, ROWS / 2, COLS / 2 + (step & 1));
+        }
+    }));
+
+    // Whole frame with fog of war; cost follows the window, not the enemies
+    CellGrid frame{frameRows(), frameCols()};
+    RenderSnapshot snapshot;
+    for (std::size_t enemyCount : {std::size_t{10}, std::size_t{10000}}) {
+        GameState state{100, 10, enemyCount, map};
+        spawnEnemies(state, enemyCount - 1);
+        Camera camera{GameState::MAP_ROWS, frame.cols()};
+        char name[64];
+        std::snprintf(name, sizeof(name), "fov/composeMap, %zu enemies", enemyCount);
+        reportResult(measure(name, [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) {
+                captureRenderSnapshot(state, camera, snapshot);
+                composeMap(snapshot, frame);
+                doNotOptimize(frame.at(0, 0));
+            }
+        }));
+    }
+}
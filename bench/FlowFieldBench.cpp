@@ -0,0 +1,174 @@
+#include "Bench.hpp"
+#include "FlowField.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// FlowFieldBench.cpp
+// Shared chase field: incremental updates vs. rebuilding from scratch
+// ============================================================================
+
+namespace {
+
+// Random walls (about 1 tile in 5) inside a solid border
+std::vector<std::uint8_t> randomWalls(int rows, int cols, std::mt19937& rng) {
+    std::uniform_int_distribution<int> roll{0, 4};
+    std::vector<std::uint8_t> walkable(static_cast<std::size_t>(rows) * cols, 0);
+    for (int r = 1; r < rows - 1; ++r) {
+        for (int c = 1; c < cols - 1; ++c) {
+            walkable[static_cast<std::size_t>(r) * cols + c] = roll(rng) != 0;
+        }
+    }
+    return walkable;
+}
+
+FlowField buildField(int rows, int cols, const std::vector<std::uint8_t>& walkable,
+                     int rootRow, int rootCol) {
+    FlowField field{rows, cols};
+    field.setWalls([&](int r, int c) { return walkable[static_cast<std::size_t>(r) * cols + c] != 0; });
+    field.setRoot(rootRow, rootCol);
+    return field;
+}
+
+bool sameDistances(const FlowField& a, const FlowField& b) {
+    for (int r = 0; r < a.rows(); ++r) {
+        for (int c = 0; c < a.cols(); ++c) {
+            if (a.distance(r, c) != b.distance(r, c)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Random root walk and wall toggles, checked against a fresh build each step
+bool incrementalMatchesRebuild(int rows, int cols, int steps) {
+    std::mt19937 rng{5};
+    std::vector<std::uint8_t> walkable = randomWalls(rows, cols, rng);
+    int rootRow = rows / 2;
+    int rootCol = cols / 2;
+    walkable[static_cast<std::size_t>(rootRow) * cols + rootCol] = 1;
+    FlowField field = buildField(rows, cols, walkable, rootRow, rootCol);
+
+    std::uniform_int_distribution<int> pickRow{1, rows - 2};
+    std::uniform_int_distribution<int> pickCol{1, cols - 2};
+    std::uniform_int_distribution<int> pickDir{0, 3};
+    const int DR[] = {-1, 1, 0, 0};
+    const int DC[] = {0, 0, -1, 1};
+
+    for (int step = 0; step < steps; ++step) {
+        // Toggle a wall somewhere (never under the root)
+        int r = pickRow(rng);
+        int c = pickCol(rng);
+        if (r != rootRow || c != rootCol) {
+            std::uint8_t& tile = walkable[static_cast<std::size_t>(r) * cols + c];
+            tile = !tile;
+            field.setWalkable(r, c, tile != 0);
+        }
+
+        // Step the root onto a walkable neighbour
+        int dir = pickDir(rng);
+        int nr = rootRow + DR[dir];
+        int nc = rootCol + DC[dir];
+        if (walkable[static_cast<std::size_t>(nr) * cols + nc]) {
+            rootRow = nr;
+            rootCol = nc;
+            field.setRoot(rootRow, rootCol);
+        }
+
+        if (!sameDistances(field, buildField(rows, cols, walkable, rootRow, rootCol))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Tiles written per root step over a random walk, against the tiles in
+// the field (a step used to lower about half of them)
+void printStepCost(int rows, int cols, const std::string& label) {
+    std::mt19937 rng{13};
+    std::vector<std::uint8_t> walkable = randomWalls(rows, cols, rng);
+    int rootRow = rows / 2;
+    int rootCol = cols / 2;
+    walkable[static_cast<std::size_t>(rootRow) * cols + rootCol] = 1;
+    FlowField field = buildField(rows, cols, walkable, rootRow, rootCol);
+
+    std::uniform_int_distribution<int> pickDir{0, 3};
+    const int DR[] = {-1, 1, 0, 0};
+    const int DC[] = {0, 0, -1, 1};
+    const int STEPS = 2000;
+    std::size_t total = 0;
+    std::size_t worst = 0;
+    int moved = 0;
+    for (int step = 0; step < STEPS; ++step) {
+        int dir = pickDir(rng);
+        int nr = rootRow + DR[dir];
+        int nc = rootCol + DC[dir];
+        if (!walkable[static_cast<std::size_t>(nr) * cols + nc]) {
+            continue;
+        }
+        rootRow = nr;
+        rootCol = nc;
+        field.setRoot(rootRow, rootCol);
+        total += field.lastUpdateTouched();
+        worst = std::max(worst, field.lastUpdateTouched());
+        moved++;
+    }
+    std::printf("  root step %s: %.0f tiles written on average, %zu at most, of %d (%d rebuilds)\n",
+                label.c_str(), moved ? static_cast<double>(total) / moved : 0.0, worst,
+                rows * cols, static_cast<int>(field.rebuildCount()) - 1);
+}
+
+void benchMap(int rows, int cols) {
+    std::mt19937 rng{9};
+    std::vector<std::uint8_t> walkable = randomWalls(rows, cols, rng);
+    std::string label = std::to_string(rows) + "x" + std::to_string(cols);
+
+    // Open column through the centre so the root can walk back and forth
+    const int midRow = rows / 2;
+    const int midCol = cols / 2;
+    for (int r = midRow - 1; r <= midRow + 1; ++r) {
+        walkable[static_cast<std::size_t>(r) * cols + midCol] = 1;
+    }
+
+    FlowField field = buildField(rows, cols, walkable, midRow, midCol);
+    printStepCost(rows, cols, label);
+
+    reportResult(measure("flowField/rebuild      " + label, [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            field.setWalls([&](int r, int c) { return walkable[static_cast<std::size_t>(r) * cols + c] != 0; });
+            doNotOptimize(field.distance(1, 1));
+        }
+    }));
+
+    reportResult(measure("flowField/rootStep     " + label, [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            field.setRoot(midRow + static_cast<int>(i & 1), midCol);
+            doNotOptimize(field.distance(1, 1));
+        }
+    }));
+
+    int wallRow = midRow / 2;
+    int wallCol = midCol / 2;
+    reportResult(measure("flowField/wallToggle   " + label, [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            field.setWalkable(wallRow, wallCol, (i & 1) != 0);
+            doNotOptimize(field.distance(1, 1));
+        }
+    }));
+}
+
+}  // namespace
+
+BENCHMARK(flowField) {
+    std::printf("  incremental matches rebuild: %s\n",
+                incrementalMatchesRebuild(64, 96, 2000) ? "yes" : "NO");
+
+    benchMap(20, 40);
+    benchMap(128, 128);     // The AI window GameState keeps
+    benchMap(1000, 1000);
+}
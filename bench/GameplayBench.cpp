@@ -0,0 +1,165 @@
+#include "Bench.hpp"
+#include "Enemy.hpp"
+#include "CombatKernel.hpp"
+#include "EventLog.hpp"
+#include "GameLoop.hpp"
+#include "GameState.hpp"
+#include "Player.hpp"
+#include "Random.hpp"
+#include "RenderBackend.hpp"
+#include "Renderer.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// GameplayBench.cpp
+// Per-tick gameplay work against the number of enemies in the world, from
+// 1 to 1M: the combat round, enemy AI, spawning, printMap and a whole
+// tick. The world is the same 2048x2048 map for every count, so only the
+// population changes. Calls that never look at the population
+// (movePlayer / canMoveTo, one checkCollision, grantExperience) run once.
+// ============================================================================
+
+namespace {
+
+constexpr int SIDE = 2048;
+
+// Render backend that throws frames away (measures composition alone)
+class NullBackend : public RenderBackend {
+public:
+    void present(const CellGrid& frame) override { doNotOptimize(frame.rowData(0)); }
+};
+
+// A state with count enemies scattered over the world, with room in the
+// pool for a few more
+std::unique_ptr<GameState> populatedState(std::size_t count,
+                                          const std::shared_ptr<TileMap>& world) {
+    const std::size_t SPARE_SLOTS = 16;
+    auto state = std::make_unique<GameState>(100, 2, count + SPARE_SLOTS, world);
+    Rng rng{11};
+    while (state->enemies.size() < count) {
+        state->enemies.add(EnemyStore::DEFAULT_HEALTH, EnemyStore::DEFAULT_ATTACK,
+                           1 + static_cast<int>(rng.below(SIDE - 2)),
+                           1 + static_cast<int>(rng.below(SIDE - 2)));
+    }
+    return state;
+}
+
+std::string label(const char* operation, std::size_t count) {
+    return std::string{"gameplay/"} + operation + " n=" + std::to_string(count);
+}
+
+}  // namespace
+
+BENCHMARK(gameplay) {
+    auto world = std::make_shared<TileMap>(SIDE, SIDE);
+
+    // Constant-time calls, once
+    {
+        std::unique_ptr<GameState> state = populatedState(1, world);
+        Player& player = state->player;
+
+        // Step right then left, so the player stays put on average
+        reportResult(measure("gameplay/movePlayer", [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) {
+                movePlayer(player, *state->map, (i & 1) ? 'a' : 'd');
+            }
+            doNotOptimize(player.col);
+        }));
+
+        // Random tiles anywhere in the world
+        std::vector<int> tiles(4096);
+        Rng rng{5};
+        for (int& tile : tiles) {
+            tile = static_cast<int>(rng.below(SIDE * SIDE));
+        }
+        reportResult(measure("gameplay/canMoveTo", [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) {
+                const int tile = tiles[i & (tiles.size() - 1)];
+                doNotOptimize(canMoveTo(*state->map, tile / SIDE, tile % SIDE));
+            }
+        }));
+
+        reportResult(measure("gameplay/checkCollision", [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) {
+                doNotOptimize(checkCollision(player, state->enemies, 0));
+            }
+        }));
+
+        // Experience does not depend on the world; a fresh player every 1000
+        // grants keeps the level (and so the level-up rate) realistic
+        EventLog log;
+        Player learner{100, 2, 1, 1};
+        reportResult(measure("gameplay/grantExperience", [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) {
+                if (i % 1000 == 0) {
+                    learner = Player{100, 2, 1, 1};
+                }
+                grantExperience(learner, 10, log);
+            }
+            doNotOptimize(learner.level);
+        }));
+    }
+
+    for (std::size_t count : {1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u}) {
+        std::unique_ptr<GameState> state = populatedState(count, world);
+        Player& player = state->player;
+        EnemyStore& enemies = state->enemies;
+
+        // One enemy on the player's tile, so the grid check finds a fight
+        // and the batched pass runs over every enemy, as updateGame does;
+        // the struck enemies are healed afterwards so the fight goes on
+        enemies.add(EnemyStore::DEFAULT_HEALTH, EnemyStore::DEFAULT_ATTACK, player.row, player.col);
+        CombatResult combat;
+        reportResult(measure(label("combat round", count), [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) {
+                if (enemies.grid.countAt(player.row, player.col) > 0) {
+                    resolveCombat(player.row, player.col, player.attack, enemies, combat);
+                }
+                for (std::uint32_t index : combat.struck) {
+                    enemies.health[index] = EnemyStore::DEFAULT_HEALTH;
+                }
+            }
+            doNotOptimize(combat.damageToPlayer);
+        }));
+
+        // Spawn and take away again, so the population stays at count
+        reportResult(measure(label("spawnEnemy", count), [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) {
+                const EnemyHandle handle = spawnEnemy(enemies, player, state->spawnRng);
+                if (!handle.isNull()) {
+                    enemies.release(handle.index);
+                }
+            }
+        }));
+
+        NullBackend sink;
+        reportResult(measure(label("printMap (null sink)", count), [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) {
+                printMap(*state, sink);
+            }
+        }));
+
+        // Every enemy steps (chasers near the player, the rest patrol or
+        // wander); they drift from where they started as it runs
+        std::uint64_t tick = 0;
+        reportResult(measure(label("updateEnemyAI", count), [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) {
+                updateEnemyAI(enemies, state->chaseField, state->paths, tick++);
+            }
+            doNotOptimize(enemies.row[0]);
+        }));
+
+        // A whole tick, averaged over the ticks between enemy moves; the
+        // player cannot die, so every tick does the same work
+        player.health = player.maxHealth = 1 << 30;
+        reportResult(measure(label("tickGame", count), [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) {
+                tickGame(*state);
+            }
+            doNotOptimize(state->tick);
+        }));
+    }
+}
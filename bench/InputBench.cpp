@@ -0,0 +1,182 @@
+#include "Bench.hpp"
+#include "Input.hpp"
+#include "SpscQueue.hpp"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// InputBench.cpp
+// Escape sequence decoding (including sequences split across reads), the
+// input queue across threads, and how long a key takes to get from the
+// terminal to the simulation through the input thread
+// ============================================================================
+
+namespace {
+
+// Feed bytes to an InputThread through a pipe in two writes, split at the
+// given point with a pause (shorter than the escape timeout) in between
+// Returns: the keys it queued
+std::vector<int> decodeSplit(const char* bytes, std::size_t length, std::size_t split) {
+    const int PAUSE_MS = 5;
+    const int WAIT_MS = 500;
+
+    std::vector<int> keys;
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return keys;
+    }
+    {
+        InputThread input{fds[0]};
+        bool ok = write(fds[1], bytes, split) == static_cast<ssize_t>(split);
+        std::this_thread::sleep_for(std::chrono::milliseconds{PAUSE_MS});
+        ok = ok && write(fds[1], bytes + split, length - split) ==
+                       static_cast<ssize_t>(length - split);
+
+        // The trailing lone ESC only comes out after the escape timeout
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds{WAIT_MS};
+        InputEvent event;
+        while (ok && std::chrono::steady_clock::now() < deadline &&
+               (keys.empty() || keys.back() != KEY_ESCAPE)) {
+            if (input.pop(event)) {
+                keys.push_back(event.key);
+            } else {
+                std::this_thread::sleep_for(std::chrono::milliseconds{1});
+            }
+        }
+    }
+    close(fds[0]);
+    close(fds[1]);
+    return keys;
+}
+
+// Every way of splitting a run of keys over two reads must decode the same
+// Returns: number of splits that decoded wrongly (should be 0)
+int badSplits() {
+    // w, Up, Ctrl+Down, Right (SS3 form), F5 (swallowed), Left, d, Escape
+    static const char BYTES[] = "w\x1b[A\x1b[1;5B\x1bOC\x1b[15~\x1b[Dd\x1b";
+    const std::vector<int> expected = {'w', KEY_UP, KEY_DOWN, KEY_RIGHT, KEY_LEFT, 'd', KEY_ESCAPE};
+    const std::size_t length = sizeof(BYTES) - 1;
+
+    int bad = 0;
+    for (std::size_t split = 0; split <= length; ++split) {
+        bad += decodeSplit(BYTES, length, split) != expected;
+    }
+    return bad;
+}
+
+// Push 0..count-1 from one thread while another pops; the consumer must see
+// every value exactly once and in order
+// Returns: values seen out of order or missing (should be 0)
+std::uint64_t queueAcrossThreads(std::uint64_t count) {
+    auto queue = std::make_unique<SpscQueue<std::uint64_t, 256>>();
+    std::thread producer{[&] {
+        for (std::uint64_t i = 0; i < count; ++i) {
+            while (!queue->tryPush(i)) {
+                std::this_thread::yield();
+            }
+        }
+    }};
+
+    std::uint64_t expected = 0;
+    std::uint64_t bad = 0;
+    std::uint64_t value = 0;
+    while (expected < count) {
+        if (queue->tryPop(value)) {
+            bad += value != expected;
+            expected = value + 1;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    return bad;
+}
+
+// Write single keys into a pipe read by an InputThread and time how long
+// each takes to come out of its queue
+void pipeLatency(int samples) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        std::printf("  pipe() failed, skipping input thread latency\n");
+        return;
+    }
+
+    std::vector<double> micros;
+    micros.reserve(static_cast<std::size_t>(samples));
+    {
+        InputThread input{fds[0]};
+        InputEvent event;
+        for (int i = 0; i < samples; ++i) {
+            const char key = 'a' + static_cast<char>(i % 26);
+            const auto sent = std::chrono::steady_clock::now();
+            if (write(fds[1], &key, 1) != 1) {
+                break;
+            }
+            while (!input.pop(event)) {
+                std::this_thread::yield();
+            }
+            micros.push_back(std::chrono::duration<double, std::micro>(
+                std::chrono::steady_clock::now() - sent).count());
+        }
+    }
+    close(fds[0]);
+    close(fds[1]);
+
+    if (micros.empty()) {
+        return;
+    }
+    std::sort(micros.begin(), micros.end());
+    double total = 0.0;
+    for (double us : micros) {
+        total += us;
+    }
+    std::printf("  key written -> popped by the game: %.1f us average, %.1f us median, "
+                "%.1f us p99 (%zu keys)\n",
+                total / static_cast<double>(micros.size()), micros[micros.size() / 2],
+                micros[micros.size() * 99 / 100], micros.size());
+}
+
+}  // namespace
+
+BENCHMARK(input) {
+    const int bad = badSplits();
+    std::printf("  escape sequences split across two reads decode correctly: %s\n",
+                bad == 0 ? "yes" : "NO");
+
+    const std::uint64_t misordered = queueAcrossThreads(2000000);
+    std::printf("  queue across threads: %llu values out of order or lost%s\n",
+                static_cast<unsigned long long>(misordered), misordered == 0 ? "" : " (BROKEN)");
+
+    {
+        // Plain keys and arrow keys, as a held-down key repeats them
+        static const char BYTES[] = "wasd\x1b[A\x1b[B\x1b[C\x1b[D";
+        const std::size_t length = sizeof(BYTES) - 1;
+        InputDecoder decoder;
+        reportResult(measure("input/decode byte", [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) {
+                doNotOptimize(decoder.feed(static_cast<unsigned char>(BYTES[i % length])));
+            }
+        }));
+    }
+
+    {
+        SpscQueue<InputEvent, InputThread::QUEUE_CAPACITY> queue;
+        reportResult(measure("input/queue push + pop", [&](std::uint64_t n) {
+            InputEvent event;
+            for (std::uint64_t i = 0; i < n; ++i) {
+                queue.tryPush(InputEvent{static_cast<int>(i & 0x7F), {}});
+                queue.tryPop(event);
+                doNotOptimize(event.key);
+            }
+        }));
+    }
+
+    pipeLatency(2000);
+}
@@ -0,0 +1,143 @@
+#include "Bench.hpp"
+#include "FlowField.hpp"
+#include "Pathfinder.hpp"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// PathfinderBench.cpp
+// A* vs. jump point search on large maps, plus the per-goal path cache
+// ============================================================================
+
+namespace {
+
+constexpr int ROWS = 1000;
+constexpr int COLS = 1000;
+
+// Border wall plus random obstacles covering wallPercent of the interior
+std::vector<std::uint8_t> randomMap(int wallPercent, std::mt19937& rng) {
+    std::uniform_int_distribution<int> roll{0, 99};
+    std::vector<std::uint8_t> walkable(static_cast<std::size_t>(ROWS) * COLS, 0);
+    for (int r = 1; r < ROWS - 1; ++r) {
+        for (int c = 1; c < COLS - 1; ++c) {
+            walkable[static_cast<std::size_t>(r) * COLS + c] = roll(rng) >= wallPercent;
+        }
+    }
+    return walkable;
+}
+
+// Random walkable tiles, paired up as (start, goal) queries
+std::vector<PathNode> randomTiles(const std::vector<std::uint8_t>& walkable, std::size_t count,
+                                  std::mt19937& rng) {
+    std::uniform_int_distribution<int> pickRow{1, ROWS - 2};
+    std::uniform_int_distribution<int> pickCol{1, COLS - 2};
+    std::vector<PathNode> tiles;
+    while (tiles.size() < count) {
+        PathNode n{pickRow(rng), pickCol(rng)};
+        if (walkable[static_cast<std::size_t>(n.row) * COLS + n.col]) {
+            tiles.push_back(n);
+        }
+    }
+    return tiles;
+}
+
+// Path length in steps, or -1 if unreachable
+int pathCost(Pathfinder& paths, PathNode start, PathNode goal, std::vector<PathNode>& path) {
+    return paths.findPath(start, goal, path) ? static_cast<int>(path.size()) - 1 : -1;
+}
+
+// A*, JPS and a BFS distance field must agree on every path length
+bool searchesAgree(const std::vector<std::uint8_t>& walkable, Pathfinder& paths,
+                   std::mt19937& rng) {
+    auto isWalkable = [&](int r, int c) { return walkable[static_cast<std::size_t>(r) * COLS + c] != 0; };
+    std::vector<PathNode> tiles = randomTiles(walkable, 40, rng);
+    std::vector<PathNode> path;
+
+    for (std::size_t i = 0; i + 1 < tiles.size(); i += 2) {
+        PathNode start = tiles[i];
+        PathNode goal = tiles[i + 1];
+
+        FlowField field{ROWS, COLS};
+        field.setWalls(isWalkable);
+        field.setRoot(goal.row, goal.col);
+        int bfs = field.distance(start.row, start.col);
+        int expected = bfs == FlowField::UNREACHABLE ? -1 : bfs;
+
+        paths.setJumpPoints(false);
+        int astar = pathCost(paths, start, goal, path);
+        paths.setJumpPoints(true);
+        int jps = pathCost(paths, start, goal, path);
+
+        // Every step of the expanded JPS path must be a single walkable move
+        for (std::size_t s = 1; s < path.size(); ++s) {
+            int step = std::abs(path[s].row - path[s - 1].row) + std::abs(path[s].col - path[s - 1].col);
+            if (step != 1 || !isWalkable(path[s].row, path[s].col)) {
+                return false;
+            }
+        }
+        if (astar != expected || jps != expected) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void benchMap(int wallPercent) {
+    std::mt19937 rng{static_cast<std::uint32_t>(wallPercent) + 3};
+    std::vector<std::uint8_t> walkable = randomMap(wallPercent, rng);
+    Pathfinder paths{ROWS, COLS};
+    paths.setWalls([&](int r, int c) { return walkable[static_cast<std::size_t>(r) * COLS + c] != 0; });
+
+    std::string label = "1000x1000 walls=" + std::to_string(wallPercent) + "%";
+    std::printf("  %s: A* / JPS / BFS agree: %s\n", label.c_str(),
+                searchesAgree(walkable, paths, rng) ? "yes" : "NO");
+
+    std::vector<PathNode> queries = randomTiles(walkable, 64, rng);
+    std::vector<PathNode> path;
+    for (bool jps : {false, true}) {
+        paths.setJumpPoints(jps);
+        std::size_t q = 0;
+        reportResult(measure(std::string(jps ? "path/jps   " : "path/astar ") + label,
+                             [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) {
+                paths.findPath(queries[q], queries[q + 1], path);
+                q = (q + 2) % queries.size();
+                doNotOptimize(path.size());
+            }
+        }, 1.0));
+    }
+
+    // Walkers sharing one goal, each following its path and starting over
+    // on arrival: only a walker's first step ever searches
+    PathNode goal = queries[0];
+    std::vector<PathNode> origins = randomTiles(walkable, 16, rng);
+    std::vector<PathNode> walkers = origins;
+    paths.clearCache();
+    std::size_t w = 0;
+    reportResult(measure("path/cachedStep " + label, [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            PathNode next{};
+            if (paths.nextStep(walkers[w], goal, next) == Pathfinder::StepResult::Step) {
+                walkers[w] = next;
+            } else {
+                walkers[w] = origins[w];
+            }
+            w = (w + 1) % walkers.size();
+            doNotOptimize(next.row);
+        }
+    }));
+    std::printf("  cache: %llu searches, %llu hits\n",
+                static_cast<unsigned long long>(paths.stats().searches),
+                static_cast<unsigned long long>(paths.stats().cacheHits));
+}
+
+}  // namespace
+
+BENCHMARK(pathfinder) {
+    benchMap(0);
+    benchMap(5);
+    benchMap(20);
+}
@@ -0,0 +1,72 @@
+#include "Bench.hpp"
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+// ============================================================================
+// ProfilerBench.cpp
+// What a probe costs switched off and on, histogram accuracy, and reading
+// percentiles (the HUD overlay does it every frame)
+// ============================================================================
+
+namespace {
+
+// Percentiles of a known distribution (1..100000 ns, uniform) against the
+// exact values
+// Returns: worst relative error of p50 / p90 / p99
+double worstPercentileError() {
+    Profiler::reset();
+    const std::uint64_t N = 100000;
+    for (std::uint64_t i = 1; i <= N; ++i) {
+        Profiler::recordPhase(ProfilePhase::Tick, 0, i);
+    }
+    const ProfileSummary s = Profiler::summary(ProfilePhase::Tick);
+    const double expected[3] = {N * 0.50, N * 0.90, N * 0.99};
+    const double actual[3] = {static_cast<double>(s.p50), static_cast<double>(s.p90),
+                              static_cast<double>(s.p99)};
+    double worst = 0.0;
+    for (int i = 0; i < 3; ++i) {
+        const double error = (actual[i] - expected[i]) / expected[i];
+        worst = std::max(worst, error < 0 ? -error : error);
+    }
+    Profiler::reset();
+    return worst;
+}
+
+}  // namespace
+
+BENCHMARK(profiler) {
+    std::printf("  probes compiled in: %s\n", GAME_PROFILING ? "yes" : "no (GAME_PROFILING=0)");
+    std::printf("  percentile error on 100000 samples: %.1f%% worst\n",
+                worstPercentileError() * 100.0);
+
+    Profiler::setEnabled(false);
+    reportResult(measure("profiler/scope (disabled)", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            PROFILE_SCOPE(Tick);
+            doNotOptimize(i);
+        }
+    }));
+
+    Profiler::setEnabled(true);
+    reportResult(measure("profiler/scope (enabled)", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            PROFILE_SCOPE(Tick);
+            doNotOptimize(i);
+        }
+    }));
+    reportResult(measure("profiler/count (enabled)", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            PROFILE_COUNT(BytesWritten, i & 0xFFF);
+        }
+    }));
+    Profiler::setEnabled(false);
+
+    reportResult(measure("profiler/summary (p50/p90/p99)", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            doNotOptimize(Profiler::summary(ProfilePhase::Tick).p99);
+        }
+    }));
+    Profiler::reset();
+}
@@ -0,0 +1,108 @@
+#include "Bench.hpp"
+#include "Random.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// ============================================================================
+// RandomBench.cpp
+// Rng (xoshiro256**) vs. std::mt19937 + uniform_int_distribution
+// ============================================================================
+
+namespace {
+
+// Largest relative deviation of any bucket from the expected count
+double worstBucketError(Rng& rng, std::uint32_t bound, std::size_t draws) {
+    std::vector<std::size_t> buckets(bound, 0);
+    for (std::size_t i = 0; i < draws; ++i) {
+        buckets[rng.below(bound)]++;
+    }
+    const double expected = static_cast<double>(draws) / bound;
+    double worst = 0.0;
+    for (std::size_t count : buckets) {
+        double error = (static_cast<double>(count) - expected) / expected;
+        worst = std::max(worst, error < 0 ? -error : error);
+    }
+    return worst;
+}
+
+// Same seed + stream gives the same sequence; different streams differ
+bool streamsBehave() {
+    Rng a = Rng::forStream(7, RngStream::Spawn);
+    Rng b = Rng::forStream(7, RngStream::Spawn);
+    Rng c = Rng::forStream(7, RngStream::Input);
+    int matches = 0;
+    for (int i = 0; i < 1000; ++i) {
+        std::uint64_t x = a();
+        if (x != b()) {
+            return false;
+        }
+        matches += x == c();
+    }
+    return matches == 0;
+}
+
+// fillBelow and below draw from the same distribution
+bool fillBelowInRange(std::uint32_t bound) {
+    Rng rng{3};
+    std::vector<std::uint32_t> out(10000);
+    rng.fillBelow(out.data(), out.size(), bound);
+    for (std::uint32_t value : out) {
+        if (value >= bound) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+BENCHMARK(randomNumbers) {
+    std::printf("  streams reproducible and independent: %s\n", streamsBehave() ? "yes" : "NO");
+    std::printf("  fillBelow in range: %s\n", fillBelowInRange(7) && fillBelowInRange(100000) ? "yes" : "NO");
+    {
+        Rng rng{11};
+        std::printf("  below(10), 10M draws, worst bucket error: %.3f%%\n",
+                    100.0 * worstBucketError(rng, 10, 10000000));
+    }
+
+    std::mt19937 mt{1};
+    std::uniform_int_distribution<std::uint32_t> pick{0, 16383};
+    reportResult(measure("random/mt19937 + distribution [0,16384)", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            doNotOptimize(pick(mt));
+        }
+    }));
+
+    Rng rng{1};
+    reportResult(measure("random/rng.below(16384)", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            doNotOptimize(rng.below(16384));
+        }
+    }));
+
+    reportResult(measure("random/rng.next()", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            doNotOptimize(rng.next());
+        }
+    }));
+
+    std::vector<std::uint32_t> buffer(4096);
+    reportResult(measure("random/rng.fillBelow 4096 (per value)", [&](std::uint64_t n) {
+        std::uint64_t done = 0;
+        while (done < n) {
+            rng.fillBelow(buffer.data(), buffer.size(), 16384);
+            doNotOptimize(buffer[0]);
+            done += buffer.size();
+        }
+    }));
+
+    reportResult(measure("random/forStream(seed, Threads + 7)", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            Rng stream = Rng::forStream(i, static_cast<std::uint64_t>(RngStream::Threads) + 7);
+            doNotOptimize(stream.state()[0]);
+        }
+    }));
+}
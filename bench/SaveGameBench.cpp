@@ -0,0 +1,224 @@
+#include "Bench.hpp"
+#include "Enemy.hpp"
+#include "GameLoop.hpp"
+#include "GameState.hpp"
+#include "Replay.hpp"
+#include "SaveGame.hpp"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+
+// ============================================================================
+// SaveGameBench.cpp
+// Save round trips (a resumed game must carry on identically, given the
+// same patrol routes cached), and save / load / autosave cost against the
+// number of enemies
+// ============================================================================
+
+namespace {
+
+const char* const SAVE_PATH = "bench_save.sav";
+
+// Feed the same keys to a state for a number of ticks
+void play(GameState& state, int ticks) {
+    static constexpr char KEYS[] = "wwwwddddssssaaaa";
+    for (int i = 0; i < ticks; ++i) {
+        if (i % 12 == 0) {
+            handleInput(state, KEYS[(state.tick / 12) % (sizeof(KEYS) - 1)]);
+        }
+        tickGame(state);
+    }
+}
+
+// Play, save, then continue both the original and a loaded copy; the two
+// must end in the same state. Saves leave out the patrol route cache, so
+// the original drops its cache too - anything else not saved would show up
+// as a difference.
+bool resumesIdentically(std::uint64_t& hashBefore, std::uint64_t& hashAfter) {
+    auto world = std::make_shared<TileMap>(256, 256);
+    GameState original{100, 2, 2048, world};
+    seedEnemyRandom(original, 7);
+    spawnEnemies(original, 400);
+    play(original, 3000);
+
+    std::string error;
+    if (!saveGame(original, SAVE_PATH, error)) {
+        std::printf("  save failed: %s\n", error.c_str());
+        return false;
+    }
+    SaveReader save{SAVE_PATH};
+    GameState loaded{100, 2, save.enemyCapacity(), world};
+    if (!save.restore(loaded)) {
+        std::printf("  load failed: %s\n", save.error().c_str());
+        return false;
+    }
+    if (hashGameState(loaded) != hashGameState(original)) {
+        return false;
+    }
+
+    original.paths.clearCache();
+    play(original, 3000);
+    play(loaded, 3000);
+    hashBefore = hashGameState(original);
+    hashAfter = hashGameState(loaded);
+    return hashBefore == hashAfter;
+}
+
+bool sameSlots(const SaveSnapshot& a, const SaveSnapshot& b) {
+    return a.health == b.health && a.maxHealth == b.maxHealth && a.attack == b.attack &&
+           a.row == b.row && a.col == b.col && a.alive == b.alive &&
+           a.generation == b.generation && a.freeSlots == b.freeSlots;
+}
+
+// Captures refreshed in place (two alternating, as the autosaver does, and
+// one that falls too far behind) against a full capture, over a game with
+// moves, fights, deaths and respawns
+bool refreshedCapturesMatch() {
+    auto world = std::make_shared<TileMap>(256, 256);
+    GameState state{100, 2, 2048, world};
+    seedEnemyRandom(state, 9);
+    spawnEnemies(state, 400);
+
+    SaveSnapshot alternate[2];
+    SaveSnapshot lagging;
+    SaveSnapshot full;
+    for (int round = 0; round < 60; ++round) {
+        play(state, 50);
+        SaveSnapshot& snapshot = alternate[round & 1];
+        captureSave(state, snapshot);
+        captureSave(state, full = SaveSnapshot{});
+        if (!sameSlots(snapshot, full)) {
+            return false;
+        }
+        if (round % 7 == 0) {
+            captureSave(state, lagging);
+            if (!sameSlots(lagging, full)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Saves with one header field corrupted, each of which the reader must
+// refuse (restoring them would overflow or index out of range)
+bool corruptSavesRejected() {
+    auto world = std::make_shared<TileMap>(256, 256);
+    GameState state{100, 2, 2048, world};
+    seedEnemyRandom(state, 5);
+    spawnEnemies(state, 100);
+    state.events.schedule(state.tick + 10, TimedEventType::RespawnEnemy);
+    SaveSnapshot good;
+    captureSave(state, good);
+
+    auto rejected = [&good](void (*corrupt)(SaveSnapshot&)) {
+        SaveSnapshot snapshot = good;
+        corrupt(snapshot);
+        std::string error;
+        return writeSave(snapshot, SAVE_PATH, error) && !SaveReader{SAVE_PATH}.isValid();
+    };
+    std::string error;
+    return writeSave(good, SAVE_PATH, error) && SaveReader{SAVE_PATH}.isValid() &&
+           rejected([](SaveSnapshot& s) { s.spawnZoneRow = 1 << 30; }) &&
+           rejected([](SaveSnapshot& s) { s.spawnZoneCol = -1 << 30; }) &&
+           rejected([](SaveSnapshot& s) { s.ticksPerSecond = 0; }) &&
+           rejected([](SaveSnapshot& s) { s.ticksPerSecond = -120; }) &&
+           rejected([](SaveSnapshot& s) { s.events[0].type = static_cast<TimedEventType>(200); }) &&
+           rejected([](SaveSnapshot& s) { s.aiWindowTop = -1; }) &&
+           rejected([](SaveSnapshot& s) { s.aiWindowLeft = s.mapCols; });
+}
+
+// A state with count enemies scattered over a world big enough to hold them
+std::unique_ptr<GameState> crowdedState(std::size_t count) {
+    const int SIDE = 2048;
+    auto state = std::make_unique<GameState>(100, 2, count + 1,
+                                             std::make_shared<TileMap>(SIDE, SIDE));
+    Rng rng{3};
+    while (state->enemies.size() < count) {
+        state->enemies.add(EnemyStore::DEFAULT_HEALTH, EnemyStore::DEFAULT_ATTACK,
+                           1 + static_cast<int>(rng.below(SIDE - 2)),
+                           1 + static_cast<int>(rng.below(SIDE - 2)));
+    }
+    // Some free slots and pending events, as a real game has
+    for (std::size_t i = 0; i < count; i += 10) {
+        state->enemies.release(i);
+        state->events.schedule(state->tick + i, TimedEventType::RespawnEnemy);
+    }
+    return state;
+}
+
+}  // namespace
+
+BENCHMARK(saveGame) {
+    std::uint64_t hashBefore = 0;
+    std::uint64_t hashAfter = 0;
+    const bool same = resumesIdentically(hashBefore, hashAfter);
+    std::printf("  resumed game matches the original 3000 ticks later: %s\n", same ? "yes" : "NO");
+    std::printf("  captures refreshed in place match full ones: %s\n",
+                refreshedCapturesMatch() ? "yes" : "NO");
+    std::printf("  corrupt spawn zone / AI window / tick rate / event type rejected: %s\n",
+                corruptSavesRejected() ? "yes" : "NO");
+
+    for (std::size_t count : {1000u, 10000u, 100000u, 1000000u}) {
+        std::unique_ptr<GameState> state = crowdedState(count);
+        const std::string size = std::to_string(count) + " enemies";
+
+        // A snapshot that has never seen this store copies every slot
+        SaveSnapshot snapshot;
+        reportResult(measure("save/capture (full) " + size, [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) {
+                snapshot.enemySource = 0;
+                captureSave(*state, snapshot);
+                doNotOptimize(snapshot.health.data());
+            }
+        }));
+
+        // Refilling the same snapshot after MOVED enemies stepped (the
+        // moves are included; an autosave interval moves the enemies near
+        // the player, not the whole world)
+        const std::size_t MOVED = 1000;
+        Rng pick{17};
+        reportResult(measure("save/capture (1000 moved) " + size, [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) {
+                for (std::size_t m = 0; m < MOVED; ++m) {
+                    const std::size_t e = pick.below(static_cast<std::uint32_t>(count));
+                    if (state->enemies.alive[e]) {
+                        state->enemies.place(e, state->enemies.row[e], state->enemies.col[e]);
+                    }
+                }
+                captureSave(*state, snapshot);
+                doNotOptimize(snapshot.health.data());
+            }
+        }));
+
+        std::string error;
+        reportResult(measure("save/write " + size, [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) {
+                doNotOptimize(writeSave(snapshot, SAVE_PATH, error));
+            }
+        }));
+
+        GameState loaded{100, 2, state->enemies.capacity(), state->map};
+        bool ok = true;
+        reportResult(measure("save/load (map + restore) " + size, [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) {
+                SaveReader save{SAVE_PATH};
+                ok = ok && save.restore(loaded);
+            }
+        }));
+        if (!ok || hashGameState(loaded) != hashGameState(*state)) {
+            std::printf("  loaded state differs from the saved one (BROKEN)\n");
+        }
+
+        // What the game loop pays when an autosave is due: just the capture,
+        // even while the previous save is still being written
+        AutoSaver autosave{SAVE_PATH, 1};
+        reportResult(measure("save/autosave due (game thread) " + size, [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) {
+                autosave.saveNow(*state);
+            }
+        }));
+    }
+    std::remove(SAVE_PATH);
+}
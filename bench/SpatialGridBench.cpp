@@ -0,0 +1,139 @@
+#include "Bench.hpp"
+#include "SpatialGrid.hpp"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// SpatialGridBench.cpp
+// Uniform-grid index vs. a linear scan over every entity, and what the
+// index costs to hold and copy on a large world
+// ============================================================================
+
+namespace {
+
+// Entity positions in the same layout EnemyStore uses
+struct Positions {
+    std::vector<int> row;
+    std::vector<int> col;
+};
+
+Positions randomPositions(std::size_t count, int rows, int cols, std::mt19937& rng) {
+    std::uniform_int_distribution<int> pickRow{0, rows - 1};
+    std::uniform_int_distribution<int> pickCol{0, cols - 1};
+    Positions p;
+    p.row.resize(count);
+    p.col.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        p.row[i] = pickRow(rng);
+        p.col[i] = pickCol(rng);
+    }
+    return p;
+}
+
+void benchMap(int rows, int cols, std::size_t count) {
+    std::mt19937 rng{42};
+    Positions pos = randomPositions(count, rows, cols, rng);
+
+    SpatialGrid grid{rows, cols};
+    for (std::size_t i = 0; i < count; ++i) {
+        grid.insert(static_cast<std::uint32_t>(i), pos.row[i], pos.col[i]);
+    }
+
+    // Query points cycle through a fixed random set
+    Positions queries = randomPositions(1024, rows, cols, rng);
+    const int RADIUS = 4;
+
+    std::string label = std::to_string(rows) + "x" + std::to_string(cols) +
+                        " n=" + std::to_string(count);
+
+    reportResult(measure("tile/linear " + label, [&](std::uint64_t n) {
+        for (std::uint64_t q = 0; q < n; ++q) {
+            int r = queries.row[q & 1023], c = queries.col[q & 1023];
+            std::size_t hits = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                hits += (pos.row[i] == r) & (pos.col[i] == c);
+            }
+            doNotOptimize(hits);
+        }
+    }));
+
+    reportResult(measure("tile/grid   " + label, [&](std::uint64_t n) {
+        for (std::uint64_t q = 0; q < n; ++q) {
+            std::size_t hits = 0;
+            grid.forEachAt(queries.row[q & 1023], queries.col[q & 1023],
+                           [&](std::uint32_t) { ++hits; });
+            doNotOptimize(hits);
+        }
+    }));
+
+    reportResult(measure("radius4/linear " + label, [&](std::uint64_t n) {
+        for (std::uint64_t q = 0; q < n; ++q) {
+            int r = queries.row[q & 1023], c = queries.col[q & 1023];
+            std::size_t hits = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                int dr = pos.row[i] - r, dc = pos.col[i] - c;
+                hits += dr * dr + dc * dc <= RADIUS * RADIUS;
+            }
+            doNotOptimize(hits);
+        }
+    }));
+
+    reportResult(measure("radius4/grid   " + label, [&](std::uint64_t n) {
+        for (std::uint64_t q = 0; q < n; ++q) {
+            doNotOptimize(grid.countInRadius(queries.row[q & 1023],
+                                             queries.col[q & 1023], RADIUS));
+        }
+    }));
+
+    // Incremental update cost: move one entity by one tile and back
+    reportResult(measure("move/grid   " + label, [&](std::uint64_t n) {
+        for (std::uint64_t q = 0; q < n; ++q) {
+            std::uint32_t id = static_cast<std::uint32_t>(q % count);
+            int r = pos.row[id], c = pos.col[id];
+            int c2 = c + 1 < cols ? c + 1 : c - 1;
+            grid.move(id, r, c, r, c2);
+            grid.move(id, r, c2, r, c);
+        }
+    }));
+}
+
+// A large world whose entities stay around one spot, as enemies stay
+// around the player: memory and copies follow the occupied chunks
+void benchClustered(int side, int area, std::size_t count) {
+    std::mt19937 rng{7};
+    Positions pos = randomPositions(count, area, area, rng);
+    SpatialGrid grid{side, side};
+    for (std::size_t i = 0; i < count; ++i) {
+        grid.insert(static_cast<std::uint32_t>(i), (side - area) / 2 + pos.row[i],
+                    (side - area) / 2 + pos.col[i]);
+    }
+
+    std::string label = std::to_string(side) + "x" + std::to_string(side) + ", n=" +
+                        std::to_string(count) + " in " + std::to_string(area) + "x" +
+                        std::to_string(area);
+    std::printf("  memory %s: %.2f MB (%zu chunks; %.1f MB at 8 bytes per tile)\n",
+                label.c_str(), grid.memoryBytes() / 1e6, grid.occupiedChunks(),
+                8.0 * side * side / 1e6);
+
+    reportResult(measure("copy/grid   " + label, [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            SpatialGrid copy = grid;
+            doNotOptimize(copy.countAt(side / 2, side / 2));
+        }
+    }));
+}
+
+}  // namespace
+
+BENCHMARK(spatialGrid) {
+    for (std::size_t count : {100, 10'000, 100'000}) {
+        benchMap(20, 40, count);
+    }
+    for (std::size_t count : {10'000, 100'000}) {
+        benchMap(512, 512, count);
+    }
+    benchClustered(4000, 128, 10'000);
+}
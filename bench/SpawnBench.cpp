@@ -0,0 +1,177 @@
+#include "Bench.hpp"
+#include "Enemy.hpp"
+#include "EnemyStore.hpp"
+#include "GameState.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// ============================================================================
+// SpawnBench.cpp
+// Spawning from the eligible-tile set vs. rejection sampling
+// ============================================================================
+
+namespace {
+
+constexpr int ROWS = 128;
+constexpr int COLS = 128;
+constexpr int MIN_DISTANCE = SpawnSet::MIN_SPAWN_DISTANCE;
+
+// Random walls (about 1 tile in 6) inside a solid border
+std::vector<std::uint8_t> randomWalls(std::mt19937& rng) {
+    std::uniform_int_distribution<int> roll{0, 5};
+    std::vector<std::uint8_t> walkable(static_cast<std::size_t>(ROWS) * COLS, 0);
+    for (int r = 1; r < ROWS - 1; ++r) {
+        for (int c = 1; c < COLS - 1; ++c) {
+            walkable[static_cast<std::size_t>(r) * COLS + c] = roll(rng) != 0;
+        }
+    }
+    return walkable;
+}
+
+// Brute-force eligibility, the way the set is defined
+bool eligible(const std::vector<std::uint8_t>& walkable, const EnemyStore& enemies,
+              int playerRow, int playerCol, int r, int c) {
+    int dRow = r - playerRow;
+    int dCol = c - playerCol;
+    return walkable[static_cast<std::size_t>(r) * COLS + c] &&
+           enemies.grid.countAt(r, c) == 0 &&
+           dRow * dRow + dCol * dCol >= MIN_DISTANCE * MIN_DISTANCE;
+}
+
+// Random player walk, enemy moves and deaths, checked against brute force
+bool setMatchesBruteForce(int steps) {
+    std::mt19937 rng{9};
+    std::vector<std::uint8_t> walkable = randomWalls(rng);
+    auto isWalkable = [&](int r, int c) { return walkable[static_cast<std::size_t>(r) * COLS + c] != 0; };
+
+    EnemyStore enemies{ROWS, COLS, 4096};
+    int playerRow = ROWS / 2;
+    int playerCol = COLS / 2;
+    enemies.spawnCells.setPlayer(playerRow, playerCol);
+    enemies.spawnCells.setWindow(0, 0, ROWS, COLS, isWalkable, enemies.grid);
+
+    Player player{100, 2, playerRow, playerCol};
+    Rng spawnRng{9};
+    std::uniform_int_distribution<int> pickDir{0, 3};
+    const int DR[] = {-1, 1, 0, 0};
+    const int DC[] = {0, 0, -1, 1};
+
+    for (int step = 0; step < steps; ++step) {
+        // Player wanders; occasionally jumps far
+        int d = pickDir(rng);
+        if (step % 97 == 0) {
+            player.row = 1 + static_cast<int>(rng() % (ROWS - 2));
+            player.col = 1 + static_cast<int>(rng() % (COLS - 2));
+        } else if (isWalkable(player.row + DR[d], player.col + DC[d])) {
+            player.row += DR[d];
+            player.col += DC[d];
+        }
+
+        spawnEnemy(enemies, player, spawnRng);
+        spawnEnemy(enemies, player, spawnRng);
+
+        // Move one enemy (stacking allowed) and release another
+        std::size_t i = rng() % enemies.size();
+        if (enemies.alive[i] && isWalkable(enemies.row[i] + DR[d], enemies.col[i] + DC[d])) {
+            enemies.place(i, enemies.row[i] + DR[d], enemies.col[i] + DC[d]);
+        }
+        enemies.release(rng() % enemies.size());
+
+        if (step % 50 == 0) {
+            std::size_t count = 0;
+            for (int r = 0; r < ROWS; ++r) {
+                for (int c = 0; c < COLS; ++c) {
+                    bool expected = eligible(walkable, enemies, player.row, player.col, r, c);
+                    if (enemies.spawnCells.isEligible(r, c) != expected) {
+                        return false;
+                    }
+                    count += expected;
+                }
+            }
+            if (count != enemies.spawnCells.size()) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// The old approach: random tiles until one is free floor far enough away
+// (std::sqrt distance), giving up after 100 tries
+// Returns: true if an eligible tile was found
+bool rejectionSpawn(const std::vector<std::uint8_t>& walkable, EnemyStore& enemies,
+                    const Player& player, std::mt19937& rng) {
+    std::uniform_int_distribution<int> pickRow{1, ROWS - 2};
+    std::uniform_int_distribution<int> pickCol{1, COLS - 2};
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        int row = pickRow(rng);
+        int col = pickCol(rng);
+        double distance = std::sqrt(static_cast<double>((row - player.row) * (row - player.row) +
+                                                        (col - player.col) * (col - player.col)));
+        if (walkable[static_cast<std::size_t>(row) * COLS + col] &&
+            enemies.grid.countAt(row, col) == 0 && distance >= MIN_DISTANCE) {
+            enemies.add(EnemyStore::DEFAULT_HEALTH, EnemyStore::DEFAULT_ATTACK, row, col);
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+BENCHMARK(spawning) {
+    std::printf("  spawn set matches brute force: %s\n", setMatchesBruteForce(3000) ? "yes" : "NO");
+
+    std::mt19937 rng{21};
+    std::vector<std::uint8_t> walkable = randomWalls(rng);
+    auto isWalkable = [&](int r, int c) { return walkable[static_cast<std::size_t>(r) * COLS + c] != 0; };
+    const std::size_t BATCH = 8192;
+
+    // Fill most of the free floor in one batch, then empty the pool again;
+    // the emptier the floor gets, the more rejection sampling retries
+    EnemyStore enemies{ROWS, COLS, BATCH};
+    Player player{100, 2, ROWS / 2, COLS / 2};
+    Rng spawnRng{21};
+    enemies.spawnCells.setPlayer(player.row, player.col);
+    enemies.spawnCells.setWindow(0, 0, ROWS, COLS, isWalkable, enemies.grid);
+    auto releaseAll = [&] {
+        for (std::size_t e = 0; e < enemies.size(); ++e) {
+            enemies.release(e);
+        }
+    };
+
+    reportResult(measure("spawn/set batch of 8192 (per batch)", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            for (std::size_t e = 0; e < BATCH; ++e) {
+                spawnEnemy(enemies, player, spawnRng);
+            }
+            releaseAll();
+        }
+    }));
+
+    std::uint64_t failed = 0;
+    std::uint64_t batches = 0;
+    reportResult(measure("spawn/rejection batch of 8192 (per batch)", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            for (std::size_t e = 0; e < BATCH; ++e) {
+                failed += !rejectionSpawn(walkable, enemies, player, rng);
+            }
+            releaseAll();
+            batches++;
+        }
+    }));
+    std::printf("  rejection: %.1f of 8192 spawns per batch gave up after 100 tries\n",
+                static_cast<double>(failed) / static_cast<double>(batches));
+
+    // Player steps: the no-spawn zone moves with them
+    int step = 0;
+    reportResult(measure("spawn/set player step", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            step++;
+            enemies.spawnCells.setPlayer(ROWS / 2 + (step & 1), COLS / 2);
+        }
+    }));
+}
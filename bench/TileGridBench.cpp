@@ -0,0 +1,112 @@
+#include "Bench.hpp"
+#include "CellGrid.hpp"
+#include "TileGrid.hpp"
+#include "TileMap.hpp"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// ============================================================================
+// TileGridBench.cpp
+// Fixed-size vs. runtime-sized map grids: lookups and frame drawing
+// ============================================================================
+
+namespace {
+
+constexpr int ROWS = 20;
+constexpr int COLS = 40;
+
+// The default room: floor with a wall around the edge
+bool room(int r, int c) {
+    return r > 0 && c > 0 && r < ROWS - 1 && c < COLS - 1;
+}
+
+struct Probe {
+    int row;
+    int col;
+};
+
+// Lookups spread over the room and one tile past each edge
+std::vector<Probe> randomProbes() {
+    std::mt19937 rng{5};
+    std::uniform_int_distribution<int> pickRow{-1, ROWS};
+    std::uniform_int_distribution<int> pickCol{-1, COLS};
+    std::vector<Probe> probes(4096);
+    for (Probe& p : probes) {
+        p = {pickRow(rng), pickCol(rng)};
+    }
+    return probes;
+}
+
+template <typename Lookup>
+void benchLookups(const char* name, const std::vector<Probe>& probes, Lookup&& isWalkable) {
+    reportResult(measure(name, [&](std::uint64_t n) {
+        std::size_t p = 0;
+        int floors = 0;
+        for (std::uint64_t i = 0; i < n; ++i) {
+            floors += isWalkable(probes[p].row, probes[p].col);
+            p = (p + 1) & (probes.size() - 1);
+        }
+        doNotOptimize(floors);
+    }));
+}
+
+template <typename Draw>
+void benchDraw(const char* name, CellGrid& frame, Draw&& draw) {
+    reportResult(measure(name, [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            draw();
+            doNotOptimize(frame.at(ROWS - 1, COLS - 1));
+        }
+    }));
+}
+
+}  // namespace
+
+BENCHMARK(tileGrid) {
+    TileGrid<ROWS, COLS> fixed;
+    fixed.fill(room);
+    TileGrid<> runtime{ROWS, COLS};
+    runtime.fill(room);
+    TileMap flatMap{ROWS, COLS};
+    // Same room in the corner of a world too big to hold flat
+    TileMap chunkedMap{1024, 1024};
+    for (int r = 0; r < ROWS; ++r) {
+        for (int c = 0; c < COLS; ++c) {
+            chunkedMap.setWalkable(r, c, room(r, c));
+        }
+    }
+
+    const std::vector<Probe> probes = randomProbes();
+    bool agree = true;
+    for (const Probe& p : probes) {
+        bool expected = fixed.isWalkable(p.row, p.col);
+        agree = agree && runtime.isWalkable(p.row, p.col) == expected &&
+                flatMap.isWalkable(p.row, p.col) == expected &&
+                (!fixed.contains(p.row, p.col) || chunkedMap.isWalkable(p.row, p.col) == expected);
+    }
+    std::printf("  grids agree: %s\n", agree ? "yes" : "NO");
+
+    benchLookups("tilegrid/isWalkable fixed 20x40", probes,
+                 [&](int r, int c) { return fixed.isWalkable(r, c); });
+    benchLookups("tilegrid/isWalkable runtime 20x40", probes,
+                 [&](int r, int c) { return runtime.isWalkable(r, c); });
+    benchLookups("tilegrid/isWalkable TileMap flat", probes,
+                 [&](int r, int c) { return flatMap.isWalkable(r, c); });
+    benchLookups("tilegrid/isWalkable TileMap chunked", probes,
+                 [&](int r, int c) { return chunkedMap.isWalkable(r, c); });
+
+    CellGrid frame{ROWS, COLS};
+    benchDraw("tilegrid/draw fixed 20x40", frame,
+              [&] { drawTileWindow<ROWS, COLS>(fixed, 0, 0, frame); });
+    benchDraw("tilegrid/draw runtime 20x40", frame,
+              [&] { drawTileWindow<ROWS, COLS>(runtime, 0, 0, frame); });
+    benchDraw("tilegrid/draw TileMap chunked (per tile)", frame, [&] {
+        for (int r = 0; r < ROWS; ++r) {
+            for (int c = 0; c < COLS; ++c) {
+                frame.set(r, c, chunkedMap.isWalkable(r, c) ? '.' : '#');
+            }
+        }
+    });
+}
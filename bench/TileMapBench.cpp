@@ -0,0 +1,131 @@
+#include "Bench.hpp"
+#include "TileMap.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+
+// ============================================================================
+// TileMapBench.cpp
+// Opening and exploring a large chunked map file, and checking lock-free
+// lookups against chunks being evicted and reloaded on another thread
+// ============================================================================
+
+namespace {
+
+constexpr int ROWS = 8192;
+constexpr int COLS = 8192;
+constexpr int RESIDENT_RADIUS = 4;
+
+// Scattered pillars on a walled field, cheap to compute per tile
+bool pillarField(int row, int col) {
+    if (row == 0 || col == 0 || row == ROWS - 1 || col == COLS - 1) {
+        return false;
+    }
+    return (row * 7919 + col * 104729) % 37 != 0;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
+BENCHMARK(tileMap) {
+    const std::string path = "/tmp/tilemap_bench.map";
+    std::string error;
+    auto start = std::chrono::steady_clock::now();
+    if (!TileMap::writeFile(path, ROWS, COLS, pillarField, error)) {
+        std::printf("  cannot write %s: %s\n", path.c_str(), error.c_str());
+        return;
+    }
+    std::printf("  wrote %dx%d map in %.2f s\n", ROWS, COLS, secondsSince(start));
+
+    start = std::chrono::steady_clock::now();
+    TileMap map{path};
+    std::printf("  open: %.3f ms (%s)\n", secondsSince(start) * 1e3,
+                map.isValid() ? "valid" : map.error().c_str());
+    if (!map.isValid()) {
+        return;
+    }
+
+    // Spot-check the file against the generator
+    std::mt19937 rng{11};
+    std::uniform_int_distribution<int> pickRow{0, ROWS - 1};
+    std::uniform_int_distribution<int> pickCol{0, COLS - 1};
+    bool matches = true;
+    for (int i = 0; i < 100000; ++i) {
+        int r = pickRow(rng);
+        int c = pickCol(rng);
+        matches = matches && map.isWalkable(r, c) == pillarField(r, c);
+        map.evictOutside(r, c, RESIDENT_RADIUS);
+    }
+    std::printf("  tiles match generator: %s\n", matches ? "yes" : "NO");
+
+    // Lookups near the player: chunk already resident
+    int row = ROWS / 2;
+    int col = COLS / 2;
+    reportResult(measure("tilemap/isWalkable resident", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            doNotOptimize(map.isWalkable(row + static_cast<int>(i & 15), col + static_cast<int>(i >> 4 & 15)));
+        }
+    }));
+
+    // A player wandering across the whole map, evicting behind itself
+    std::uniform_int_distribution<int> pickStep{0, 3};
+    const int DR[4] = {-1, 1, 0, 0};
+    const int DC[4] = {0, 0, -1, 1};
+    std::size_t peakResident = 0;
+    reportResult(measure("tilemap/walk+evict", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            int d = pickStep(rng);
+            // Drift toward a corner so the walk keeps entering new chunks
+            int nr = row + DR[d] * 3 + 1;
+            int nc = col + DC[d] * 3 + 1;
+            if (nr <= 0 || nr >= ROWS - 1 || nc <= 0 || nc >= COLS - 1) {
+                nr = 1 + pickRow(rng) % (ROWS - 2);
+                nc = 1 + pickCol(rng) % (COLS - 2);
+            }
+            row = nr;
+            col = nc;
+            doNotOptimize(map.isWalkable(row, col));
+            map.evictOutside(row, col, RESIDENT_RADIUS);
+            peakResident = std::max(peakResident, map.residentChunks());
+        }
+    }));
+
+    const int totalChunks = (ROWS / TileMap::CHUNK_SIZE) * (COLS / TileMap::CHUNK_SIZE);
+    std::printf("  chunks: %d in file, %zu resident (peak %zu), %llu loads\n", totalChunks,
+                map.residentChunks(), peakResident,
+                static_cast<unsigned long long>(map.chunkLoads()));
+
+    // One thread keeps evicting everything and loading chunks back (into
+    // reused slots) while another reads: every read must still match
+    std::atomic<bool> stop{false};
+    std::thread churn{[&] {
+        std::mt19937 churnRng{3};
+        while (!stop.load(std::memory_order_relaxed)) {
+            const int r = pickRow(churnRng);
+            const int c = pickCol(churnRng);
+            map.evictOutside(r, c, 0);
+            doNotOptimize(map.isWalkable(r, c));
+        }
+    }};
+    std::size_t mismatches = 0;
+    std::mt19937 readRng{5};
+    for (int i = 0; i < 2000000; ++i) {
+        // A small area, so its chunks are resident, evicted and reloaded
+        const int r = ROWS / 2 + static_cast<int>(readRng() % 96);
+        const int c = COLS / 2 + static_cast<int>(readRng() % 96);
+        mismatches += map.isWalkable(r, c) != pillarField(r, c);
+    }
+    stop.store(true, std::memory_order_relaxed);
+    churn.join();
+    std::printf("  lookups during concurrent eviction: %s\n",
+                mismatches == 0 ? "all match" : "MISMATCHES");
+    std::remove(path.c_str());
+}
@@ -0,0 +1,257 @@
+#include "Bench.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// bench/main.cpp
+// Entry point for the benchmark suite
+// Runs every registered group, or only those whose name contains a filter.
+// Results can also be written as JSON or CSV, and compared against a CSV
+// from an earlier run to catch regressions.
+// ============================================================================
+
+namespace {
+
+// Exit code when a result is slower than the baseline by more than the
+// threshold
+constexpr int EXIT_REGRESSION = 3;
+
+// One result, with the group that produced it
+struct RecordedResult {
+    std::string group;
+    BenchResult result;
+};
+
+struct BenchRun {
+    const char* group = "";                     // Group running now
+    std::vector<RecordedResult> results;        // Everything reported, in order
+    std::map<std::string, double> baseline;     // name -> ns/op of an earlier run
+    double thresholdPercent = 10.0;             // Slowdown that counts as a regression
+    int regressions = 0;
+};
+
+BenchRun& benchRun() {
+    static BenchRun run;
+    return run;
+}
+
+// Command Line
+
+void printUsage(const char* program) {
+    std::fprintf(stderr,
+                 "Usage: %s [filter] [--json FILE] [--csv FILE] [--baseline FILE] [--threshold PCT]\n"
+                 "\n"
+                 "  filter           Run only groups whose name contains this\n"
+                 "  --json FILE      Also write the results as JSON\n"
+                 "  --csv FILE       Also write the results as CSV (usable as a baseline)\n"
+                 "  --baseline FILE  Compare against the CSV of an earlier run; exits with %d\n"
+                 "                   if anything got slower by more than the threshold\n"
+                 "  --threshold PCT  Slowdown counted as a regression (default 10)\n",
+                 program, EXIT_REGRESSION);
+}
+
+// CSV Fields
+// Names may hold commas, so fields are quoted when needed (RFC 4180)
+
+std::string csvField(const std::string& text) {
+    if (text.find_first_of(",\"\n") == std::string::npos) {
+        return text;
+    }
+    std::string quoted = "\"";
+    for (char ch : text) {
+        if (ch == '"') {
+            quoted += '"';
+        }
+        quoted += ch;
+    }
+    return quoted + "\"";
+}
+
+// Split one CSV line into its fields
+std::vector<std::string> csvFields(const std::string& line) {
+    std::vector<std::string> fields(1);
+    bool quoted = false;
+    for (std::size_t i = 0; i < line.size(); ++i) {
+        const char ch = line[i];
+        if (quoted) {
+            if (ch == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                fields.back() += '"';
+                ++i;
+            } else if (ch == '"') {
+                quoted = false;
+            } else {
+                fields.back() += ch;
+            }
+        } else if (ch == '"') {
+            quoted = true;
+        } else if (ch == ',') {
+            fields.emplace_back();
+        } else if (ch != '\r') {
+            fields.back() += ch;
+        }
+    }
+    return fields;
+}
+
+// Read name -> ns/op from a CSV written by --csv
+// Returns: false if the file cannot be read
+bool loadBaseline(const char* path, std::map<std::string, double>& out) {
+    std::ifstream in{path};
+    if (!in) {
+        return false;
+    }
+    std::string line;
+    std::getline(in, line);  // Header
+    while (std::getline(in, line)) {
+        std::vector<std::string> fields = csvFields(line);
+        if (fields.size() >= 3) {
+            out[fields[1]] = std::strtod(fields[2].c_str(), nullptr);
+        }
+    }
+    return true;
+}
+
+// Output Files
+
+std::string jsonString(const std::string& text) {
+    std::string escaped = "\"";
+    for (char ch : text) {
+        if (ch == '"' || ch == '\\') {
+            escaped += '\\';
+        }
+        escaped += ch;
+    }
+    return escaped + "\"";
+}
+
+bool writeJson(const char* path) {
+    std::FILE* file = std::fopen(path, "w");
+    if (!file) {
+        return false;
+    }
+    char date[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    std::fprintf(file, "{\n  \"date\": \"%s\",\n  \"compiler\": %s,\n  \"results\": [",
+                 date, jsonString(__VERSION__).c_str());
+    const char* separator = "\n";
+    for (const RecordedResult& r : benchRun().results) {
+        std::fprintf(file, "%s    {\"group\": %s, \"name\": %s, \"ns_per_op\": %.3f, \"iterations\": %llu}",
+                     separator, jsonString(r.group).c_str(), jsonString(r.result.name).c_str(),
+                     r.result.nsPerOp, static_cast<unsigned long long>(r.result.iterations));
+        separator = ",\n";
+    }
+    std::fprintf(file, "\n  ]\n}\n");
+    return std::fclose(file) == 0;
+}
+
+bool writeCsv(const char* path) {
+    std::FILE* file = std::fopen(path, "w");
+    if (!file) {
+        return false;
+    }
+    std::fprintf(file, "group,name,ns_per_op,iterations\n");
+    for (const RecordedResult& r : benchRun().results) {
+        std::fprintf(file, "%s,%s,%.3f,%llu\n", csvField(r.group).c_str(),
+                     csvField(r.result.name).c_str(), r.result.nsPerOp,
+                     static_cast<unsigned long long>(r.result.iterations));
+    }
+    return std::fclose(file) == 0;
+}
+
+}  // namespace
+
+std::vector<std::pair<const char*, BenchFunction>>& benchRegistry() {
+    static std::vector<std::pair<const char*, BenchFunction>> registry;
+    return registry;
+}
+
+void reportResult(const BenchResult& result) {
+    BenchRun& run = benchRun();
+    run.results.push_back(RecordedResult{run.group, result});
+
+    std::printf("  %-48s %14.2f ns/op  (%llu ops)", result.name.c_str(),
+                result.nsPerOp, static_cast<unsigned long long>(result.iterations));
+
+    // Change against the baseline, if it has this benchmark
+    auto before = run.baseline.find(result.name);
+    if (before != run.baseline.end() && before->second > 0.0) {
+        const double change = (result.nsPerOp / before->second - 1.0) * 100.0;
+        const bool regressed = change > run.thresholdPercent;
+        run.regressions += regressed;
+        std::printf("  %+6.1f%%%s", change, regressed ? "  REGRESSION" : "");
+    }
+    std::printf("\n");
+    std::fflush(stdout);
+}
+
+int main(int argc, char* argv[]) {
+    BenchRun& run = benchRun();
+    const char* filter = nullptr;
+    const char* jsonPath = nullptr;
+    const char* csvPath = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (std::strcmp(arg, "--json") == 0 && value) {
+            jsonPath = value;
+            ++i;
+        } else if (std::strcmp(arg, "--csv") == 0 && value) {
+            csvPath = value;
+            ++i;
+        } else if (std::strcmp(arg, "--baseline") == 0 && value) {
+            if (!loadBaseline(value, run.baseline)) {
+                std::fprintf(stderr, "Cannot read baseline: %s\n", value);
+                return 1;
+            }
+            ++i;
+        } else if (std::strcmp(arg, "--threshold") == 0 && value) {
+            run.thresholdPercent = std::strtod(value, nullptr);
+            ++i;
+        } else if (arg[0] != '-' && !filter) {
+            filter = arg;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    int ran = 0;
+    for (const auto& [name, fn] : benchRegistry()) {
+        if (filter && std::strstr(name, filter) == nullptr) {
+            continue;
+        }
+        std::printf("%s\n", name);
+        run.group = name;
+        fn();
+        ++ran;
+    }
+
+    if (ran == 0) {
+        std::fprintf(stderr, "No benchmarks match '%s'\n", filter ? filter : "");
+        return 1;
+    }
+    if (jsonPath && !writeJson(jsonPath)) {
+        std::fprintf(stderr, "Cannot write %s\n", jsonPath);
+        return 1;
+    }
+    if (csvPath && !writeCsv(csvPath)) {
+        std::fprintf(stderr, "Cannot write %s\n", csvPath);
+        return 1;
+    }
+    if (run.regressions > 0) {
+        std::printf("%d result(s) more than %.1f%% slower than the baseline\n",
+                    run.regressions, run.thresholdPercent);
+        return EXIT_REGRESSION;
+    }
+    return 0;
+}
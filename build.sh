@@ -1,7 +1,7 @@
 #!/usr/bin/env bash
 # ============================================================================
 # Universal C++ Build Script
-# Supports: debug, release, clean, run, install, test, sanitize, help
+# Supports: debug, release, clean, run, install, test, bench, sanitize, help
 # Auto-detects project structure and creates directories as needed
 # ============================================================================
 
@@ -22,6 +22,7 @@ readonly NC='\033[0m' # No Color
 
 readonly CXX="${CXX:-g++}"
 readonly STD="${STD:-c++20}"
+readonly PROFILING="${PROFILING:-1}"
 readonly ROOT="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
 
 # Auto-detect project name from directory
@@ -34,10 +35,12 @@ readonly LIB_DIR="$ROOT/lib"
 readonly INCLUDE_DIR="$ROOT/include"
 readonly SRC_DIR="$ROOT/src"
 readonly TEST_DIR="$ROOT/test"
+readonly BENCH_DIR="$ROOT/bench"
 readonly INSTALL_PREFIX="${INSTALL_PREFIX:-/usr/local}"
 
 # Build artifacts
 readonly TARGET="$BIN_DIR/$PROJECT_NAME"
+readonly BENCH_TARGET="$BIN_DIR/${PROJECT_NAME}_bench"
 readonly COMPILE_DB="$ROOT/compile_commands.json"
 
 # ============================================================================
@@ -106,6 +109,7 @@ get_common_flags() {
         "-std=$STD"
         "-Wall" "-Wextra" "-Wpedantic"
         "-Wno-unused-parameter"
+        "-DGAME_PROFILING=$PROFILING"
     )
     
     # Include directories
@@ -445,6 +449,47 @@ action_test() {
     print_success "Tests would run here (implement test framework integration)"
 }
 
+action_bench() {
+    if [[ ! -d "$BENCH_DIR" ]]; then
+        print_warning "Benchmark directory not found: $BENCH_DIR"
+        return 0
+    fi
+
+    print_section "Building Benchmarks (release mode)"
+
+    setup_directories
+
+    # Benchmarks link every game source except the game's own main()
+    local sources
+    mapfile -t sources < <(
+        discover_sources "$SRC_DIR" | grep -v "^$SRC_DIR/main\.cpp$"
+        discover_sources "$BENCH_DIR"
+    )
+
+    print_info "Compiler: $CXX"
+    print_info "Sources found: ${#sources[@]}"
+
+    local flags
+    mapfile -t flags < <(get_common_flags "release")
+    flags+=("-I$BENCH_DIR")
+
+    local linker_flags
+    mapfile -t linker_flags < <(get_linker_flags "release")
+
+    # Single compiler invocation: lets -flto see the whole program
+    local cmd=("$CXX" "${flags[@]}" "${sources[@]}")
+    if [[ ${#linker_flags[@]} -gt 0 ]]; then
+        cmd+=("${linker_flags[@]}")
+    fi
+    cmd+=("-o" "$BENCH_TARGET")
+
+    "${cmd[@]}"
+    print_success "Build complete: $BENCH_TARGET"
+
+    print_section "Running Benchmarks"
+    "$BENCH_TARGET" "$@"
+}
+
 action_install() {
     if [[ ! -f "$TARGET" ]]; then
         print_error "Binary not found. Build the project first."
@@ -501,6 +546,8 @@ ${GREEN}Commands:${NC}
     ${YELLOW}clean${NC}          Remove all build artifacts
     ${YELLOW}run${NC} [args]     Build (if needed) and run the executable
     ${YELLOW}test${NC}           Build and run tests (if test/ directory exists)
+    ${YELLOW}bench${NC} [filter] Build benchmarks in release mode and run them
+                   (--json F / --csv F save results, --baseline F compares)
     ${YELLOW}sanitize${NC} [type] Build with sanitizers (address|undefined|memory|thread|all)
     ${YELLOW}install${NC}        Install binary and headers to system
     ${YELLOW}uninstall${NC}      Remove installed files
@@ -510,6 +557,7 @@ ${GREEN}Options:${NC}
     ${YELLOW}VERBOSE=1${NC}      Enable verbose output
     ${YELLOW}CXX=clang++${NC}    Use different compiler
     ${YELLOW}STD=c++23${NC}      Use different C++ standard
+    ${YELLOW}PROFILING=0${NC}    Compile out the frame profiler's probes
     ${YELLOW}INSTALL_PREFIX=/usr${NC}  Custom install prefix
 
 ${GREEN}Examples:${NC}
@@ -518,6 +566,9 @@ ${GREEN}Examples:${NC}
     ./build.sh clean
     ./build.sh run arg1 arg2
     ./build.sh sanitize address
+    ./build.sh bench spatialGrid
+    ./build.sh bench gameplay --csv before.csv
+    ./build.sh bench gameplay --baseline before.csv --json after.json
     VERBOSE=1 ./build.sh debug
     CXX=clang++ ./build.sh release
 
@@ -554,6 +605,9 @@ main() {
         test)
             action_test
             ;;
+        bench)
+            action_bench "${@:2}"
+            ;;
         sanitize)
             action_sanitize "${2:-address}"
             ;;
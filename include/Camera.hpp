@@ -0,0 +1,58 @@
+#pragma once
+
+// Camera.hpp
+// Which part of the world the screen shows, following the player
+
+// Camera Class
+// A viewport of rows x cols tiles over the world. The player can move
+// freely inside a dead zone in the middle of the view; the camera scrolls
+// only when they step into the margin around it, so the map does not shift
+// on every step. The view never shows anything past the world's edges, and
+// a world smaller than the view is shown whole from its top-left corner.
+//
+// Usage:
+//   Camera camera{viewRows, viewCols};
+//   camera.follow(player.row, player.col, map.rows(), map.cols());
+//   ... draw world tiles [top(), top() + rows()) x [left(), left() + cols()) ...
+//
+class Camera {
+public:
+    // Each margin is 1 / DEAD_ZONE_MARGIN of the view; the dead zone is
+    // what is left in the middle
+    static constexpr int DEAD_ZONE_MARGIN = 4;
+
+    // Constructor: rows x cols view, centred on the player at the first follow()
+    Camera(int rows, int cols) { resize(rows, cols); }
+
+    // Change the view size (the next follow() recentres on the player)
+    // No-op if the size is unchanged
+    void resize(int rows, int cols);
+
+    // Scroll so (row, col) is inside the dead zone, keeping the view inside
+    // a worldRows x worldCols world
+    void follow(int row, int col, int worldRows, int worldCols);
+
+    // World tile shown at the view's top-left corner
+    int top() const { return top_; }
+    int left() const { return left_; }
+
+    // Tiles shown (the view size, trimmed to the world after follow())
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+
+    bool contains(int row, int col) const {
+        return row >= top_ && row < top_ + rows_ && col >= left_ && col < left_ + cols_;
+    }
+
+private:
+    // Scroll one axis; returns the new start of the view on that axis
+    static int followAxis(int position, int start, int view, int world, bool recentre);
+
+    int viewRows_{0};  // Requested view size
+    int viewCols_{0};
+    int top_{0};
+    int left_{0};
+    int rows_{0};      // View size trimmed to the world
+    int cols_{0};
+    bool placed_{false};  // Has followed the player since the last resize
+};
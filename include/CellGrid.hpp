@@ -0,0 +1,115 @@
+#pragma once
+
+// CellGrid.hpp
+// A rectangular grid of character cells used to compose a frame in memory
+// before it is sent to an output device
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+// How a cell is drawn
+enum class CellStyle : std::uint8_t {
+    Normal,
+    Dim,  // Faint (e.g. tiles remembered but out of sight)
+};
+
+// CellGrid Class
+// Row-major character buffer with clipped drawing helpers. Each cell also
+// has a style, kept in a parallel plane so text stays plain characters
+// All drawing calls silently ignore coordinates outside the grid, so callers
+// can draw entities without repeating bounds checks
+class CellGrid {
+public:
+    // Constructor: Create a grid filled with blank cells
+    // Parameters:
+    //   - rows, cols: Grid dimensions in cells
+    CellGrid(int rows, int cols)
+        : rows_{rows}, cols_{cols},
+          cells_(static_cast<std::size_t>(rows) * cols, ' '),
+          styles_(cells_.size(), CellStyle::Normal) {}
+
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+
+    // Check if a cell position is inside the grid
+    bool contains(int row, int col) const {
+        return row >= 0 && row < rows_ && col >= 0 && col < cols_;
+    }
+
+    // Read a single cell (position must be inside the grid)
+    char at(int row, int col) const {
+        return cells_[index(row, col)];
+    }
+
+    // Pointer to the first cell of a row (cols() cells long)
+    const char* rowData(int row) const {
+        return cells_.data() + index(row, 0);
+    }
+    char* rowData(int row) {
+        return cells_.data() + index(row, 0);
+    }
+
+    CellStyle styleAt(int row, int col) const {
+        return styles_[index(row, col)];
+    }
+
+    // Pointer to the first style of a row (cols() styles long)
+    const CellStyle* styleRowData(int row) const {
+        return styles_.data() + index(row, 0);
+    }
+
+    // Write a single cell (ignored if outside the grid)
+    void set(int row, int col, char ch) {
+        if (contains(row, col)) {
+            cells_[index(row, col)] = ch;
+        }
+    }
+
+    // Change how a cell is drawn, keeping its character
+    void setStyle(int row, int col, CellStyle style) {
+        if (contains(row, col)) {
+            styles_[index(row, col)] = style;
+        }
+    }
+
+    // Set every cell to the same character, drawn normally
+    void fill(char ch) {
+        std::fill(cells_.begin(), cells_.end(), ch);
+        std::fill(styles_.begin(), styles_.end(), CellStyle::Normal);
+    }
+
+    // Write a string starting at (row, col), clipped at the right edge
+    void writeText(int row, int col, std::string_view text) {
+        if (row < 0 || row >= rows_ || col >= cols_) {
+            return;
+        }
+        if (col < 0) {
+            if (static_cast<std::size_t>(-col) >= text.size()) {
+                return;
+            }
+            text.remove_prefix(static_cast<std::size_t>(-col));
+            col = 0;
+        }
+        std::size_t n = std::min(text.size(), static_cast<std::size_t>(cols_ - col));
+        std::memcpy(cells_.data() + index(row, col), text.data(), n);
+    }
+
+    // Two grids are equal when they have the same size and contents
+    bool operator==(const CellGrid& other) const {
+        return rows_ == other.rows_ && cols_ == other.cols_ &&
+               cells_ == other.cells_ && styles_ == other.styles_;
+    }
+
+private:
+    std::size_t index(int row, int col) const {
+        return static_cast<std::size_t>(row) * cols_ + col;
+    }
+
+    int rows_;                 // Height in cells
+    int cols_;                 // Width in cells
+    std::vector<char> cells_;  // Row-major cell storage
+    std::vector<CellStyle> styles_;  // Style of each cell, same layout
+};
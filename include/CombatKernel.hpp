@@ -0,0 +1,49 @@
+#pragma once
+
+// CombatKernel.hpp
+// Batched combat resolution across every enemy at once
+//
+// Instead of resolving fights one enemy at a time with branches and logging
+// in between, one pass over the EnemyStore arrays:
+//   - finds live enemies on the player's tile
+//   - applies the player's damage and clamps health at zero
+//   - records which enemies died and which survived to strike back
+// The caller then applies the results (XP, player damage, deaths, logs).
+// Uses AVX2 or SSE4.1 when the build targets them, with a scalar fallback.
+
+#include <cstdint>
+#include <vector>
+
+// Forward declarations
+struct EnemyStore;
+
+// Everything one combat round produced
+// Reuse one instance across ticks so the index lists keep their capacity
+struct CombatResult {
+    std::vector<std::uint32_t> struck;  // Enemies the player hit, in index order
+    std::vector<std::uint32_t> killed;  // Subset of struck whose health reached 0
+    int damageToPlayer = 0;             // Sum of counter-attacks from survivors
+
+    void clear() {
+        struck.clear();
+        killed.clear();
+        damageToPlayer = 0;
+    }
+};
+
+// Resolve one round of combat between the player and all enemies on their tile
+// Parameters:
+//   - playerRow, playerCol: Player position
+//   - playerAttack: Damage dealt to each enemy on the tile
+//   - enemies: Enemy storage (health is updated in place; alive flags and the
+//              spatial grid are NOT - call enemies.kill() for result.killed)
+//   - result: Cleared and filled with this round's outcome
+void resolveCombat(int playerRow, int playerCol, int playerAttack,
+                   EnemyStore& enemies, CombatResult& result);
+
+// Portable reference implementation of resolveCombat (same results)
+void resolveCombatScalar(int playerRow, int playerCol, int playerAttack,
+                         EnemyStore& enemies, CombatResult& result);
+
+// Name of the instruction set resolveCombat was compiled for
+const char* combatKernelIsa();
@@ -2,39 +2,77 @@
 
 // Enemy.hpp
 // Enemy-related functions: spawning, AI, collision detection
+// Enemies live in an EnemyStore and are addressed by index
+
+#include <cstddef>
+#include <cstdint>
 
 // Forward declarations
-struct Enemy;
+struct EnemyHandle;
+struct EnemyStore;
+class FlowField;
+class Pathfinder;
 struct Player;
 struct GameState;
+class Rng;
 
 // Enemy Management Functions
 
-// Spawn a new enemy at a random location away from the player
+// Seed the random stream used for enemy spawn positions
+// Parameters:
+//   - state: Game state whose spawnRng is reset
+//   - seed: Same seed + same inputs = same spawn sequence (used by replays)
+void seedEnemyRandom(GameState& state, std::uint32_t seed);
+
+// Spawn an enemy on a free floor tile away from the player, chosen
+// uniformly from enemies.spawnCells in O(1)
 // Parameters:
-//   - enemy: Reference to enemy to respawn
-//   - player: Player reference to avoid spawning on top of them
-// Side effects: Sets enemy position, resets health, marks as alive
-void spawnEnemy(Enemy& enemy, const Player& player);
+//   - enemies: Enemy pool (a free slot is reused if there is one)
+//   - player: Player reference to avoid spawning near them
+//   - rng: Stream the tile is drawn from (one draw per spawn)
+// Returns: Handle to the new enemy, or EnemyHandle::invalid() if the pool
+// is full or no tile is eligible
+EnemyHandle spawnEnemy(EnemyStore& enemies, const Player& player, Rng& rng);
+
+// Add new enemies at random locations away from the player
+// Parameters:
+//   - state: Game state receiving the enemies
+//   - count: Number of enemies to add (stops early if the pool fills up
+//     or no eligible tile is left)
+void spawnEnemies(GameState& state, std::size_t count);
 
 // Check if enemy is alive
-// Returns: true if enemy health > 0 and isAlive flag is true
-bool isEnemyAlive(const Enemy& enemy);
+// Returns: true if enemy health > 0 and its alive flag is set
+bool isEnemyAlive(const EnemyStore& enemies, std::size_t index);
 
 // Collision Detection
 
-// Check if player and enemy are on the same tile
+// Check if the player and an enemy are on the same tile
 // Parameters:
 //   - player: Player to check
-//   - enemy: Enemy to check
+//   - enemies: Enemy storage
+//   - index: Enemy to check
 // Returns: true if both entities occupy the same position
-bool checkCollision(const Player& player, const Enemy& enemy);
+bool checkCollision(const Player& player, const EnemyStore& enemies, std::size_t index);
+
+// Enemy AI
 
-// Enemy AI (Future Enhancement)
+// Move every live enemy one step
+// Enemies within range of the player chase them down the flow field. Out
+// of range, sentries (every 4th slot) patrol between posts on A* routes
+// and the rest wander. Every enemy decides from the positions as they
+// were before this call, so the decisions are independent and run in
+// parallel for large populations; the moves are then applied in index
+// order. The result is identical for any thread count.
+// Parameters:
+//   - enemies: Enemies to move
+//   - chase: Distance field rooted at the player (also gives walkable tiles)
+//   - paths: Route service for patrols (its cache is filled after the moves)
+//   - tick: Current simulation tick (drives wandering and patrol posts)
+void updateEnemyAI(EnemyStore& enemies, const FlowField& chase, Pathfinder& paths,
+                   std::uint64_t tick);
 
-// Simple AI: Move enemy toward player
+// Choose how many threads updateEnemyAI may use
 // Parameters:
-//   - enemy: Enemy to move
-//   - player: Player to move toward
-// Note: Currently unimplemented - enemy stays stationary
-void updateEnemyAI(Enemy& enemy, const Player& player);
+//   - threads: Thread count including the caller (0 = one per hardware thread)
+void setEnemyAIThreads(unsigned threads);
@@ -0,0 +1,273 @@
+#pragma once
+
+// EnemyStore.hpp
+// Structure-of-arrays storage for every enemy in the world
+
+#include "SlotChanges.hpp"
+#include "SpatialGrid.hpp"
+#include "SpawnSet.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// EnemyHandle Structure
+// Stable reference to one enemy. The slot index is reused after the enemy
+// dies, but the generation is bumped each time, so a handle kept past its
+// enemy's death is detectably stale (EnemyStore::isValid returns false).
+struct EnemyHandle {
+    std::uint32_t index;
+    std::uint32_t generation;
+
+    static constexpr std::uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    // Handle that never refers to an enemy (e.g. returned when the pool is full)
+    static constexpr EnemyHandle invalid() { return {INVALID_INDEX, 0}; }
+    bool isNull() const { return index == INVALID_INDEX; }
+
+    bool operator==(const EnemyHandle&) const = default;
+};
+
+// EnemyStore Structure
+// Each enemy attribute lives in its own contiguous array, and enemy i is the
+// i-th element of every array. Per-tick passes that only touch a couple of
+// attributes (e.g. positions for collision) stream through exactly the
+// memory they need, which keeps loops cache-friendly at tens of thousands
+// of enemies.
+//
+// The store is a fixed-capacity pool. All arrays are reserved up front;
+// dead enemies' slots go on a free list and are handed out again in O(1),
+// so spawning and despawning never touch the heap. size() is the number
+// of slots ever used - loops walk [0, size()) and skip slots that are not
+// alive.
+//
+// Live enemies are also indexed by tile in a SpatialGrid, and the tiles
+// they free or fill are reported to the SpawnSet. Stats may be written
+// directly (report the slot with markChanged(), so save snapshots pick it
+// up), but positions and alive flags must change through place(), kill()
+// and release() so everything stays in sync.
+struct EnemyStore {
+    // Starting stats for newly created enemies
+    static constexpr int DEFAULT_HEALTH = 50;
+    static constexpr int DEFAULT_ATTACK = 1;
+
+    // Pool size used when none is given
+    static constexpr std::size_t DEFAULT_CAPACITY = 1024;
+
+    // Stats
+    std::vector<int> health;        // Current health points
+    std::vector<int> maxHealth;     // Maximum health capacity
+    std::vector<int> attack;        // Damage dealt per attack
+
+    // Position on the game map
+    std::vector<int> row;           // Vertical position (Y coordinate)
+    std::vector<int> col;           // Horizontal position (X coordinate)
+
+    // State
+    std::vector<std::uint8_t> alive;        // 1 if this enemy is currently active
+    std::vector<std::uint32_t> generation;  // Bumped each time the slot is freed
+
+    // Live enemies by tile (ids are indices into the arrays above)
+    SpatialGrid grid;
+
+    // Free floor tiles away from the player (window set by the owner)
+    SpawnSet spawnCells;
+
+    // Constructor: Empty pool for a map of the given size
+    // Parameters:
+    //   - mapRows, mapCols: Map dimensions (for the spatial grid)
+    //   - capacity: Maximum number of enemies alive at once
+    EnemyStore(int mapRows, int mapCols, std::size_t capacity = DEFAULT_CAPACITY)
+        : grid{mapRows, mapCols}, capacity_{capacity} {
+        health.reserve(capacity);
+        maxHealth.reserve(capacity);
+        attack.reserve(capacity);
+        row.reserve(capacity);
+        col.reserve(capacity);
+        alive.reserve(capacity);
+        generation.reserve(capacity);
+        freeSlots_.reserve(capacity);
+        grid.reserveEntities(capacity);
+        changes_.reserve(capacity);
+    }
+
+    // Pool Management
+
+    // Number of slots ever used (alive or not) - iterate [0, size())
+    std::size_t size() const { return health.size(); }
+    bool empty() const { return health.empty(); }
+
+    std::size_t capacity() const { return capacity_; }
+
+    // Enemies alive right now
+    std::size_t occupancy() const { return occupancy_; }
+
+    // Most enemies that were ever alive at the same time
+    std::size_t highWaterMark() const { return highWater_; }
+
+    // Take a slot and create a live enemy at full health
+    // Reuses the most recently freed slot if any, else a never-used one
+    // Returns: handle to the new enemy, or EnemyHandle::invalid() if full
+    EnemyHandle add(int h, int a, int r, int c) {
+        std::size_t index;
+        if (!freeSlots_.empty()) {
+            index = freeSlots_.back();
+            freeSlots_.pop_back();
+            health[index] = h;
+            maxHealth[index] = h;
+            attack[index] = a;
+            row[index] = r;
+            col[index] = c;
+            alive[index] = 1;
+            changes_.mark(index);
+        } else if (size() < capacity_) {
+            index = size();
+            health.push_back(h);
+            maxHealth.push_back(h);
+            attack.push_back(a);
+            row.push_back(r);
+            col.push_back(c);
+            alive.push_back(1);
+            generation.push_back(0);
+            changes_.grow(size());
+            changes_.mark(index);
+        } else {
+            return EnemyHandle::invalid();
+        }
+
+        grid.insert(static_cast<std::uint32_t>(index), r, c);
+        spawnCells.setOccupied(r, c, true);
+        occupancy_++;
+        if (occupancy_ > highWater_) {
+            highWater_ = occupancy_;
+        }
+        return handleOf(index);
+    }
+
+    // Kill an enemy and return its slot to the pool
+    // Any handle to it becomes stale
+    void release(std::size_t index) {
+        if (!alive[index]) {
+            return;
+        }
+        kill(index);
+        generation[index]++;
+        changes_.mark(index);
+        freeSlots_.push_back(static_cast<std::uint32_t>(index));
+    }
+
+    // Handles
+
+    // Current handle for a slot
+    EnemyHandle handleOf(std::size_t index) const {
+        return {static_cast<std::uint32_t>(index), generation[index]};
+    }
+
+    // Check that a handle still refers to the live enemy it was issued for
+    bool isValid(EnemyHandle handle) const {
+        return handle.index < size() &&
+               generation[handle.index] == handle.generation &&
+               alive[handle.index];
+    }
+
+    // Position and Life
+
+    // Move an enemy to a new tile
+    void place(std::size_t index, int r, int c) {
+        if (alive[index]) {
+            grid.move(static_cast<std::uint32_t>(index), row[index], col[index], r, c);
+            spawnCells.setOccupied(row[index], col[index], grid.countAt(row[index], col[index]) > 0);
+            spawnCells.setOccupied(r, c, true);
+        }
+        row[index] = r;
+        col[index] = c;
+        changes_.mark(index);
+    }
+
+    // Mark an enemy dead and drop it from the grid (slot stays reserved)
+    void kill(std::size_t index) {
+        if (alive[index]) {
+            grid.remove(static_cast<std::uint32_t>(index), row[index], col[index]);
+            spawnCells.setOccupied(row[index], col[index], grid.countAt(row[index], col[index]) > 0);
+            alive[index] = 0;
+            occupancy_--;
+            changes_.mark(index);
+        }
+    }
+
+    // Count enemies currently alive
+    std::size_t aliveCount() const { return occupancy_; }
+
+    // Snapshots
+
+    // Released slots; the last one is handed out next
+    const std::vector<std::uint32_t>& freeSlots() const { return freeSlots_; }
+
+    // Remove every enemy and forget every slot, as if freshly constructed
+    void clear() {
+        // Unlinking enemies one by one touches the grid at random; with
+        // more than one per 64 tiles of occupied chunks, wiping all of it
+        // is cheaper
+        const std::size_t tiles = grid.occupiedChunks() * SpatialGrid::CHUNK_TILES;
+        if (occupancy_ * 64 >= tiles) {
+            for (std::size_t i = 0; i < size(); ++i) {
+                if (alive[i]) {
+                    spawnCells.setOccupied(row[i], col[i], false);
+                }
+            }
+            grid.clear();
+            occupancy_ = 0;
+        } else {
+            for (std::size_t i = 0; i < size(); ++i) {
+                kill(i);
+            }
+        }
+        health.clear();
+        maxHealth.clear();
+        attack.clear();
+        row.clear();
+        col.clear();
+        alive.clear();
+        generation.clear();
+        freeSlots_.clear();
+        highWater_ = 0;
+        changes_.markAll(0);
+    }
+
+    // Take over slots whose arrays were filled in directly (e.g. from a
+    // save): index the live ones in the grid and spawn set, and adopt the
+    // free list and peak occupancy they were saved with. Call on a cleared
+    // store after giving every array the same length (at most capacity()).
+    void adoptSlots(const std::uint32_t* freeSlots, std::size_t freeCount, std::size_t highWater) {
+        for (std::size_t i = 0; i < size(); ++i) {
+            if (alive[i]) {
+                grid.insert(static_cast<std::uint32_t>(i), row[i], col[i]);
+                spawnCells.setOccupied(row[i], col[i], true);
+                occupancy_++;
+            }
+        }
+        freeSlots_.assign(freeSlots, freeSlots + freeCount);
+        highWater_ = highWater > occupancy_ ? highWater : occupancy_;
+        changes_.markAll(size());
+    }
+
+    // Change Tracking
+
+    // Slot written directly (stats, e.g. combat damage)
+    void markChanged(std::size_t index) { changes_.mark(index); }
+
+    // Slots written since earlier copies of the arrays
+    const SlotChanges& changes() const { return changes_; }
+
+    // End the change epoch: a copy of the arrays was just taken (copying
+    // does not change the enemies, hence const)
+    // Returns: the epoch the copy records
+    std::uint32_t endChangeEpoch() const { return changes_.endEpoch(); }
+
+private:
+    std::size_t capacity_;                  // Maximum live enemies
+    std::size_t occupancy_{0};              // Live enemies right now
+    std::size_t highWater_{0};              // Peak occupancy
+    std::vector<std::uint32_t> freeSlots_;  // Released slots, reused LIFO
+    mutable SlotChanges changes_;           // Bookkeeping for copies only
+};
@@ -0,0 +1,152 @@
+#pragma once
+
+// EventLog.hpp
+// Game messages (combat, experience, level ups, healing) as typed events in
+// a lock-free ring, read by the HUD's message panel and an optional log file
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// What happened; the meaning of a, b and c depends on the type
+enum class LogEventType : std::uint8_t {
+    PlayerAttack,      // a = damage dealt
+    EnemyDefeated,     // (no values)
+    EnemyAttack,       // a = damage taken
+    ExperienceGained,  // a = amount, b = experience now, c = needed for next level
+    LevelUp,           // a = new level, b = max health, c = attack
+    Healed,            // a = health restored
+};
+
+// One logged event
+struct LogEvent {
+    std::uint64_t tick;  // Simulation tick it happened on
+    LogEventType type;
+    int a;
+    int b;
+    int c;
+};
+
+// Write an event as a line of text (no newline), e.g. "[XP] Gained 25 experience! (25/100)"
+// Returns: Length of the text (truncated to fit size, like snprintf)
+int formatLogEvent(const LogEvent& event, char* out, std::size_t size);
+
+// EventLog Class
+// Fixed-size ring of the most recent events. One thread (the simulation)
+// pushes; any number of threads read, each at its own pace, by sequence
+// number. Nothing ever waits: the writer overwrites the oldest event, and a
+// reader that falls more than CAPACITY events behind simply loses the
+// overwritten ones. Each slot carries the sequence number it holds, so a
+// reader can tell a slot rewritten under it from the event it wanted.
+//
+// Usage:
+//   log.setTick(state.tick);                        // Simulation thread
+//   log.push(LogEventType::PlayerAttack, damage);
+//
+//   LogEvent event;                                 // Any thread
+//   for (std::uint64_t seq = from; seq < log.written(); ++seq) {
+//       if (log.read(seq, event)) { ... }
+//   }
+//
+class EventLog {
+public:
+    // Events kept (a power of two)
+    static constexpr std::size_t CAPACITY = 1024;
+
+    // Constructor: Empty log
+    EventLog();
+
+    EventLog(const EventLog&) = delete;
+    EventLog& operator=(const EventLog&) = delete;
+
+    // Writer Side (one thread)
+
+    // Tick stamped on events pushed from now on
+    void setTick(std::uint64_t tick) { tick_ = tick; }
+
+    // Append an event (never blocks, never allocates)
+    void push(LogEventType type, int a = 0, int b = 0, int c = 0);
+
+    // Reader Side (any thread)
+
+    // Events pushed so far; the next one gets this sequence number
+    std::uint64_t written() const { return written_.load(std::memory_order_acquire); }
+
+    // Copy out event number seq
+    // Returns: false if it was not written yet or has been overwritten
+    bool read(std::uint64_t seq, LogEvent& out) const;
+
+private:
+    static constexpr std::uint64_t EMPTY = ~std::uint64_t{0};  // Slot being written / never written
+
+    // Event fields are atomics so a reader racing the writer is well defined;
+    // the sequence check afterwards discards what it read if so
+    struct Slot {
+        std::atomic<std::uint64_t> seq{EMPTY};
+        std::atomic<std::uint64_t> tick{0};
+        std::atomic<std::uint64_t> typeAndA{0};
+        std::atomic<std::uint64_t> bAndC{0};
+    };
+
+    std::array<Slot, CAPACITY> slots_;
+    std::atomic<std::uint64_t> written_{0};
+    std::uint64_t tick_{0};  // Writer only
+};
+
+// EventLogFile Class
+// Background thread that appends a log's events to a text file, one line
+// per event. It wakes every FLUSH_INTERVAL_MS, formats everything new in one
+// batch and writes it with a single call, so the simulation never waits on
+// the disk. If it ever falls a whole ring behind, the gap is noted in the
+// file. Events still unwritten are flushed when it is destroyed.
+//
+// Usage:
+//   EventLogFile file{state.log, "game.log"};
+//   if (!file.isOpen()) { ... report ... }
+//
+class EventLogFile {
+public:
+    static constexpr int FLUSH_INTERVAL_MS = 100;
+
+    // Constructor: Start writing events pushed from now on to path
+    // (the file is truncated)
+    EventLogFile(std::shared_ptr<const EventLog> log, const std::string& path);
+
+    // Destructor: Write what is left and stop the thread
+    ~EventLogFile();
+
+    EventLogFile(const EventLogFile&) = delete;
+    EventLogFile& operator=(const EventLogFile&) = delete;
+
+    bool isOpen() const { return file_ != nullptr; }
+
+    // Events written to the file so far, and events lost to overwrites
+    std::uint64_t eventsWritten() const { return eventsWritten_.load(std::memory_order_relaxed); }
+    std::uint64_t eventsLost() const { return eventsLost_.load(std::memory_order_relaxed); }
+
+private:
+    void run();
+
+    // Format and write every event since the last batch
+    void writeBatch();
+
+    std::shared_ptr<const EventLog> log_;
+    std::FILE* file_{nullptr};
+    std::uint64_t next_{0};  // Sequence number of the next event to write
+    std::string batch_;      // Text of one batch (reused)
+
+    std::atomic<std::uint64_t> eventsWritten_{0};
+    std::atomic<std::uint64_t> eventsLost_{0};
+
+    std::mutex stopMutex_;  // Only the destructor and the writer thread use these
+    std::condition_variable stopSignal_;
+    bool stopping_{false};
+    std::thread thread_;    // Declared last: starts after everything above
+};
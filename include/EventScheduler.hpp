@@ -0,0 +1,74 @@
+#pragma once
+
+// EventScheduler.hpp
+// Timed game events keyed on simulation ticks
+// Lets game logic say "do X in 1.5 seconds" without ever blocking the loop
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Kinds of events that can be scheduled
+enum class TimedEventType : std::uint8_t {
+    HideVictoryBanner,  // Remove the "VICTORY!" overlay
+    RespawnEnemy,       // Bring a defeated enemy back (payload unused)
+};
+
+// Highest TimedEventType (save files reject anything above it); new types
+// go after it and move it along
+constexpr TimedEventType LAST_EVENT_TYPE = TimedEventType::RespawnEnemy;
+
+// A single scheduled event
+struct TimedEvent {
+    std::uint64_t tick;      // Simulation tick at which the event fires
+    std::uint64_t sequence;  // Scheduling order (breaks ties deterministically)
+    TimedEventType type;     // What to do
+    int payload;             // Event-specific data
+};
+
+// EventScheduler Class
+// Min-heap of TimedEvents ordered by (tick, sequence). Events due on the same
+// tick fire in the order they were scheduled. Plain data only, so the queue
+// copies along with GameState snapshots.
+//
+// Usage:
+//   scheduler.schedule(state.tick + delay, TimedEventType::RespawnEnemy);
+//   TimedEvent event;
+//   while (scheduler.popDue(state.tick, event)) { handle(event); }
+//
+class EventScheduler {
+public:
+    // Queue an event to fire at the given simulation tick
+    // Parameters:
+    //   - tick: When to fire (events in the past fire on the next pop)
+    //   - type: What kind of event
+    //   - payload: Event-specific data
+    void schedule(std::uint64_t tick, TimedEventType type, int payload = 0);
+
+    // Remove the earliest event if it is due
+    // Parameters:
+    //   - now: Current simulation tick
+    //   - out: Receives the event when one is due
+    // Returns: true if an event was removed
+    bool popDue(std::uint64_t now, TimedEvent& out);
+
+    // Tick of the earliest pending event (undefined when empty)
+    std::uint64_t nextTick() const { return heap_.front().tick; }
+
+    bool empty() const { return heap_.empty(); }
+    std::size_t size() const { return heap_.size(); }
+    void clear() { heap_.clear(); }
+
+    // Pending events in heap order (for inspection and saving)
+    const std::vector<TimedEvent>& pending() const { return heap_; }
+
+    // Sequence number the next scheduled event gets
+    std::uint64_t nextSequence() const { return nextSequence_; }
+
+    // Replace the queue with saved events (any order) and sequence counter
+    void restore(const TimedEvent* events, std::size_t count, std::uint64_t nextSequence);
+
+private:
+    std::vector<TimedEvent> heap_;       // Binary min-heap on (tick, sequence)
+    std::uint64_t nextSequence_{0};
+};
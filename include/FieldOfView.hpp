@@ -0,0 +1,128 @@
+#pragma once
+
+// FieldOfView.hpp
+// What the player can see from where they stand, and what they have seen
+// before (drawn dimmed)
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class TileMap;
+
+// FieldOfView Class
+// Symmetric shadowcasting (Albert Ford's variant): walls cast shadows, a
+// floor tile is visible when its centre is in view, and a wall when any part
+// of it is. Visibility is symmetric - if A sees B, B sees A - so what the
+// player sees is exactly what could see them.
+//
+// Sight reaches radiusRows / radiusCols tiles in each direction (a box, so
+// it can cover a whole screen window that contains the player). Results:
+//   - Visible tiles: a bitset over that box, rebuilt only when the player
+//     moves (update() is a no-op while they stand still).
+//   - Remembered tiles: every tile ever seen, stored per 32x32 chunk, so
+//     memory grows with the area explored rather than the world's size.
+//
+// Usage:
+//   FieldOfView sight{radiusRows, radiusCols};
+//   sight.update(map, player.row, player.col);   // Every tick; cheap if unchanged
+//   if (sight.isVisible(r, c)) { ... draw it ... }
+//   else if (sight.isRemembered(r, c)) { ... draw it dimmed ... }
+//
+class FieldOfView {
+public:
+    // Constructor: Sight reaching radiusRows x radiusCols tiles from the
+    // viewer; nothing is visible until the first update()
+    FieldOfView(int radiusRows, int radiusCols);
+
+    int radiusRows() const { return radiusRows_; }
+    int radiusCols() const { return radiusCols_; }
+
+    // Viewer
+
+    // Recompute the view from (row, col) if the viewer moved
+    // Parameters:
+    //   - map: Walls block sight; tiles off the map are walls
+    // Returns: true if the view was recomputed
+    bool update(const TileMap& map, int row, int col);
+
+    // Force the next update() to recompute (after walls change)
+    void invalidate() { valid_ = false; }
+
+    // Queries
+
+    // Tile is in sight right now
+    bool isVisible(int row, int col) const {
+        const int r = row - boxTop_;
+        const int c = col - boxLeft_;
+        if (!valid_ || r < 0 || r >= boxRows_ || c < 0 || c >= boxCols_) {
+            return false;
+        }
+        const std::size_t bit = static_cast<std::size_t>(r) * boxCols_ + c;
+        return (visible_[bit / 64] >> (bit % 64)) & 1u;
+    }
+
+    // Tile has been in sight at some point
+    bool isRemembered(int row, int col) const;
+
+    // Tiles visible from the current position
+    std::size_t visibleCount() const { return visibleCount_; }
+
+    // Chunks holding remembered tiles
+    std::size_t rememberedChunks() const { return remembered_.size(); }
+
+private:
+    static constexpr int CHUNK_SIZE = 32;
+    static constexpr int CHUNK_WORDS = CHUNK_SIZE * CHUNK_SIZE / 64;
+
+    using ChunkBits = std::array<std::uint64_t, CHUNK_WORDS>;
+
+    // Slope of a line from the viewer, as the fraction num / den (den > 0)
+    struct Slope {
+        int num;
+        int den;
+    };
+
+    // One row of a quadrant scan: the tiles at a given depth between two slopes
+    struct ScanRow {
+        int depth;
+        Slope start;
+        Slope end;
+    };
+
+    static std::uint64_t chunkKey(int row, int col) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(row / CHUNK_SIZE)) << 32) |
+               static_cast<std::uint32_t>(col / CHUNK_SIZE);
+    }
+
+    // Scan one quadrant (0 = north, 1 = south, 2 = east, 3 = west)
+    void scanQuadrant(const TileMap& map, int quadrant);
+
+    // Mark a tile visible
+    void reveal(int row, int col);
+
+    // Add every visible tile on the map to the remembered ones
+    void rememberVisible(const TileMap& map);
+
+    int radiusRows_;
+    int radiusCols_;
+
+    // Viewer the current view was computed for
+    bool valid_{false};
+    int viewerRow_{0};
+    int viewerCol_{0};
+
+    // Box of tiles sight can reach, in world coordinates
+    int boxTop_{0};
+    int boxLeft_{0};
+    int boxRows_;
+    int boxCols_;
+
+    std::vector<std::uint64_t> visible_;   // One bit per box tile
+    std::size_t visibleCount_{0};
+    std::unordered_map<std::uint64_t, ChunkBits> remembered_;
+
+    std::vector<ScanRow> pending_;  // Rows still to scan (reused)
+};
@@ -0,0 +1,226 @@
+#pragma once
+
+// FlowField.hpp
+// Shared distance field toward one target (the player) for enemy chasing
+// One breadth-first search serves every enemy: each reads its distance and
+// steps to a neighbour one tile closer, so chase cost does not grow with
+// the number of enemies
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+// FlowField Class
+// Holds the walking distance from every tile to a root tile over 4-connected
+// walkable tiles (unit cost per step, so Dijkstra reduces to BFS).
+//
+// The field is kept up to date incrementally:
+//   - Root moves one tile: tiles hold their distance minus the wall-free
+//     (Manhattan) distance to the root, which the step changes by exactly
+//     one everywhere - down on the new root's side, up on the old root's.
+//     Each side stays consistent on its own, so only the two lines of
+//     tiles either side of the step can be wrong: tiles that relied on a
+//     path across it are cleared and refilled, and shorter paths across it
+//     are lowered outward. Open ground costs nothing; the work is bounded
+//     by the tiles whose detour around walls actually changed.
+//   - Wall removed: distances only drop; lowered from the opened tile.
+//   - Wall added: only tiles whose every shortest path ran through it
+//     change; they are found, cleared and refilled from their neighbours.
+// Anything else (a jump of several tiles) rebuilds from scratch.
+//
+// The field may cover a window of a larger world: tiles are addressed in
+// world coordinates, and tiles outside the window are unreachable walls.
+//
+// Usage:
+//   FlowField field{rows, cols};
+//   field.setWalls([&](int r, int c) { return map.isWalkable(r, c); });
+//   field.setRoot(player.row, player.col);   // Every tick; cheap if unchanged
+//   int d = field.distance(row, col);
+//
+class FlowField {
+public:
+    // Distance of tiles that cannot reach the root (and of tiles off the map)
+    static constexpr int UNREACHABLE = std::numeric_limits<int>::max();
+
+    // Constructor: rows x cols field at the world origin, with no walkable
+    // tiles and no root
+    FlowField(int rows, int cols);
+
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+
+    // World tile at the window's top-left corner
+    int originRow() const { return originRow_; }
+    int originCol() const { return originCol_; }
+
+    bool contains(int row, int col) const {
+        return row >= originRow_ && row < originRow_ + rows_ &&
+               col >= originCol_ && col < originCol_ + cols_;
+    }
+
+    // Walls
+
+    // Reload walkability for every tile and rebuild
+    // Parameters:
+    //   - isWalkable: Callable (int row, int col) -> bool
+    template <typename Walkable>
+    void setWalls(Walkable&& isWalkable) {
+        for (int r = originRow_; r < originRow_ + rows_; ++r) {
+            for (int c = originCol_; c < originCol_ + cols_; ++c) {
+                walkable_[cellIndex(r, c)] = isWalkable(r, c) ? 1 : 0;
+            }
+        }
+        if (hasRoot_) {
+            rebuild();
+        }
+    }
+
+    // Move the window so its top-left corner is (originRow, originCol),
+    // then reload its walls (the root is dropped if it falls outside)
+    template <typename Walkable>
+    void moveWindow(int originRow, int originCol, Walkable&& isWalkable) {
+        originRow_ = originRow;
+        originCol_ = originCol;
+        hasRoot_ = hasRoot_ && contains(rootRow_, rootCol_);
+        if (hasRoot_) {
+            rootCell_ = cellIndex(rootRow_, rootCol_);
+        } else {
+            std::fill(stored_.begin(), stored_.end(), INF);
+        }
+        setWalls(isWalkable);
+    }
+
+    // Change one tile and repair the affected distances
+    void setWalkable(int row, int col, bool walkable);
+
+    bool isWalkable(int row, int col) const {
+        return contains(row, col) && walkable_[cellIndex(row, col)];
+    }
+
+    // Root
+
+    // Move the root (no-op if unchanged, incremental if one step away)
+    void setRoot(int row, int col);
+
+    int rootRow() const { return rootRow_; }
+    int rootCol() const { return rootCol_; }
+
+    // Queries
+
+    // Steps from a tile to the root, or UNREACHABLE
+    int distance(int row, int col) const {
+        if (!contains(row, col)) {
+            return UNREACHABLE;
+        }
+        return load(cellIndex(row, col), row - originRow_, col - originCol_);
+    }
+
+    // Statistics
+
+    // Full rebuilds since construction
+    std::uint64_t rebuildCount() const { return rebuilds_; }
+
+    // Distance writes made by the most recent update (its cost in tiles)
+    std::size_t lastUpdateTouched() const { return touched_; }
+
+private:
+    // Tiles store their distance minus the straight-line distance to the
+    // root, so a root step leaves open ground untouched; INF marks tiles
+    // that cannot reach the root
+    static constexpr std::int32_t INF = std::numeric_limits<std::int32_t>::max();
+
+    // Cell of a world tile inside the window
+    std::size_t cellIndex(int row, int col) const {
+        return static_cast<std::size_t>(row - originRow_) * cols_ + (col - originCol_);
+    }
+
+    // Steps from a window tile (window coordinates) to the root, ignoring walls
+    int straightLine(int row, int col) const {
+        return std::abs(row - (rootRow_ - originRow_)) + std::abs(col - (rootCol_ - originCol_));
+    }
+
+    int load(std::size_t cell, int row, int col) const {
+        std::int32_t s = stored_[cell];
+        return s == INF ? UNREACHABLE : s + straightLine(row, col);
+    }
+
+    int load(std::size_t cell) const {
+        return load(cell, static_cast<int>(cell / cols_), static_cast<int>(cell % cols_));
+    }
+
+    void store(std::size_t cell, int row, int col, int dist) {
+        stored_[cell] = dist == UNREACHABLE ? INF : dist - straightLine(row, col);
+    }
+
+    void store(std::size_t cell, int dist) {
+        store(cell, static_cast<int>(cell / cols_), static_cast<int>(cell % cols_), dist);
+    }
+
+    // Tiles a path may pass through (the root counts even if it is a wall)
+    bool passable(std::size_t cell) const { return walkable_[cell] || cell == rootCell_; }
+
+    // Fresh BFS from the root
+    void rebuild();
+
+    // BFS outward from the tiles in queue_, lowering neighbours only
+    void lowerFromQueue();
+
+    // Lower tiles outward from the distances in seeds_, nearest first
+    void lowerFromSeeds();
+
+    // Add the best distance each cleared tile in affected_ can get from
+    // its neighbours to seeds_
+    void seedAffected();
+
+    void addSeed(int dist, std::size_t cell) {
+        seeds_.push_back((static_cast<std::uint64_t>(dist) << 32) | cell);
+    }
+
+    // Visiting in increasing distance without a heap: seeds_ is sorted
+    // once, and everything pushed while popping is one step farther than
+    // what was popped, so pending_ stays sorted and the two just merge
+    void startPass();
+    bool popNearest(int& dist, std::size_t& cell);
+
+    void pushNext(int dist, std::size_t cell) {
+        pending_.push_back((static_cast<std::uint64_t>(dist) << 32) | cell);
+    }
+
+    // Next mark_ stamp (clears the marks when it wraps)
+    void nextMark();
+
+    // Root moved one tile from (oldRow, oldCol), in window coordinates
+    void stepRoot(int oldRow, int oldCol);
+
+    // Wall added on a tile that had a finite distance
+    void raiseAround(std::size_t wall);
+
+    int rows_;
+    int cols_;
+    int originRow_{0};
+    int originCol_{0};
+
+    bool hasRoot_{false};
+    int rootRow_{0};
+    int rootCol_{0};
+    std::size_t rootCell_{0};
+
+    std::vector<std::int32_t> stored_;    // Distance - straightLine, per tile
+    std::vector<std::uint8_t> walkable_;  // 1 if a path may enter the tile
+
+    // Scratch reused by every update (no allocation once warmed up)
+    std::vector<std::uint32_t> queue_;
+    std::vector<std::uint32_t> affected_;
+    std::vector<std::uint32_t> mark_;     // == markStamp_ when visited this update
+    std::uint32_t markStamp_{0};
+    std::vector<std::uint64_t> seeds_;    // (distance << 32 | cell)
+    std::vector<std::uint64_t> pending_;  // (distance << 32 | cell), FIFO
+    std::size_t seedHead_{0};
+    std::size_t pendingHead_{0};
+
+    std::uint64_t rebuilds_{0};
+    std::size_t touched_{0};
+};
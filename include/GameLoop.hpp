@@ -3,34 +3,125 @@
 // GameLoop.hpp
 // Main game loop and game logic update functions
 
+#include "Input.hpp"
+#include "SimClock.hpp"
+
+#include <cstdint>
+#include <string>
+
 // Forward declarations
 struct GameState;
+class AutoSaver;
+class ReplayRecorder;
+class ReplayReader;
 
 // Main Game Loop
 
+// Outcome of an interactive session
+struct GameRunStats {
+    SimClockStats clock;   // Tick timing
+    InputStats input;      // Keys read, dropped, and input-to-display latency
+};
+
 // Run the main game loop with real-time input and rendering
 // This is the core game loop that:
-//   1. Polls for keyboard input
-//   2. Updates game state
-//   3. Renders the current frame
+//   1. Reads the keyboard on an input thread, which queues every key
+//   2. Runs the simulation ticks that are due (fixed timestep), applying
+//      all keys queued before each tick
+//   3. Publishes a snapshot to the render thread, which draws it
+//      independently (stale snapshots are dropped if the terminal is slow)
 //   4. Repeats until game ends
 //
 // Parameters:
 //   - state: Reference to game state (modified during gameplay)
+//   - clockConfig: Simulation tick rate and catch-up limit
+//   - recorder: Optional replay log receiving every key (finished on exit)
+//   - autosaver: Optional autosave, offered the state after every tick and
+//     saved once more on exit (unless the player died)
+// Returns: Tick statistics (including ticks run late or dropped) and
+//          input statistics (keys read, time from key to frame on screen)
 //
 // Loop exits when:
 //   - Player presses 'q' to quit
 //   - Player health reaches 0 (death)
-void runGame(GameState& state);
+GameRunStats runGame(GameState& state, const SimClockConfig& clockConfig = {},
+                     ReplayRecorder* recorder = nullptr, AutoSaver* autosaver = nullptr);
+
+// Headless Simulation
+
+// Settings for a headless (no terminal) fast-forward run
+struct HeadlessConfig {
+    std::uint64_t ticks = 1'000'000;   // Simulation ticks to run
+    std::uint32_t seed = 1;            // Seed for random input
+    std::string script;                // Keys to replay in a loop (empty = random WASD)
+    int keyInterval = 10;              // Ticks between simulated key presses
+    int renderEvery = 0;               // Compose a frame every N ticks (0 = never)
+};
+
+// Outcome of a headless run
+struct HeadlessResult {
+    std::uint64_t ticksRun = 0;        // Ticks actually simulated
+    std::uint64_t framesRendered = 0;  // Frames composed into the headless backend
+    double seconds = 0.0;              // Wall time spent in the loop
+};
+
+// Drive the simulation without RawInput or the terminal, as fast as possible
+// Feeds scripted or random keys through handleInput and calls tickGame until
+// the tick budget runs out, the player dies, or the script presses 'q'
+// Parameters:
+//   - state: Game state to advance
+//   - config: Tick budget, input source and optional headless rendering
+//   - recorder: Optional replay log receiving every key (finished on exit)
+//   - autosaver: Optional autosave, as for runGame
+// Returns: Ticks run and wall time (for ticks/sec throughput)
+HeadlessResult runHeadless(GameState& state, const HeadlessConfig& config,
+                           ReplayRecorder* recorder = nullptr, AutoSaver* autosaver = nullptr);
+
+// Outcome of replaying a recorded session
+struct ReplayResult {
+    std::uint64_t ticksRun = 0;       // Ticks simulated
+    std::uint64_t eventsApplied = 0;  // Key events fed to handleInput
+    double seconds = 0.0;             // Wall time spent in the loop
+    std::uint64_t expectedHash = 0;   // State hash stored in the log
+    std::uint64_t actualHash = 0;     // State hash after replaying
+    bool matched = false;             // Final tick and hash both agree
+};
+
+// Replay a recorded session headless at maximum speed
+// Reseeds the enemy RNG from the log, applies each key on its recorded tick
+// and compares the final state against the log's footer
+// Parameters:
+//   - state: Fresh game state (same starting values as the recording)
+//   - reader: Open, valid replay log
+// Returns: Throughput and verification result
+ReplayResult runReplay(GameState& state, ReplayReader& reader);
+
+// Apply a single key press to the game state
+// Handles:
+//   - 'q' quits (clears isGameRunning)
+//   - W/A/S/D and the arrow keys set the held movement direction
+// Parameters:
+//   - state: Game state to modify
+//   - key: Key code (ASCII, or one of the KEY_ codes from Input.hpp)
+void handleInput(GameState& state, int key);
+
+// Advance the simulation by exactly one fixed tick
+// Moves the player (rate limited), updates game logic, increments state.tick
+// Parameters:
+//   - state: Game state to advance
+void tickGame(GameState& state);
+
+// Convert a game-time duration into whole ticks at the state's tick rate
+std::uint64_t ticksFromMilliseconds(const GameState& state, int milliseconds);
 
 // Game Logic Updates
 
-// Update all game logic for current frame
+// Update all game logic for the current tick
 // Handles:
 //   - Collision detection between player and enemy
 //   - Combat triggers
-//   - Enemy respawning when defeated
-//   - Any other per-frame game logic
+//   - Scheduled events (victory banner, delayed enemy respawn)
+//   - Any other per-tick game logic
 //
 // Parameters:
 //   - state: Current game state to update
@@ -3,6 +3,22 @@
 // GameState.hpp
 // Defines all core game data structures and entities
 
+#include "EnemyStore.hpp"
+#include "EventLog.hpp"
+#include "EventScheduler.hpp"
+#include "FieldOfView.hpp"
+#include "FlowField.hpp"
+#include "Pathfinder.hpp"
+#include "Player.hpp"
+#include "Random.hpp"
+#include "TileMap.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
 // Player Structure
 // Represents the player character with position, stats, and level progression
 struct Player {
@@ -23,45 +39,126 @@ struct Player {
           row{r}, col{c} {}
 };
 
-// Enemy Structure
-// Represents hostile NPCs with position, stats, and alive status
-struct Enemy {
-    // Stats
-    int health;        // Current health points
-    int maxHealth;     // Maximum health capacity
-    int attack;        // Damage dealt per attack
-
-    // Position on the game map
-    int row;           // Vertical position (Y coordinate)
-    int col;           // Horizontal position (X coordinate)
-
-    // State
-    bool isAlive;      // Whether this enemy is currently active
-
-    // Constructor: Initialize a new enemy at specified position
-    Enemy(int h, int a, int r, int c)
-        : health{h}, maxHealth{h}, attack{a},
-          row{r}, col{c}, isAlive{true} {}
-};
-
 // GameState Structure
 // Main container for all game state - this is the single source of truth
 // for the entire game world
 struct GameState {
+    // The world's walls; shared (not copied) by state snapshots
+    std::shared_ptr<TileMap> map;
+
     Player player;           // The player character
-    Enemy enemy;             // The enemy (in future, could be a vector)
+    EnemyStore enemies;      // Every enemy, stored as parallel arrays
     bool isGameRunning;      // Whether the game loop should continue
     int enemiesDefeated;     // Score tracking
 
-    // Map dimensions (const - these don't change during gameplay)
+    // Simulation timing (game time advances in fixed ticks, not wall time)
+    std::uint64_t tick;          // Simulation ticks elapsed
+    int ticksPerSecond;          // Ticks per second of game time
+
+    // Enemy AI: both cover the same window of the world around the player
+    // (all of it when the world is small; moveAIWindow moves it). Enemies
+    // outside the window stand still, and new ones spawn inside it (see
+    // EnemyStore::spawnCells).
+    // Distance to the player from every walkable tile (shared by all chasers)
+    FlowField chaseField;
+    // Routes to any other tile (patrols), cached per goal
+    Pathfinder paths;
+
+    // What the player can see now and has seen before; sight reaches as
+    // far as the default MAP_ROWS x MAP_COLS screen window in any direction
+    FieldOfView sight;
+
+    // Spawn tile draws (set by seedEnemyRandom; part of the state so
+    // snapshots and replays carry it)
+    Rng spawnRng;
+
+    // Timed events (respawns, banners) keyed on simulation ticks
+    EventScheduler events;
+
+    // Messages for the HUD panel (and log file); shared (not copied) by
+    // state snapshots, and written only by the simulation thread
+    std::shared_ptr<EventLog> log;
+    bool showVictoryBanner;      // Victory overlay currently visible
+    // Tick the newest kill's banner is due to come down; hide events
+    // scheduled by earlier kills fire before it and are ignored. Derived
+    // from the pending events, so not hashed or saved.
+    std::uint64_t victoryBannerUntil{0};
+
+    // Persistent movement
+    char heldDirection;          // Last direction pressed ('w'/'a'/'s'/'d', 0 = none)
+    std::uint64_t nextMoveTick;  // Earliest tick the player may step again
+    std::uint64_t nextEnemyMoveTick;  // Earliest tick enemies may step again
+
+    // Live keys applied so far and when the newest was read, so the render
+    // thread can tell when a frame first shows a key's effect (input
+    // latency). Bookkeeping only: not part of replays, hashes or saves.
+    std::uint64_t keysApplied{0};
+    std::chrono::steady_clock::time_point lastKeyTime{};
+
+    // Size of the default world, and of the map window shown on screen
     static constexpr int MAP_ROWS = 20;
     static constexpr int MAP_COLS = 40;
+    static_assert(TileMap::RoomGrid::ROWS == MAP_ROWS && TileMap::RoomGrid::COLS == MAP_COLS,
+                  "the default world should get the fixed-size grid");
+
+    // Largest enemy AI window
+    static constexpr int AI_WINDOW_ROWS = 128;
+    static constexpr int AI_WINDOW_COLS = 128;
 
     // Constructor: Initialize game state with starting values
-    // Parameters: player starting health and attack damage
-    GameState(int playerHealth, int playerAttack)
-        : player{playerHealth, playerAttack, 17, 16},  // Start near bottom-center
-          enemy{50, 1, 5, 30},                          // Spawn near top-right
+    // Parameters: player starting health and attack damage, the most
+    // enemies that may be alive at once (the pool never grows past this),
+    // and the world (nullptr = default MAP_ROWS x MAP_COLS walled room)
+    // Starts with a single enemy; use spawnEnemies() to add more
+    GameState(int playerHealth, int playerAttack,
+              std::size_t enemyCapacity = EnemyStore::DEFAULT_CAPACITY,
+              std::shared_ptr<TileMap> world = nullptr)
+        : map{world ? std::move(world) : std::make_shared<TileMap>(MAP_ROWS, MAP_COLS)},
+          player{playerHealth, playerAttack, 17, 16},  // Start near bottom-center
+          enemies{map->rows(), map->cols(), enemyCapacity},
           isGameRunning{true},
-          enemiesDefeated{0} {}
+          enemiesDefeated{0},
+          tick{0},
+          ticksPerSecond{120},
+          chaseField{std::min(map->rows(), AI_WINDOW_ROWS), std::min(map->cols(), AI_WINDOW_COLS)},
+          paths{std::min(map->rows(), AI_WINDOW_ROWS), std::min(map->cols(), AI_WINDOW_COLS)},
+          sight{MAP_ROWS - 1, MAP_COLS - 1},
+          log{std::make_shared<EventLog>()},
+          showVictoryBanner{false},
+          heldDirection{0},
+          nextMoveTick{0},
+          nextEnemyMoveTick{0} {
+        // Loaded maps may have a wall where the default start is
+        const int SEARCH_RADIUS = 64;
+        map->findWalkableNear(player.row, player.col, SEARCH_RADIUS, player.row, player.col);
+
+        sight.update(*map, player.row, player.col);
+        enemies.spawnCells.setPlayer(player.row, player.col);
+        centerAIWindow();
+        chaseField.setRoot(player.row, player.col);
+
+        // First enemy spawns near top-right
+        int enemyRow = 5;
+        int enemyCol = 30;
+        map->findWalkableNear(enemyRow, enemyCol, SEARCH_RADIUS, enemyRow, enemyCol);
+        enemies.add(EnemyStore::DEFAULT_HEALTH, EnemyStore::DEFAULT_ATTACK, enemyRow, enemyCol);
+    }
+
+    // Move the enemy AI window to be centred on the player (kept inside the
+    // world) and reload its walls from the map
+    void centerAIWindow() {
+        moveAIWindow(player.row - chaseField.rows() / 2, player.col - chaseField.cols() / 2);
+    }
+
+    // Move the enemy AI window's top-left corner to (top, left), kept
+    // inside the world, and reload its walls from the map
+    void moveAIWindow(int top, int left) {
+        top = std::clamp(top, 0, map->rows() - chaseField.rows());
+        left = std::clamp(left, 0, map->cols() - chaseField.cols());
+        auto walkable = [this](int r, int c) { return canMoveTo(*map, r, c); };
+        chaseField.moveWindow(top, left, walkable);
+        paths.moveWindow(top, left, walkable);
+        enemies.spawnCells.setWindow(top, left, chaseField.rows(), chaseField.cols(),
+                                     walkable, enemies.grid);
+    }
 };
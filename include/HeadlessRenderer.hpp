@@ -0,0 +1,51 @@
+#pragma once
+
+// HeadlessRenderer.hpp
+// In-memory render backend: captures frames as cell grids instead of
+// drawing them, so rendering works without a TTY
+
+#include "RenderBackend.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// HeadlessRenderer Class
+// Always keeps the most recent frame. Optionally also records a history of
+// frames (up to a fixed limit) for golden comparisons of whole sequences.
+//
+// Usage:
+//   HeadlessRenderer headless;
+//   printMap(state, headless);
+//   std::string text = HeadlessRenderer::toText(headless.lastFrame());
+//
+class HeadlessRenderer : public RenderBackend {
+public:
+    // Constructor
+    // Parameters:
+    //   - historyLimit: Number of frames to retain (0 = only the last frame)
+    explicit HeadlessRenderer(std::size_t historyLimit = 0);
+
+    void present(const CellGrid& frame) override;
+
+    // Most recently presented frame (empty 0x0 grid before the first one)
+    const CellGrid& lastFrame() const { return last_; }
+
+    // Frames retained so far, oldest first (at most historyLimit)
+    const std::vector<CellGrid>& history() const { return history_; }
+
+    // Total number of frames presented since construction or reset()
+    std::size_t frameCount() const { return frameCount_; }
+
+    // Drop all captured frames and counters
+    void reset();
+
+    // Render a grid as text: one line per row, each ending in '\n'
+    static std::string toText(const CellGrid& frame);
+
+private:
+    CellGrid last_{0, 0};
+    std::vector<CellGrid> history_;
+    std::size_t historyLimit_;
+    std::size_t frameCount_{0};
+};
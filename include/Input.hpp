@@ -3,11 +3,22 @@
 // Input.hpp
 // Non-blocking keyboard input for smooth, real-time gameplay
 // Uses POSIX terminal control (Unix/Linux/Mac)
+//
+// RawInput puts the terminal into raw mode; InputThread then reads it on
+// its own thread, decodes escape sequences (arrow keys) and queues
+// timestamped key events for the simulation to drain every tick.
+
+#include "SpscQueue.hpp"
 
 #include <termios.h>
 #include <unistd.h>
 #include <fcntl.h>
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
 // RawInput Class
 // RAII wrapper for terminal raw mode configuration
 // Automatically restores terminal settings when destroyed
@@ -78,3 +89,126 @@ private:
     termios old_{};     // Original terminal settings
     int oldFlags_{};    // Original file descriptor flags
 };
+
+// Key Codes
+// Plain keys are their ASCII value (0-127). Keys sent as escape sequences
+// get codes from 0x80 up, so every key still fits the one byte a replay
+// log stores per key.
+constexpr int KEY_NONE   = -1;
+constexpr int KEY_ESCAPE = 27;
+constexpr int KEY_UP     = 0x80;
+constexpr int KEY_DOWN   = 0x81;
+constexpr int KEY_RIGHT  = 0x82;
+constexpr int KEY_LEFT   = 0x83;
+
+// InputDecoder Class
+// Turns the bytes a terminal sends into key codes, one byte at a time, so
+// a sequence split across two reads still decodes.
+//   - ESC [ A..D and ESC O A..D (with or without modifier parameters, e.g.
+//     ESC [ 1 ; 5 A for Ctrl+Up) are the arrow keys
+//   - Any other CSI sequence (function keys, Home, End, ...) is swallowed
+//   - ESC followed by a plain key (Alt+key) is that key
+//   - A lone ESC is only known to be the Escape key once nothing follows
+//     it; the reader calls flush() after ESCAPE_TIMEOUT_MS of silence
+//   - Bytes above 127 (UTF-8) are dropped
+//
+// Usage:
+//   InputDecoder decoder;
+//   for (each byte read) {
+//       int key = decoder.feed(byte);
+//       if (key != KEY_NONE) { ... }
+//   }
+//   if (decoder.isPending() && nothing arrived for ESCAPE_TIMEOUT_MS) {
+//       int key = decoder.flush();
+//   }
+//
+class InputDecoder {
+public:
+    // Silence after an ESC before it counts as the Escape key itself
+    static constexpr int ESCAPE_TIMEOUT_MS = 25;
+
+    // Add one byte
+    // Returns: the key it completes, or KEY_NONE if it completes none yet
+    int feed(unsigned char byte);
+
+    // End an unfinished sequence (nothing more is coming)
+    // Returns: KEY_ESCAPE for a lone ESC, otherwise KEY_NONE
+    int flush();
+
+    // True while in the middle of an escape sequence
+    bool isPending() const { return state_ != State::Ground; }
+
+private:
+    enum class State : std::uint8_t {
+        Ground,   // Between keys
+        Escape,   // Seen ESC
+        Csi,      // Seen ESC [ (parameters may follow)
+        Ss3,      // Seen ESC O
+    };
+
+    State state_{State::Ground};
+};
+
+// Key press read by the input thread
+struct InputEvent {
+    int key{KEY_NONE};                              // Key code (see Key Codes)
+    std::chrono::steady_clock::time_point time{};   // When it was read
+};
+
+// Input statistics for one game session
+struct InputStats {
+    std::uint64_t keysRead = 0;         // Key events decoded
+    std::uint64_t keysDropped = 0;      // Lost because the queue was full
+    std::uint64_t latencySamples = 0;   // Frames that showed a new key
+    double meanLatencyMs = 0.0;         // Key read -> frame drawn, average
+    double maxLatencyMs = 0.0;          // ... and worst case
+};
+
+// InputThread Class
+// Reads a terminal (or any file descriptor) on a dedicated thread that
+// sleeps in poll() until bytes arrive, so a key is picked up the moment
+// it is typed rather than at the next frame, and any number of keys per
+// frame get through. Decoded keys are stamped with the time they were read
+// and pushed into a lock-free queue; the simulation drains it.
+//
+// Usage:
+//   RawInput raw;                 // Terminal in raw mode first
+//   InputThread input;            // Reads stdin until destroyed
+//   InputEvent event;
+//   while (input.pop(event)) { handleInput(state, event.key); }
+//
+class InputThread {
+public:
+    // Keys that may wait between two simulation ticks
+    static constexpr std::size_t QUEUE_CAPACITY = 256;
+
+    // Constructor: Start reading fd (it is not closed afterwards)
+    explicit InputThread(int fd = STDIN_FILENO);
+
+    // Destructor: Wake the thread and wait for it to finish
+    ~InputThread();
+
+    InputThread(const InputThread&) = delete;
+    InputThread& operator=(const InputThread&) = delete;
+
+    // Take the oldest key not handled yet (simulation thread only)
+    // Returns: false if there is none
+    bool pop(InputEvent& out) { return queue_.tryPop(out); }
+
+    // Keys decoded and keys lost to a full queue so far
+    std::uint64_t keysRead() const { return keysRead_.load(std::memory_order_relaxed); }
+    std::uint64_t keysDropped() const { return keysDropped_.load(std::memory_order_relaxed); }
+
+private:
+    void run();
+    void push(int key, std::chrono::steady_clock::time_point time);
+
+    int fd_;
+    int wakeRead_{-1};                        // Self-pipe: written to stop run()
+    int wakeWrite_{-1};
+    std::atomic<bool> stopping_{false};
+    std::atomic<std::uint64_t> keysRead_{0};
+    std::atomic<std::uint64_t> keysDropped_{0};
+    SpscQueue<InputEvent, QUEUE_CAPACITY> queue_;
+    std::thread thread_;                      // Reader (started once the pipe exists)
+};
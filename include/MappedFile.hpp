@@ -0,0 +1,61 @@
+#pragma once
+
+// MappedFile.hpp
+// Read-only memory-mapped file (POSIX mmap)
+// Lets large binary files be read in place without copying them into memory
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// MappedFile Class
+// RAII wrapper around open + mmap. The mapping is released when the object
+// is destroyed. Pages are loaded lazily by the OS as they are touched.
+//
+// Usage:
+//   MappedFile file{"session.rpl"};
+//   if (!file.isOpen()) { ... file.error() ... }
+//   const std::uint8_t* bytes = file.data();
+//
+class MappedFile {
+public:
+    // Constructor: No file (isOpen() is false)
+    MappedFile() = default;
+
+    // Constructor: Map the whole file read-only
+    // On failure isOpen() is false and error() describes why
+    explicit MappedFile(const std::string& path);
+
+    // Destructor: Unmap the file
+    ~MappedFile();
+
+    bool isOpen() const { return opened_; }
+    const std::string& error() const { return error_; }
+
+    const std::uint8_t* data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+    // Hint that the file will be read front to back
+    void adviseSequential() const;
+
+    // Hint that the file will be read in scattered small pieces
+    void adviseRandom() const;
+
+    // Let the OS reclaim the pages fully inside [offset, offset + length)
+    // They are read back from the file if touched again
+    void dropPages(std::size_t offset, std::size_t length) const;
+
+    // Move-only (owns the mapping)
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+private:
+    void release();
+
+    const std::uint8_t* data_{nullptr};  // Start of the mapping
+    std::size_t size_{0};                // File size in bytes
+    bool opened_{false};                 // File opened (may be empty)
+    std::string error_;                  // Reason for failure
+};
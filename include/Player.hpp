@@ -5,10 +5,15 @@
 // Player-related functions: movement, combat, leveling, healing
 // ============================================================================
 
+#include <cstddef>
+
 // Forward declarations to avoid circular includes
 struct Player;
-struct Enemy;
+struct EnemyStore;
 struct GameState;
+struct CombatResult;
+class EventLog;
+class TileMap;
 
 // ----------------------------------------------------------------------------
 // Movement Functions
@@ -17,15 +22,17 @@ struct GameState;
 // Move the player in the specified direction
 // Parameters:
 //   - player: Reference to player to move
+//   - map: World the player walks in
 //   - direction: 'w' (up), 'a' (left), 's' (down), 'd' (right)
-// Includes boundary checking to prevent walking through walls
-void movePlayer(Player& player, char direction);
+// Includes wall checking to prevent walking through walls
+void movePlayer(Player& player, const TileMap& map, char direction);
 
 // Check if the player can move to a specific position
 // Parameters:
+//   - map: World to check against
 //   - row, col: Target position to check
-// Returns: true if position is within valid game bounds
-bool canMoveTo(int row, int col);
+// Returns: true if position is a floor tile inside the map
+bool canMoveTo(const TileMap& map, int row, int col);
 
 // ----------------------------------------------------------------------------
 // Combat Functions
@@ -34,9 +41,22 @@ bool canMoveTo(int row, int col);
 // Player attacks an enemy, dealing damage
 // Parameters:
 //   - player: The attacking player
-//   - enemy: The enemy being attacked
+//   - enemies: Enemy storage
+//   - index: The enemy being attacked
+//   - log: Receives the combat messages
 // Side effects: Reduces enemy health, may trigger enemy death
-void attackEnemy(Player& player, Enemy& enemy);
+void attackEnemy(Player& player, EnemyStore& enemies, std::size_t index, EventLog& log);
+
+// Apply the outcome of a batched combat round (see CombatKernel.hpp)
+// Parameters:
+//   - player: The player who fought
+//   - enemies: Enemy storage the round was resolved against
+//   - result: Output of resolveCombat for this round
+//   - log: Receives the combat messages
+// Side effects: Marks killed enemies dead, applies counter-attack damage,
+//               grants experience, then writes the combat log in one go
+void applyCombatResult(Player& player, EnemyStore& enemies, const CombatResult& result,
+                       EventLog& log);
 
 // Check if player is alive
 // Returns: true if player health > 0
@@ -44,10 +64,13 @@ bool isPlayerAlive(const Player& player);
 
 // Handle enemy attacking the player (counter-attack)
 // Parameters:
-//   - enemy: The attacking enemy
+//   - enemies: Enemy storage
+//   - index: The attacking enemy
 //   - player: The player being attacked
+//   - log: Receives the combat message
 // Side effects: Reduces player health
-void enemyAttacksPlayer(const Enemy& enemy, Player& player);
+void enemyAttacksPlayer(const EnemyStore& enemies, std::size_t index, Player& player,
+                        EventLog& log);
 
 // ----------------------------------------------------------------------------
 // Progression Functions
@@ -55,21 +78,26 @@ void enemyAttacksPlayer(const Enemy& enemy, Player& player);
 
 // Increase player's level and improve stats
 // Called when player gains enough experience
+// Parameters:
+//   - player: Player to level up
+//   - log: Receives the level-up message
 // Side effects: Increments level, increases max health and attack
-void levelUpPlayer(Player& player);
+void levelUpPlayer(Player& player, EventLog& log);
 
 // Restore some or all of the player's health
 // Parameters:
 //   - player: Player to heal
 //   - amount: Health points to restore (capped at maxHealth)
-void healPlayer(Player& player, int amount);
+//   - log: Receives the healing message (if any health was restored)
+void healPlayer(Player& player, int amount, EventLog& log);
 
 // Grant experience points to the player
 // Parameters:
 //   - player: Player receiving experience
 //   - amount: Experience points to grant
+//   - log: Receives the experience (and any level-up) messages
 // Side effects: May trigger level up if threshold reached
-void grantExperience(Player& player, int amount);
+void grantExperience(Player& player, int amount, EventLog& log);
 
 // Calculate experience needed for next level
 // Returns: Experience points required (increases with level)
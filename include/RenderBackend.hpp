@@ -0,0 +1,33 @@
+#pragma once
+
+// RenderBackend.hpp
+// Output device interface for composed frames
+
+#include "CellGrid.hpp"
+
+// RenderBackend Interface
+// The renderer composes every screen (map, game over, victory) into a
+// CellGrid and hands it to a backend. Backends decide what "display" means:
+//   - TerminalRenderer: diffs against the screen and writes to stdout
+//   - HeadlessRenderer: keeps frames in memory for benchmarks and batch runs
+class RenderBackend {
+public:
+    virtual ~RenderBackend() = default;
+
+    // Display a fully composed frame
+    // Parameters:
+    //   - frame: Frame to show (backends copy what they need to keep)
+    virtual void present(const CellGrid& frame) = 0;
+
+    // Forget any cached knowledge of what is displayed
+    // Default: nothing cached, nothing to do
+    virtual void invalidate() {}
+
+    // Frame size that fills the device (e.g. the terminal window)
+    // Returns: false if any size will do (the renderer picks its default)
+    virtual bool preferredSize(int& rows, int& cols) {
+        (void)rows;
+        (void)cols;
+        return false;
+    }
+};
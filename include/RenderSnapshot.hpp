@@ -0,0 +1,77 @@
+#pragma once
+
+// RenderSnapshot.hpp
+// Everything one frame of the map screen shows, captured from the game state
+// The simulation hands this - not the whole GameState - to the render
+// thread, so what is copied each frame is bounded by the screen's size:
+// the enemy arrays, AI caches, spawn tiles and map stay behind.
+
+#include "TileGrid.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class EventLog;
+
+// What the player knows of one tile in view
+enum class TileSight : std::uint8_t {
+    Unseen,      // Never in sight (drawn blank)
+    Remembered,  // Seen before, out of sight now (drawn dimmed)
+    Visible,     // In sight now
+};
+
+// A tile of the view, relative to its top-left corner
+struct ViewCell {
+    int row;
+    int col;
+};
+
+// RenderSnapshot Structure
+// The camera's window over the world at capture time, with the tiles,
+// sight and enemies inside it, plus the scalars the HUD prints. Filled by
+// captureRenderSnapshot (Renderer.hpp); buffers are reused between
+// captures, so a snapshot that is written every frame stops allocating
+// once the view size settles.
+struct RenderSnapshot {
+    // View window in world tiles
+    int top = 0;
+    int left = 0;
+    int rows = 0;
+    int cols = 0;
+
+    // Per view tile: floor or wall, and how much of it the player knows
+    TileGrid<> tiles{0, 0};
+    std::vector<TileSight> sight;   // Row-major, rows * cols
+
+    // Tiles in view and in sight holding at least one enemy
+    std::vector<ViewCell> enemies;
+
+    // Player (world position) and stats
+    int playerRow = 0;
+    int playerCol = 0;
+    int health = 0;
+    int maxHealth = 0;
+    int attack = 0;
+    int level = 0;
+    int experience = 0;
+
+    // Game
+    int enemiesDefeated = 0;
+    std::size_t enemiesAlive = 0;
+    bool showVictoryBanner = false;
+
+    // Nearest enemy in sight, for the HUD's enemy line
+    bool hasNearestEnemy = false;
+    int nearestHealth = 0;
+    int nearestMaxHealth = 0;
+
+    // Message panel (shared with the simulation, which keeps writing it)
+    std::shared_ptr<const EventLog> log;
+
+    // Input latency bookkeeping, copied from GameState
+    std::uint64_t keysApplied = 0;
+    std::chrono::steady_clock::time_point lastKeyTime{};
+};
@@ -2,21 +2,65 @@
 
 // Renderer.hpp
 // Screen rendering and display functions
+// Every screen is composed into a CellGrid and shown through a RenderBackend;
+// the overloads without a backend draw to the terminal.
 
 // Forward declarations
 struct GameState;
+struct RenderSnapshot;
+class Camera;
+class CellGrid;
+class RenderBackend;
 
-// Display Functions
+// Frame Composition
+
+// Default frame dimensions (map plus HUD below it), used when the backend
+// has no size of its own; the terminal's frames match its window instead
+int frameRows();
+int frameCols();
+
+// Map window a backend's frames have room for (the frame less the HUD)
+void mapViewSize(RenderBackend& backend, int& rows, int& cols);
 
-// Render the complete game map with all entities
+// Capture what the map screen shows of the game state
+// Parameters:
+//   - state: Current game state
+//   - camera: Sized to the map window; scrolls to follow the player
+//   - out: Receives the view (its buffers are reused)
+// Cost depends on the view size only; this is what the simulation hands to
+// the render thread
+void captureRenderSnapshot(const GameState& state, Camera& camera, RenderSnapshot& out);
+
+// Draw a captured view and its HUD into a frame
 // Displays:
 //   - Map boundaries (walls)
 //   - Player position
-//   - Enemy position (if alive)
+//   - Enemy positions (in sight)
+//   - Tiles out of sight: dimmed if remembered, blank if never seen
+//   - The victory banner while it is up
 //   - Player stats (health, attack, level, etc.)
+//   - The newest messages from the event log
+// Parameters:
+//   - snapshot: What to show (captureRenderSnapshot); its view is drawn
+//     from the frame's top-left corner, cut to the frame if that has
+//     become smaller since the capture
+//   - frame: Destination grid; the HUD (stats, controls and messages)
+//     follows right below the view
+// Cost depends on the view size only, not on the world's size
+void composeMap(const RenderSnapshot& snapshot, CellGrid& frame);
+
+// Display Functions
+
+// Render the complete game map through a backend
 // Parameters:
 //   - state: Current game state to render
+//   - backend: Output device (defaults to the terminal)
+void printMap(const GameState& state, RenderBackend& backend);
 void printMap(const GameState& state);
+void printMap(const RenderSnapshot& snapshot, RenderBackend& backend);
+
+// The shared terminal backend used by the overloads without a backend
+RenderBackend& terminalBackend();
 
 // Clear the terminal screen (platform-specific)
 // Improves visual feedback by preventing screen scrolling
@@ -26,7 +70,6 @@ void clearScreen();
 // Shows final stats and score
 // Parameters:
 //   - state: Final game state
+//   - backend: Output device (defaults to the terminal)
+void displayGameOver(const GameState& state, RenderBackend& backend);
 void displayGameOver(const GameState& state);
-
-// Display a victory message when enemy is defeated
-void displayVictory();
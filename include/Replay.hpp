@@ -0,0 +1,122 @@
+#pragma once
+
+// Replay.hpp
+// Deterministic input recording and replay
+//
+// A replay log stores every key the simulation consumed, tagged with the
+// tick it was applied on, plus the enemy RNG seed. Feeding the same keys on
+// the same ticks into a freshly seeded GameState reproduces the session
+// exactly, which the final state hash in the footer verifies. The starting
+// enemy count is stored too, since extra enemies are spawned from the seed.
+//
+// File layout (little-endian):
+//   Header:  "DCRP" | u16 version | u16 reserved | u32 seed | u32 ticksPerSecond
+//            | u32 enemyCount
+//   Records: varint tickDelta | u8 key          (key != 0)
+//   Footer:  varint tickDelta | u8 0 | u64 finalTick | u64 stateHash
+// tickDelta is relative to the previous record, so held-key sessions cost
+// about two bytes per key press.
+
+#include "MappedFile.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Forward declarations
+struct GameState;
+
+// Hash every field of the game state that the simulation depends on
+// Two states with equal hashes are (with overwhelming probability) identical
+std::uint64_t hashGameState(const GameState& state);
+
+// A single recorded key press
+struct ReplayEvent {
+    std::uint64_t tick;  // Simulation tick the key was applied on
+    int key;             // Key code (never 0)
+};
+
+// ReplayRecorder Class
+// Appends key events to a replay file through a small in-memory buffer
+class ReplayRecorder {
+public:
+    // Constructor: Create the file and write the header
+    // Parameters:
+    //   - path: Output file (truncated)
+    //   - seed: Enemy RNG seed used for this session
+    //   - ticksPerSecond: Simulation rate of the session
+    //   - enemyCount: Enemies in the world when the session starts
+    ReplayRecorder(const std::string& path, std::uint32_t seed, int ticksPerSecond,
+                   std::size_t enemyCount);
+
+    // Destructor: Flushes buffered records (the footer is written by finish)
+    ~ReplayRecorder();
+
+    bool isOpen() const { return out_.is_open() && out_.good(); }
+
+    // Append a key event (ticks must be non-decreasing)
+    void record(std::uint64_t tick, int key);
+
+    // Write the footer with the final state and close the file
+    void finish(const GameState& finalState);
+
+    ReplayRecorder(const ReplayRecorder&) = delete;
+    ReplayRecorder& operator=(const ReplayRecorder&) = delete;
+
+private:
+    void appendVarint(std::uint64_t value);
+    void flushBuffer();
+
+    std::ofstream out_;
+    std::vector<std::uint8_t> buffer_;  // Pending bytes (flushed when large)
+    std::uint64_t lastTick_{0};
+    bool finished_{false};
+};
+
+// ReplayReader Class
+// Streams events out of a memory-mapped replay file without copying it
+//
+// Usage:
+//   ReplayReader reader{"session.rpl"};
+//   ReplayEvent event;
+//   while (reader.next(event)) { ... }
+//   reader.finalTick(); reader.stateHash();   // valid once next() returns false
+//
+class ReplayReader {
+public:
+    // Constructor: Map the file and validate the header
+    explicit ReplayReader(const std::string& path);
+
+    // False if the file is missing, truncated or not a replay
+    bool isValid() const { return error_.empty(); }
+    const std::string& error() const { return error_; }
+
+    std::uint32_t seed() const { return seed_; }
+    int ticksPerSecond() const { return ticksPerSecond_; }
+    std::size_t enemyCount() const { return enemyCount_; }
+
+    // Read the next key event
+    // Returns: false at the footer (or on corruption - check isValid())
+    bool next(ReplayEvent& event);
+
+    // Footer values (valid after next() returned false and isValid())
+    bool hasFooter() const { return hasFooter_; }
+    std::uint64_t finalTick() const { return finalTick_; }
+    std::uint64_t stateHash() const { return stateHash_; }
+
+private:
+    bool readVarint(std::uint64_t& value);
+    bool readU64(std::uint64_t& value);
+
+    MappedFile file_;
+    std::size_t pos_{0};
+    std::string error_;
+    std::uint32_t seed_{0};
+    int ticksPerSecond_{0};
+    std::size_t enemyCount_{0};
+    std::uint64_t lastTick_{0};
+    bool hasFooter_{false};
+    std::uint64_t finalTick_{0};
+    std::uint64_t stateHash_{0};
+};
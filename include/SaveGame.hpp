@@ -0,0 +1,210 @@
+#pragma once
+
+// SaveGame.hpp
+// Binary save files: write a game to disk, resume it later
+//
+// A save holds the player, every enemy slot, the score, pending timed events
+// and the spawn RNG and tiles - enough that a resumed game carries on as the
+// saved one would have, except that sentries re-plan their patrol routes
+// (cached routes are not saved, and a sentry waits a tick or two for its
+// route). It is stored as raw little-endian arrays, each on an
+// 8-byte boundary, so loading is a size check and one memcpy per array
+// straight out of the memory-mapped file, with nothing to parse.
+//
+// File layout (little-endian):
+//   Header:   SaveHeader (magic "DCSV", version, counts, player, scalars)
+//   Sections: i32 health[n] | i32 maxHealth[n] | i32 attack[n] | i32 row[n]
+//             | i32 col[n] | u8 alive[n] | u32 generation[n] | u32 freeSlots[f]
+//             | {u64 tick, u64 sequence, u32 type, i32 payload} events[e]
+//             | u32 spawnOrder[s]
+//   Each section starts on an 8-byte boundary (zero padding in between).
+//
+// Not saved: tiles seen earlier (the map starts unexplored again) and the
+// walls, which come from the map the game is resumed on - it must be the
+// same size as the one it was saved on.
+
+#include "EventScheduler.hpp"
+#include "GameState.hpp"
+#include "MappedFile.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// SaveSnapshot Structure
+// Everything a save file holds, copied out of a GameState. Plain values and
+// arrays, so it can be written out on another thread while the game goes
+// on, and its vectors are reused (no allocation once they have grown).
+//
+// The first capture into a snapshot copies every enemy slot, about 25 bytes
+// each: ~5 ms at 1M enemies. Capturing into the same snapshot again
+// recopies only the slots written since it was last filled, so the cost
+// follows how many enemies moved, fought or respawned rather than how many
+// exist. The free list, pending events and spawn order are always copied
+// whole.
+struct SaveSnapshot {
+    int mapRows{0};                 // Size of the world it was saved on
+    int mapCols{0};
+
+    Player player{0, 0, 0, 0};
+    int enemiesDefeated{0};
+    std::uint64_t tick{0};
+    int ticksPerSecond{0};
+    bool showVictoryBanner{false};
+    char heldDirection{0};
+    std::uint64_t nextMoveTick{0};
+    std::uint64_t nextEnemyMoveTick{0};
+    std::uint64_t spawnRng[4]{};
+    int aiWindowTop{0};             // Enemy AI window's top-left corner
+    int aiWindowLeft{0};
+
+    // Enemy pool: every slot ever used, as in EnemyStore
+    std::size_t enemyCapacity{0};
+    std::size_t enemyHighWater{0};
+    std::vector<int> health;
+    std::vector<int> maxHealth;
+    std::vector<int> attack;
+    std::vector<int> row;
+    std::vector<int> col;
+    std::vector<std::uint8_t> alive;
+    std::vector<std::uint32_t> generation;
+    std::vector<std::uint32_t> freeSlots;
+
+    // Store and change epoch the slot arrays were copied at, so the next
+    // capture into this snapshot can recopy only what changed since
+    // (EnemyStore::changes())
+    std::uint64_t enemySource{0};
+    std::uint32_t enemyEpoch{0};
+
+    // Pending timed events
+    std::vector<TimedEvent> events;
+    std::uint64_t nextEventSequence{0};
+
+    // Where the next enemies appear: the no-spawn zone's centre (which
+    // trails the player between spawns) and the order of the eligible
+    // tiles (SpawnSet::order)
+    int spawnZoneRow{0};
+    int spawnZoneCol{0};
+    std::vector<std::uint32_t> spawnOrder;
+};
+
+// Copy the saved parts of a game state into a snapshot
+// Reuses the snapshot's vectors, so repeated captures do not allocate
+void captureSave(const GameState& state, SaveSnapshot& out);
+
+// Write a snapshot to a save file
+// The file is written under a temporary name and renamed over path, so a
+// crash mid-save leaves the previous save intact
+// Returns: false (with error set) if the file cannot be written
+bool writeSave(const SaveSnapshot& snapshot, const std::string& path, std::string& error);
+
+// Capture and write in one go (on the calling thread)
+bool saveGame(const GameState& state, const std::string& path, std::string& error);
+
+// SaveReader Class
+// Maps a save file and checks it is complete; restore() then loads it into
+// a game state built on the same map.
+//
+// Usage:
+//   SaveReader save{"game.sav"};
+//   if (!save.isValid()) { ... save.error() ... }
+//   GameState state{100, 2, save.enemyCapacity(), world};
+//   if (!save.restore(state)) { ... save.error() ... }
+//
+class SaveReader {
+public:
+    // Constructor: Map the file and validate the header (including the
+    // spawn zone, AI window and tick rate), the section sizes, the live
+    // enemies' positions, the free list and the event types
+    explicit SaveReader(const std::string& path);
+
+    // False if the file is missing, truncated, corrupt or not a save
+    bool isValid() const { return error_.empty(); }
+    const std::string& error() const { return error_; }
+
+    // Enemy pool size the game was saved with (build the state with it),
+    // capped to the larger of the slots saved and the default pool
+    std::size_t enemyCapacity() const { return enemyCapacity_; }
+
+    // Replace the state's player, enemies, score, events and RNG with the
+    // saved ones, then rebuild what derives from them (sight, spawn tiles,
+    // the enemy AI window)
+    // Returns: false (with error set) if the state's map or enemy pool does
+    //          not fit the save (including a live enemy on one of the
+    //          map's walls); the state is unchanged then
+    bool restore(GameState& state);
+
+private:
+    MappedFile file_;
+    std::string error_;
+    std::size_t enemyCapacity_{0};
+};
+
+// AutoSaver Class
+// Saves the game every intervalTicks simulation ticks without the game loop
+// ever waiting on the disk. The simulation thread only captures a snapshot;
+// a background thread writes it. If a save is still being written when the
+// next is due, the newer snapshot simply replaces any that has not been
+// started yet.
+//
+// The capture is not free. The two snapshots (one being written, one being
+// filled) are refilled in place, so the first two saves copy every enemy
+// slot (~5 ms at 1M enemies). Later ones recopy only the slots written over
+// the last two intervals: ~0.5 ms at 1M enemies when a thousand of them
+// moved, as in a game where only the enemies near the player act.
+//
+// Usage:
+//   AutoSaver autosave{"game.sav", 30 * state.ticksPerSecond};
+//   autosave.onTick(state);    // After every tick
+//   autosave.saveNow(state);   // On quit
+//
+class AutoSaver {
+public:
+    // Constructor: Start the writer thread (the first save is due
+    // intervalTicks after the first onTick)
+    AutoSaver(std::string path, std::uint64_t intervalTicks);
+
+    // Destructor: Same as finish()
+    ~AutoSaver();
+
+    AutoSaver(const AutoSaver&) = delete;
+    AutoSaver& operator=(const AutoSaver&) = delete;
+
+    // Capture a snapshot if a save is due (simulation thread)
+    void onTick(const GameState& state);
+
+    // Capture a snapshot now (simulation thread)
+    void saveNow(const GameState& state);
+
+    // Write the newest snapshot, if not written yet, and stop the thread
+    // (no saves are made after this)
+    void finish();
+
+    // Saves written, and the reason the last failed one failed (empty if
+    // none has)
+    std::uint64_t savesWritten() const;
+    std::string lastError() const;
+
+private:
+    void run();
+
+    std::string path_;
+    std::uint64_t intervalTicks_;
+    std::uint64_t nextSaveTick_{0};
+    bool armed_{false};            // nextSaveTick_ set (first onTick seen)
+
+    mutable std::mutex mutex_;     // Guards everything below except writing_
+    std::condition_variable wake_;
+    SaveSnapshot pending_;         // Newest capture, not yet being written
+    bool hasPending_{false};
+    bool stopping_{false};
+    std::uint64_t savesWritten_{0};
+    std::string lastError_;
+
+    SaveSnapshot writing_;         // Writer thread only
+    std::thread thread_;           // Declared last: starts after everything above
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+// SimClock.hpp
+// Fixed-timestep simulation clock
+// Converts elapsed wall time into a whole number of simulation ticks so game
+// timing is independent of how long rendering or the OS scheduler takes
+
+#include <chrono>
+#include <cstdint>
+
+// Clock configuration
+struct SimClockConfig {
+    int ticksPerSecond = 120;   // Simulation rate
+    int maxTicksPerFrame = 8;   // Catch-up limit: ticks run per advance() at most
+};
+
+// Timing statistics collected while the clock runs
+struct SimClockStats {
+    std::uint64_t ticks = 0;         // Ticks handed out in total
+    std::uint64_t lateTicks = 0;     // Ticks run after their scheduled time
+    std::uint64_t droppedTicks = 0;  // Ticks discarded by the catch-up limit
+};
+
+// SimClock Class
+// Accumulator-based fixed timestep:
+//   accumulator += elapsed wall time
+//   ticks = accumulator / tickDuration (capped at maxTicksPerFrame)
+// Any backlog beyond the cap is dropped (and counted) rather than replayed,
+// so a long stall does not cause a burst of fast-forwarded gameplay.
+//
+// Usage:
+//   SimClock clock{config};
+//   clock.start(now);
+//   while (running) {
+//       int n = clock.advance(SimClock::clock::now());
+//       for (int i = 0; i < n; ++i) tick();
+//       render();
+//       std::this_thread::sleep_until(clock.nextTickTime());
+//   }
+//
+class SimClock {
+public:
+    using clock = std::chrono::steady_clock;
+
+    // Constructor: Configure the tick rate and catch-up limit
+    explicit SimClock(const SimClockConfig& config = {});
+
+    // Begin measuring from the given time (accumulator starts empty)
+    void start(clock::time_point now);
+
+    // Add the wall time elapsed since the last call to the accumulator
+    // Returns: number of simulation ticks to run now (0..maxTicksPerFrame)
+    int advance(clock::time_point now);
+
+    // Wall time at which the next tick becomes due
+    clock::time_point nextTickTime() const;
+
+    // Length of one simulation tick
+    clock::duration tickDuration() const { return tickDuration_; }
+
+    const SimClockStats& stats() const { return stats_; }
+
+private:
+    clock::duration tickDuration_;
+    int maxTicksPerFrame_;
+    clock::time_point last_{};
+    clock::duration accumulator_{0};
+    SimClockStats stats_;
+};
@@ -0,0 +1,135 @@
+#pragma once
+
+// SlotChanges.hpp
+// Which enemy slots were written since an earlier copy of the enemy arrays
+// Lets a copy that is taken over and over (the autosave's snapshot) be
+// refreshed by recopying just those slots instead of all of them.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// SlotChanges Class
+// Time is split into epochs, and a copy is taken at the end of one
+// (endEpoch()). Each slot is logged the first time it is written in an
+// epoch, and the logs of the last KEPT_EPOCHS epochs are kept, so a copy
+// taken at the end of one of them can be refreshed from the logs. Older
+// copies, copies of another log, and copies from before markAll() have to
+// be retaken in full.
+//
+// Every log has its own id, and a copied or moved log gets a new one:
+// a copy records the id it was taken from, so it is never refreshed from a
+// log whose history it does not share.
+//
+// Usage:
+//   changes.grow(slots);          // When the arrays grow
+//   changes.mark(slot);           // After writing slot in any array
+//   bool fresh = copy.source == changes.id() &&
+//                changes.forEachSince(copy.epoch, [&](std::size_t slot) { ... });
+//   copy.epoch = changes.endEpoch();
+//
+class SlotChanges {
+public:
+    // Epochs whose logs are kept (a copy may be this many captures old)
+    static constexpr std::uint32_t KEPT_EPOCHS = 4;
+
+    SlotChanges() : id_{nextId()} {}
+
+    SlotChanges(const SlotChanges& other)
+        : id_{nextId()}, epoch_{other.epoch_}, resetEpoch_{other.epoch_},
+          slotEpoch_(other.slotEpoch_.size(), 0) {}
+
+    SlotChanges& operator=(const SlotChanges& other) {
+        if (this != &other) {
+            *this = SlotChanges{other};
+        }
+        return *this;
+    }
+
+    SlotChanges(SlotChanges&& other) noexcept
+        : id_{nextId()}, epoch_{other.epoch_}, resetEpoch_{other.epoch_},
+          slotEpoch_(std::move(other.slotEpoch_)) {
+        other.id_ = nextId();
+    }
+
+    SlotChanges& operator=(SlotChanges&& other) noexcept {
+        id_ = nextId();
+        epoch_ = other.epoch_;
+        resetEpoch_ = other.epoch_;
+        slotEpoch_ = std::move(other.slotEpoch_);
+        for (std::vector<std::uint32_t>& log : logs_) {
+            log.clear();
+        }
+        other.id_ = nextId();
+        return *this;
+    }
+
+    // Identity of this history (copies record it)
+    std::uint64_t id() const { return id_; }
+
+    void reserve(std::size_t slots) { slotEpoch_.reserve(slots); }
+
+    // Track slots [0, slots) (new slots start unlogged; mark them)
+    void grow(std::size_t slots) {
+        if (slots > slotEpoch_.size()) {
+            slotEpoch_.resize(slots, 0);
+        }
+    }
+
+    // Slot was written
+    void mark(std::size_t slot) {
+        if (slotEpoch_[slot] != epoch_) {
+            slotEpoch_[slot] = epoch_;
+            logs_[epoch_ % KEPT_EPOCHS].push_back(static_cast<std::uint32_t>(slot));
+        }
+    }
+
+    // Every slot may have changed (arrays refilled or cut short); earlier
+    // copies are retaken in full
+    void markAll(std::size_t slots) {
+        slotEpoch_.assign(slots, 0);
+        resetEpoch_ = epoch_;
+        for (std::vector<std::uint32_t>& log : logs_) {
+            log.clear();
+        }
+    }
+
+    // End the current epoch (a copy was just taken)
+    // Returns: the epoch that ended - what the copy records
+    std::uint32_t endEpoch() {
+        const std::uint32_t ended = epoch_++;
+        logs_[epoch_ % KEPT_EPOCHS].clear();
+        return ended;
+    }
+
+    // Call fn(slot) for every slot written after the copy taken at the end
+    // of epoch since (a slot may come up more than once)
+    // Returns: false, without calling fn, if the logs do not reach back
+    //          that far
+    template <typename Fn>
+    bool forEachSince(std::uint32_t since, Fn&& fn) const {
+        if (since < resetEpoch_ || since >= epoch_ || epoch_ - since > KEPT_EPOCHS) {
+            return false;
+        }
+        for (std::uint32_t e = since + 1; e <= epoch_; ++e) {
+            for (std::uint32_t slot : logs_[e % KEPT_EPOCHS]) {
+                fn(slot);
+            }
+        }
+        return true;
+    }
+
+private:
+    static std::uint64_t nextId() {
+        static std::atomic<std::uint64_t> next{1};
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::uint64_t id_;
+    std::uint32_t epoch_{1};                    // Writes now are logged under this
+    std::uint32_t resetEpoch_{1};               // Copies from before this are stale
+    std::vector<std::uint32_t> slotEpoch_;      // Per slot: last epoch it was logged in
+    std::vector<std::uint32_t> logs_[KEPT_EPOCHS];  // Slots logged, by epoch % KEPT_EPOCHS
+};
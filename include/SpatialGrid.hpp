@@ -0,0 +1,174 @@
+#pragma once
+
+// SpatialGrid.hpp
+// Uniform-grid spatial index over the tile map
+// Answers "who is on this tile" and "who is near this tile" without scanning
+// every entity
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// SpatialGrid Class
+// One bucket per map tile. Each bucket is an intrusive doubly linked list
+// threaded through per-entity next/prev arrays, so insert, remove and move
+// are O(1) and need no allocation once the entity arrays are sized.
+//
+// Buckets exist only where entities are: they are kept per CHUNK_SIZE x
+// CHUNK_SIZE chunk, taken from a pool when the first entity enters a chunk
+// and given back when the last one leaves. The whole world costs a 4-byte
+// directory entry per chunk; each occupied chunk adds 8 KB. Memory (and
+// the cost of copying the grid) follows the area entities occupy rather
+// than the world's size.
+//
+// Usage:
+//   SpatialGrid grid{rows, cols};
+//   grid.insert(id, row, col);
+//   grid.move(id, row, col, newRow, newCol);
+//   grid.forEachAt(row, col, [](std::uint32_t id) { ... });
+//
+class SpatialGrid {
+public:
+    static constexpr std::uint32_t NONE = 0xFFFFFFFFu;
+
+    // Side of the square areas buckets are allocated for, in tiles
+    static constexpr int CHUNK_SIZE = 32;
+    static constexpr int CHUNK_TILES = CHUNK_SIZE * CHUNK_SIZE;
+
+    // Constructor: Create an empty index for a rows x cols map
+    SpatialGrid(int rows, int cols);
+
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+
+    // Check if a tile is inside the indexed area
+    bool contains(int row, int col) const {
+        return row >= 0 && row < rows_ && col >= 0 && col < cols_;
+    }
+
+    // Incremental Updates
+    // Positions outside the map are ignored (the entity is simply not indexed)
+
+    // Add an entity at a tile (id must not already be indexed)
+    void insert(std::uint32_t id, int row, int col);
+
+    // Remove an entity from the tile it was inserted at
+    void remove(std::uint32_t id, int row, int col);
+
+    // Move an entity between tiles (no-op if the tile is unchanged)
+    void move(std::uint32_t id, int oldRow, int oldCol, int newRow, int newCol);
+
+    // Remove every entity
+    void clear();
+
+    // Pre-size the per-entity arrays for ids [0, count) so later inserts
+    // never allocate
+    void reserveEntities(std::size_t count);
+
+    // Queries
+
+    // Number of entities on a tile (0 outside the map)
+    std::uint32_t countAt(int row, int col) const {
+        if (!contains(row, col)) {
+            return 0;
+        }
+        const Chunk* chunk = chunkAt(row, col);
+        return chunk ? chunk->count[tileIndex(row, col)] : 0;
+    }
+
+    // Call fn(id) for every entity on a tile
+    // fn may remove the entity it is given, but no others
+    template <typename Fn>
+    void forEachAt(int row, int col, Fn&& fn) const {
+        if (!contains(row, col)) {
+            return;
+        }
+        const Chunk* chunk = chunkAt(row, col);
+        if (!chunk) {
+            return;
+        }
+        std::uint32_t id = chunk->head[tileIndex(row, col)];
+        while (id != NONE) {
+            std::uint32_t following = next_[id];
+            fn(id);
+            id = following;
+        }
+    }
+
+    // Call fn(id) for every entity within Euclidean distance `radius`
+    // Cost is proportional to the tiles in the radius, not the entity count
+    template <typename Fn>
+    void forEachInRadius(int row, int col, int radius, Fn&& fn) const {
+        const int radiusSq = radius * radius;
+        for (int dr = -radius; dr <= radius; ++dr) {
+            for (int dc = -radius; dc <= radius; ++dc) {
+                if (dr * dr + dc * dc <= radiusSq) {
+                    forEachAt(row + dr, col + dc, fn);
+                }
+            }
+        }
+    }
+
+    // Call fn(id) for every entity on the 8 tiles surrounding (row, col)
+    template <typename Fn>
+    void forEachNeighbor(int row, int col, Fn&& fn) const {
+        for (int dr = -1; dr <= 1; ++dr) {
+            for (int dc = -1; dc <= 1; ++dc) {
+                if (dr != 0 || dc != 0) {
+                    forEachAt(row + dr, col + dc, fn);
+                }
+            }
+        }
+    }
+
+    // Number of entities within Euclidean distance `radius`
+    std::size_t countInRadius(int row, int col, int radius) const;
+
+    // Chunks holding at least one entity
+    std::size_t occupiedChunks() const { return chunks_.size() - freeChunks_.size(); }
+
+    // Bytes held by the index (directory, bucket pool and entity links)
+    std::size_t memoryBytes() const;
+
+private:
+    // Buckets of one chunk
+    struct Chunk {
+        std::array<std::uint32_t, CHUNK_TILES> head;   // First entity on each tile
+        std::array<std::uint32_t, CHUNK_TILES> count;  // Entities on each tile
+        std::uint32_t population;                      // Entities in the chunk
+        std::uint32_t id;                              // Directory index
+    };
+
+    // Position of a tile's chunk in the directory, and of the tile in its
+    // chunk (the tile must be inside the map)
+    std::size_t chunkIndex(int row, int col) const {
+        return static_cast<std::size_t>(static_cast<unsigned>(row) / CHUNK_SIZE) * chunkCols_ +
+               static_cast<unsigned>(col) / CHUNK_SIZE;
+    }
+    static std::size_t tileIndex(int row, int col) {
+        return (static_cast<unsigned>(row) % CHUNK_SIZE) * CHUNK_SIZE +
+               static_cast<unsigned>(col) % CHUNK_SIZE;
+    }
+
+    // Buckets of the chunk holding a tile, or nullptr if it has no entities
+    const Chunk* chunkAt(int row, int col) const {
+        const std::uint32_t slot = directory_[chunkIndex(row, col)];
+        return slot != NONE ? &chunks_[slot] : nullptr;
+    }
+
+    // Same, taking empty buckets from the pool if needed
+    Chunk& occupyChunk(int row, int col);
+
+    // Grow the per-entity link arrays to cover id
+    void ensureEntity(std::uint32_t id);
+
+    int rows_;
+    int cols_;
+    int chunkCols_;
+    std::vector<std::uint32_t> directory_;   // Pool slot of every chunk (NONE = no entities)
+    std::vector<Chunk> chunks_;              // Bucket pool
+    std::vector<std::uint32_t> freeChunks_;  // Pool slots not in use (their buckets are empty)
+    std::vector<std::uint32_t> next_;        // Next entity on the same tile
+    std::vector<std::uint32_t> prev_;        // Previous entity on the same tile
+};
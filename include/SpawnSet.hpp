@@ -0,0 +1,161 @@
+#pragma once
+
+// SpawnSet.hpp
+// The tiles an enemy may spawn on right now, kept up to date as the player
+// and enemies move so a spawn never has to search or retry
+
+#include "Random.hpp"
+#include "SpatialGrid.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// SpawnSet Class
+// A tile is eligible when it is floor, no enemy stands on it, and it is at
+// least MIN_SPAWN_DISTANCE from the player (compared as squared integer
+// distances). Eligible tiles sit in a dense array with a back-index per
+// tile, so adding, removing and uniform sampling are all O(1).
+//
+// Like the AI, the set covers a window of the world (the whole world when
+// it is small), given in world coordinates.
+//
+// Usage:
+//   SpawnSet spawns;
+//   spawns.setPlayer(player.row, player.col);
+//   spawns.setWindow(0, 0, rows, cols, isWalkable, enemies.grid);
+//   if (spawns.sample(rng, row, col)) { ... spawn at (row, col) ... }
+//
+class SpawnSet {
+public:
+    // Enemies never appear closer than this to the player (in tiles)
+    static constexpr int MIN_SPAWN_DISTANCE = 8;
+
+    // Constructor: Empty window (nothing is eligible until setWindow)
+    SpawnSet() = default;
+
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+    int originRow() const { return originRow_; }
+    int originCol() const { return originCol_; }
+
+    // Centre of the no-spawn zone (as of the last setPlayer)
+    int playerRow() const { return playerRow_; }
+    int playerCol() const { return playerCol_; }
+
+    bool contains(int row, int col) const {
+        return row >= originRow_ && row < originRow_ + rows_ &&
+               col >= originCol_ && col < originCol_ + cols_;
+    }
+
+    // Updates
+
+    // Cover a new window and rebuild it from scratch
+    // Parameters:
+    //   - isWalkable: Callable (int row, int col) -> bool, world coordinates
+    //   - occupancy: Where enemies currently stand
+    template <typename Walkable>
+    void setWindow(int originRow, int originCol, int rows, int cols,
+                   Walkable&& isWalkable, const SpatialGrid& occupancy) {
+        originRow_ = originRow;
+        originCol_ = originCol;
+        rows_ = rows;
+        cols_ = cols;
+        const std::size_t size = static_cast<std::size_t>(rows) * cols;
+        flags_.assign(size, 0);
+        slot_.assign(size, NONE);
+        cells_.clear();
+        cells_.reserve(size);
+
+        for (int r = originRow; r < originRow + rows; ++r) {
+            for (int c = originCol; c < originCol + cols; ++c) {
+                std::uint8_t flags = 0;
+                flags |= isWalkable(r, c) ? WALKABLE : 0;
+                flags |= occupancy.countAt(r, c) > 0 ? OCCUPIED : 0;
+                flags |= hasPlayer_ && nearPlayer(r, c) ? NEAR_PLAYER : 0;
+                const std::size_t cell = cellIndex(r, c);
+                flags_[cell] = flags;
+                if (flags == WALKABLE) {
+                    insert(cell);
+                }
+            }
+        }
+    }
+
+    // Move the player's no-spawn zone (no-op if the player has not moved)
+    // Cost is proportional to the zone's area, however far the player went
+    void setPlayer(int row, int col);
+
+    // Record whether any enemy stands on a tile
+    void setOccupied(int row, int col, bool occupied) {
+        if (contains(row, col)) {
+            setFlag(cellIndex(row, col), OCCUPIED, occupied);
+        }
+    }
+
+    // Queries
+
+    // Number of eligible tiles
+    std::size_t size() const { return cells_.size(); }
+    bool empty() const { return cells_.empty(); }
+
+    bool isEligible(int row, int col) const {
+        return contains(row, col) && flags_[cellIndex(row, col)] == WALKABLE;
+    }
+
+    // Eligible tiles (as window cell indices) in the order sample() indexes
+    // them; the order depends on the set's history, so snapshots keep it
+    const std::vector<std::uint32_t>& order() const { return cells_; }
+
+    // Put the eligible tiles back in a saved order()
+    // Returns: false (and changes nothing) if cells is not exactly the
+    //          current set of eligible tiles
+    bool restoreOrder(const std::uint32_t* cells, std::size_t count);
+
+    // Pick an eligible tile uniformly at random
+    // Returns: false if there is none
+    bool sample(Rng& rng, int& row, int& col) const {
+        if (cells_.empty()) {
+            return false;
+        }
+        const std::uint32_t cell = cells_[rng.below(static_cast<std::uint32_t>(cells_.size()))];
+        row = originRow_ + static_cast<int>(cell / cols_);
+        col = originCol_ + static_cast<int>(cell % cols_);
+        return true;
+    }
+
+private:
+    static constexpr std::uint32_t NONE = 0xFFFFFFFFu;
+
+    // Per-tile state; a tile is eligible when its flags are exactly WALKABLE
+    enum : std::uint8_t { WALKABLE = 1, NEAR_PLAYER = 2, OCCUPIED = 4 };
+
+    std::size_t cellIndex(int row, int col) const {
+        return static_cast<std::size_t>(row - originRow_) * cols_ + (col - originCol_);
+    }
+
+    bool nearPlayer(int row, int col) const {
+        const int dRow = row - playerRow_;
+        const int dCol = col - playerCol_;
+        return dRow * dRow + dCol * dCol < MIN_SPAWN_DISTANCE * MIN_SPAWN_DISTANCE;
+    }
+
+    // Set or clear one flag, moving the tile in or out of the dense array
+    void setFlag(std::size_t cell, std::uint8_t flag, bool on);
+
+    void insert(std::size_t cell);
+    void erase(std::size_t cell);
+
+    int originRow_{0};
+    int originCol_{0};
+    int rows_{0};
+    int cols_{0};
+
+    bool hasPlayer_{false};
+    int playerRow_{0};
+    int playerCol_{0};
+
+    std::vector<std::uint8_t> flags_;   // Per tile
+    std::vector<std::uint32_t> slot_;   // Tile -> position in cells_ (NONE if absent)
+    std::vector<std::uint32_t> cells_;  // Eligible tiles, in no particular order
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+// SpscQueue.hpp
+// Lock-free single-producer / single-consumer FIFO of fixed capacity
+// Used to pass input events from the input thread to the simulation
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// SpscQueue Class
+// Ring buffer of CAPACITY slots (a power of two). The producer owns the
+// tail, the consumer the head; each only reads the other's index, so
+// neither ever waits for the other. Each side also keeps a cached copy of
+// the other's index and re-reads the shared one only when the cache says
+// the queue looks full (producer) or empty (consumer), so most operations
+// touch no shared cache line but their own.
+//
+// Usage:
+//   Producer: if (!queue.tryPush(value)) { ... full: drop or retry ... }
+//   Consumer: while (queue.tryPop(value)) { use(value); }
+//
+template <typename T, std::size_t CAPACITY>
+class SpscQueue {
+    static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0,
+                  "capacity must be a power of two");
+
+public:
+    // Producer Side
+
+    // Append a value
+    // Returns: false (and drops nothing) if the queue is full
+    bool tryPush(const T& value) {
+        const std::uint64_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - headCache_ == CAPACITY) {
+            headCache_ = head_.load(std::memory_order_acquire);
+            if (tail - headCache_ == CAPACITY) {
+                return false;
+            }
+        }
+        slots_[tail & (CAPACITY - 1)] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer Side
+
+    // Take the oldest value
+    // Returns: false if the queue is empty
+    bool tryPop(T& out) {
+        const std::uint64_t head = head_.load(std::memory_order_relaxed);
+        if (head == tailCache_) {
+            tailCache_ = tail_.load(std::memory_order_acquire);
+            if (head == tailCache_) {
+                return false;
+            }
+        }
+        out = slots_[head & (CAPACITY - 1)];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Either Side
+
+    // Values waiting (a snapshot; may be stale by the time it is used)
+    std::size_t size() const {
+        return static_cast<std::size_t>(tail_.load(std::memory_order_acquire) -
+                                        head_.load(std::memory_order_acquire));
+    }
+
+    static constexpr std::size_t capacity() { return CAPACITY; }
+
+private:
+    // Producer and consumer state on separate cache lines so they do not
+    // bounce a line between cores on every operation
+    alignas(64) std::atomic<std::uint64_t> tail_{0};  // Next slot to write
+    std::uint64_t headCache_{0};                      // Producer's view of head_
+    alignas(64) std::atomic<std::uint64_t> head_{0};  // Next slot to read
+    std::uint64_t tailCache_{0};                      // Consumer's view of tail_
+    alignas(64) std::array<T, CAPACITY> slots_{};
+};
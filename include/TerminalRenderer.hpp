@@ -0,0 +1,85 @@
+#pragma once
+
+// TerminalRenderer.hpp
+// Flicker-free terminal output: diffs each new frame against what is already
+// on screen and sends only the changed cells
+
+#include "CellGrid.hpp"
+#include "RenderBackend.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+// TerminalRenderer Class
+// Keeps a front buffer mirroring the terminal contents. Each present() call
+// compares the new (back) frame against it, emits cursor-positioning escapes
+// plus the changed characters into a preallocated output buffer, and flushes
+// the whole frame with a single write() to stdout.
+//
+// The terminal's size is read with TIOCGWINSZ, and read again (with a full
+// redraw) after the window is resized (SIGWINCH).
+//
+// Usage:
+//   TerminalRenderer term{rows, cols};
+//   CellGrid frame{rows, cols};
+//   ... draw into frame ...
+//   term.present(frame);   // Only changed cells are written
+//
+class TerminalRenderer : public RenderBackend {
+public:
+    // Constructor: Size the front buffer and output buffer for a frame
+    // Parameters:
+    //   - rows, cols: Expected frame dimensions in cells
+    TerminalRenderer(int rows, int cols);
+
+    // Destructor: Show the cursor again if we hid it
+    ~TerminalRenderer() override;
+
+    // Send the differences between the frame and the screen to the terminal
+    // Parameters:
+    //   - frame: Fully composed frame (a size change forces a full redraw)
+    // Side effects: Updates the front buffer, writes to stdout
+    // Calls from different threads are serialized
+    void present(const CellGrid& frame) override;
+
+    // Forget what is on screen so the next present() redraws everything
+    // Call after anything else writes to the terminal (e.g. clearScreen)
+    // Safe to call from a thread other than the one presenting
+    void invalidate() override;
+
+    // Terminal size, less the bottom line where the cursor is parked
+    // Returns: false if stdout is not a terminal
+    bool preferredSize(int& rows, int& cols) override;
+
+    // Statistics for the most recent present() call
+    std::size_t lastFrameBytes() const { return lastFrameBytes_; }
+    int lastFrameCellsChanged() const { return lastFrameCells_; }
+
+    // Disable copying (mirrors a unique terminal)
+    TerminalRenderer(const TerminalRenderer&) = delete;
+    TerminalRenderer& operator=(const TerminalRenderer&) = delete;
+
+private:
+    void resize(int rows, int cols);
+    void appendBytes(const char* data, std::size_t n);
+    void appendCells(const CellGrid& frame, int row, int begin, int end);
+    void appendMoveCursor(int row, int col);
+    void flush();
+
+    std::mutex presentMutex_;  // One frame on the wire at a time
+    CellGrid front_;           // What the terminal currently shows
+    std::vector<char> out_;    // Preallocated output buffer for one frame
+    std::size_t outSize_{0};   // Bytes queued in out_
+    std::size_t flushedBytes_{0};  // Bytes of this frame already written early
+    std::atomic<bool> fullRedraw_{true};  // Screen contents unknown - repaint all
+    bool cursorHidden_{false}; // Whether we sent the hide-cursor escape
+    CellStyle pen_{CellStyle::Normal};  // Style the terminal draws in (Normal between frames)
+
+    int terminalRows_{0};      // Size last read from the terminal (0 = unknown)
+    int terminalCols_{0};
+
+    std::size_t lastFrameBytes_{0};
+    int lastFrameCells_{0};
+};
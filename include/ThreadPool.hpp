@@ -0,0 +1,99 @@
+#pragma once
+
+// ThreadPool.hpp
+// Fixed set of worker threads that run data-parallel loops with work stealing
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ThreadPool Class
+// parallelFor() splits [0, count) into chunks and deals them out evenly to
+// one queue per participant (every worker plus the calling thread). Each
+// participant pops chunks from the front of its own queue; once that runs
+// dry it steals from the back of someone else's, so a participant that got
+// slow chunks (or was descheduled) does not hold up the whole loop.
+//
+// Chunks are independent: the loop body must not depend on the order in
+// which chunks run. Callers that need a deterministic result write per-item
+// outputs and merge them afterwards.
+//
+// Usage:
+//   ThreadPool pool{8};
+//   pool.parallelFor(items.size(), 1024, [&](std::size_t begin, std::size_t end) {
+//       for (std::size_t i = begin; i < end; ++i) process(i);
+//   });
+//
+class ThreadPool {
+public:
+    using RangeFn = std::function<void(std::size_t begin, std::size_t end)>;
+
+    // Constructor: Start the workers
+    // Parameters:
+    //   - threads: Total threads that run a loop, including the caller
+    //              (0 = one per hardware thread; 1 = no workers at all)
+    explicit ThreadPool(unsigned threads = 0);
+
+    // Destructor: Stop and join every worker
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Threads taking part in each loop (workers + the calling thread)
+    unsigned threadCount() const { return static_cast<unsigned>(queues_.size()); }
+
+    // Run fn over [0, count) in chunks of at most chunkSize and wait for it
+    // Parameters:
+    //   - count: Number of items
+    //   - chunkSize: Items per chunk (0 is treated as 1)
+    //   - fn: Called once per chunk with a half-open item range
+    // Not reentrant: call from one thread at a time, never from inside fn
+    void parallelFor(std::size_t count, std::size_t chunkSize, const RangeFn& fn);
+
+    // Chunks taken from another participant's queue since construction
+    std::uint64_t stealCount() const { return steals_.load(std::memory_order_relaxed); }
+
+private:
+    // Half-open item range
+    struct Chunk {
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    // One participant's chunks (mutex-guarded; contention only while stealing)
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Chunk> chunks;
+    };
+
+    void workerLoop(unsigned self);
+
+    // Drain own queue, then steal until every queue is empty
+    void runChunks(unsigned self);
+
+    bool popOwn(unsigned self, Chunk& out);
+    bool steal(unsigned self, Chunk& out);
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_;  // [0] = calling thread
+    std::vector<std::thread> workers_;
+
+    // Current loop, published to workers by bumping generation_
+    const RangeFn* job_{nullptr};
+    std::uint64_t generation_{0};
+    unsigned busyWorkers_{0};
+    bool stopping_{false};
+
+    std::mutex stateMutex_;
+    std::condition_variable wake_;   // Workers wait here for a new loop
+    std::condition_variable done_;   // Caller waits here for workers to finish
+
+    std::atomic<std::uint64_t> steals_{0};
+};
@@ -0,0 +1,169 @@
+#pragma once
+
+// TileGrid.hpp
+// Whole-map walkability grid, one byte per tile, with its dimensions either
+// fixed at compile time or chosen at run time
+// Fixed sizes let the compiler fold every bounds check and row stride into
+// constants and fully unroll loops over the map; the runtime-sized grid
+// serves maps whose size is only known once they are loaded.
+
+#include "CellGrid.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Extent marking a dimension that is only known at run time
+inline constexpr int DYNAMIC_EXTENT = -1;
+
+// TileGrid Class
+// Row-major tiles (1 = floor, 0 = wall); tiles outside the grid are walls.
+// TileGrid<Rows, Cols> stores its tiles inline; TileGrid<> sizes them in
+// the constructor. Both have the same interface, so code templated on the
+// grid type works with either.
+//
+// Usage:
+//   TileGrid<20, 40> room;             // Fixed size, tiles inline
+//   TileGrid<> loaded{rows, cols};     // Size known at run time
+//   room.fill([](int r, int c) { return r > 0 && c > 0 && r < 19 && c < 39; });
+//   if (room.isWalkable(row, col)) { ... }
+//
+template <int Rows = DYNAMIC_EXTENT, int Cols = DYNAMIC_EXTENT>
+class TileGrid {
+    static_assert(Rows > 0 && Cols > 0, "fixed grids need positive dimensions");
+
+public:
+    static constexpr int ROWS = Rows;
+    static constexpr int COLS = Cols;
+
+    static constexpr int rows() { return Rows; }
+    static constexpr int cols() { return Cols; }
+
+    static constexpr bool contains(int row, int col) {
+        return row >= 0 && row < Rows && col >= 0 && col < Cols;
+    }
+
+    bool isWalkable(int row, int col) const {
+        return contains(row, col) && tiles_[index(row, col)];
+    }
+
+    void setWalkable(int row, int col, bool walkable) {
+        if (contains(row, col)) {
+            tiles_[index(row, col)] = walkable ? 1 : 0;
+        }
+    }
+
+    // Set every tile from a callable (int row, int col) -> bool
+    template <typename Walkable>
+    void fill(Walkable&& isWalkable) {
+        for (int r = 0; r < Rows; ++r) {
+            for (int c = 0; c < Cols; ++c) {
+                tiles_[index(r, c)] = isWalkable(r, c) ? 1 : 0;
+            }
+        }
+    }
+
+    // Pointer to the first tile of a row (cols() tiles long)
+    const std::uint8_t* rowData(int row) const { return tiles_.data() + index(row, 0); }
+    std::uint8_t* rowData(int row) { return tiles_.data() + index(row, 0); }
+
+private:
+    static constexpr std::size_t index(int row, int col) {
+        return static_cast<std::size_t>(row) * Cols + col;
+    }
+
+    std::array<std::uint8_t, static_cast<std::size_t>(Rows) * Cols> tiles_{};
+};
+
+// Runtime-sized grid (the fallback for any map size)
+template <>
+class TileGrid<DYNAMIC_EXTENT, DYNAMIC_EXTENT> {
+public:
+    static constexpr int ROWS = DYNAMIC_EXTENT;
+    static constexpr int COLS = DYNAMIC_EXTENT;
+
+    // Constructor: rows x cols grid of walls
+    TileGrid(int rows, int cols)
+        : rows_{rows}, cols_{cols},
+          tiles_(static_cast<std::size_t>(rows) * cols, 0) {}
+
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+
+    bool contains(int row, int col) const {
+        return row >= 0 && row < rows_ && col >= 0 && col < cols_;
+    }
+
+    bool isWalkable(int row, int col) const {
+        return contains(row, col) && tiles_[index(row, col)];
+    }
+
+    void setWalkable(int row, int col, bool walkable) {
+        if (contains(row, col)) {
+            tiles_[index(row, col)] = walkable ? 1 : 0;
+        }
+    }
+
+    template <typename Walkable>
+    void fill(Walkable&& isWalkable) {
+        for (int r = 0; r < rows_; ++r) {
+            for (int c = 0; c < cols_; ++c) {
+                tiles_[index(r, c)] = isWalkable(r, c) ? 1 : 0;
+            }
+        }
+    }
+
+    const std::uint8_t* rowData(int row) const { return tiles_.data() + index(row, 0); }
+    std::uint8_t* rowData(int row) { return tiles_.data() + index(row, 0); }
+
+private:
+    std::size_t index(int row, int col) const {
+        return static_cast<std::size_t>(row) * cols_ + col;
+    }
+
+    int rows_;
+    int cols_;
+    std::vector<std::uint8_t> tiles_;
+};
+
+// Rendering
+
+// Draw a ViewRows x ViewCols window of a grid into the top-left corner of a
+// frame ('.' floor, '#' wall), clipped to the grid
+// With a fixed-size grid every loop bound is a constant, so the copy is
+// unrolled and vectorised; the runtime grid takes the same loop with
+// runtime bounds.
+// Parameters:
+//   - top, left: Grid tile drawn at frame cell (0, 0)
+//   - frame: At least ViewRows x ViewCols cells
+template <int ViewRows, int ViewCols, typename Grid>
+void drawTileWindow(const Grid& grid, int top, int left, CellGrid& frame) {
+    const int rows = std::min(ViewRows, grid.rows() - top);
+    const int cols = std::min(ViewCols, grid.cols() - left);
+    for (int r = 0; r < rows; ++r) {
+        const std::uint8_t* in = grid.rowData(top + r) + left;
+        char* out = frame.rowData(r);
+        for (int c = 0; c < cols; ++c) {
+            // Arithmetic rather than a lookup table, so it vectorises
+            out[c] = static_cast<char>('#' + in[c] * ('.' - '#'));
+        }
+    }
+}
+
+// Same, for a window whose size is only known at runtime (e.g. it follows
+// the terminal's size)
+template <typename Grid>
+void drawTileWindow(const Grid& grid, int top, int left, int viewRows, int viewCols,
+                    CellGrid& frame) {
+    const int rows = std::min(viewRows, grid.rows() - top);
+    const int cols = std::min(viewCols, grid.cols() - left);
+    for (int r = 0; r < rows; ++r) {
+        const std::uint8_t* in = grid.rowData(top + r) + left;
+        char* out = frame.rowData(r);
+        for (int c = 0; c < cols; ++c) {
+            out[c] = static_cast<char>('#' + in[c] * ('.' - '#'));
+        }
+    }
+}
@@ -0,0 +1,232 @@
+#pragma once
+
+// TileMap.hpp
+// The world's walls and floors, stored in fixed-size bit-packed chunks
+// Chunks are loaded on first use (from a memory-mapped map file, or
+// generated) and evicted again once the player is far away, so a world of
+// millions of tiles opens instantly and only the visited area takes memory
+
+#include "MappedFile.hpp"
+#include "TileGrid.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+// TileMap Class
+// Each chunk covers CHUNK_SIZE x CHUNK_SIZE tiles, one bit per tile
+// (1 = floor, 0 = wall): 128 bytes per chunk.
+//
+// Map file layout (little-endian):
+//   "DCMP" | u16 version | u16 chunk size | u32 rows | u32 cols
+//   chunks in row-major chunk order, each CHUNK_WORDS u64 words,
+//   bit (r % CHUNK_SIZE) * CHUNK_SIZE + (c % CHUNK_SIZE) for tile (r, c)
+// Tiles past the map edge in the last chunk row/column are walls.
+//
+// Small worlds (up to FLAT_MAX_TILES) skip chunking: the whole map is
+// held in a TileGrid, fixed-size for the default room and runtime-sized
+// otherwise, and looked up with no locking or chunk search.
+//
+// Lookups are thread-safe, and lookups in resident chunks take no lock: a
+// table with a pointer per chunk is read directly, and checked again after
+// the read in case the chunk was evicted meanwhile (then the lookup
+// retries). The mutex is held only to load, edit or evict chunks. Chunks
+// edited with setWalkable() are never evicted, since the file cannot take
+// the edit.
+// Flat worlds are read without the lock, so edit those only while no
+// other thread is reading the map.
+//
+// Usage:
+//   TileMap map{"world.map"};
+//   if (!map.isValid()) { ... map.error() ... }
+//   if (map.isWalkable(row, col)) { ... }
+//   map.evictOutside(player.row, player.col, 4);
+//
+class TileMap {
+public:
+    static constexpr int CHUNK_SIZE = 32;
+    static constexpr int CHUNK_WORDS = CHUNK_SIZE * CHUNK_SIZE / 64;
+
+    // Largest world held whole instead of in chunks
+    static constexpr std::size_t FLAT_MAX_TILES = std::size_t{1} << 16;
+
+    // Whole-world grids: the default room, and any other small world
+    using RoomGrid = TileGrid<20, 40>;
+    using FlatGrid = TileGrid<>;
+
+    // Constructor: rows x cols room with a wall around the edge (generated)
+    TileMap(int rows, int cols);
+
+    // Constructor: Open a map file; chunks are read on first use
+    // On failure isValid() is false and error() describes why
+    explicit TileMap(const std::string& path);
+
+    TileMap(const TileMap&) = delete;
+    TileMap& operator=(const TileMap&) = delete;
+
+    bool isValid() const { return error_.empty(); }
+    const std::string& error() const { return error_; }
+
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+
+    bool contains(int row, int col) const {
+        return row >= 0 && row < rows_ && col >= 0 && col < cols_;
+    }
+
+    // Tiles
+
+    // Floor tile inside the map (loads its chunk if needed)
+    bool isWalkable(int row, int col) const {
+        if (const RoomGrid* room = std::get_if<RoomGrid>(&flat_)) {
+            return room->isWalkable(row, col);
+        }
+        if (const FlatGrid* grid = std::get_if<FlatGrid>(&flat_)) {
+            return grid->isWalkable(row, col);
+        }
+        return chunkIsWalkable(row, col);
+    }
+
+    // Turn a tile into floor or wall (pins its chunk in memory)
+    void setWalkable(int row, int col, bool walkable);
+
+    // Walkable tile closest to (row, col), searching square rings outward
+    // Parameters:
+    //   - maxRadius: Largest ring to try
+    // Returns: true and the tile in outRow/outCol if one was found
+    bool findWalkableNear(int row, int col, int maxRadius, int& outRow, int& outCol) const;
+
+    // Call fn(grid) with the whole-world grid of a flat world, so the
+    // caller's code is compiled for that grid type
+    // Returns: false (fn not called) if the world is chunked
+    template <typename Fn>
+    bool visitFlat(Fn&& fn) const {
+        if (const RoomGrid* room = std::get_if<RoomGrid>(&flat_)) {
+            fn(*room);
+            return true;
+        }
+        if (const FlatGrid* grid = std::get_if<FlatGrid>(&flat_)) {
+            fn(*grid);
+            return true;
+        }
+        return false;
+    }
+
+    // Residency
+
+    // Drop every unedited chunk more than radiusChunks chunks away
+    // Cheap to call every tick: returns at once unless the centre chunk
+    // changed or chunks were loaded since the last call
+    // Returns: Number of chunks evicted
+    std::size_t evictOutside(int row, int col, int radiusChunks);
+
+    // Chunks currently in memory
+    std::size_t residentChunks() const;
+
+    // Chunks read from the file or generated since construction
+    std::uint64_t chunkLoads() const;
+
+    // Map Files
+
+    // Write a map file for a rows x cols world
+    // Parameters:
+    //   - isWalkable: Called once per tile, chunk by chunk
+    // Returns: true on success (else error holds the reason)
+    static bool writeFile(const std::string& path, int rows, int cols,
+                          const std::function<bool(int, int)>& isWalkable,
+                          std::string& error);
+
+private:
+    static constexpr std::uint16_t VERSION = 1;
+    static constexpr std::size_t HEADER_SIZE = 16;
+    static constexpr std::size_t CHUNK_BYTES = CHUNK_WORDS * 8;
+
+    using ChunkBits = std::array<std::uint64_t, CHUNK_WORDS>;
+
+    // Bit of a tile inside its chunk
+    static int bitIndex(int row, int col) {
+        return (row % CHUNK_SIZE) * CHUNK_SIZE + (col % CHUNK_SIZE);
+    }
+
+    std::uint32_t chunkId(int row, int col) const {
+        return static_cast<std::uint32_t>((row / CHUNK_SIZE) * chunkCols_ + col / CHUNK_SIZE);
+    }
+
+    // Resident chunk for an id, loading it first if needed (mutex held)
+    ChunkBits& residentChunk(std::uint32_t id) const;
+
+    // A word of a chunk that lock-free lookups may be reading
+    static std::uint64_t loadWord(const std::uint64_t& word) {
+        return std::atomic_ref<std::uint64_t>{const_cast<std::uint64_t&>(word)}.load(
+            std::memory_order_relaxed);
+    }
+    static void storeWord(std::uint64_t& word, std::uint64_t value) {
+        std::atomic_ref<std::uint64_t>{word}.store(value, std::memory_order_relaxed);
+    }
+
+    // Fill a chunk from the file, or generate the edge-walled room
+    void loadChunk(std::uint32_t id, ChunkBits& bits) const;
+
+    // Chunked lookup: lock-free if the chunk is resident (see the class
+    // comment), else it is loaded under the lock
+    bool chunkIsWalkable(int row, int col) const {
+        if (!contains(row, col)) {
+            return false;
+        }
+        const std::uint32_t id = chunkId(row, col);
+        const int bit = bitIndex(row, col);
+        const ChunkBits* bits = resident_[id].load(std::memory_order_acquire);
+        while (bits) {
+            const std::uint64_t word = loadWord((*bits)[bit / 64]);
+            // Still this chunk's slot after the read: the word is its own
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const ChunkBits* again = resident_[id].load(std::memory_order_relaxed);
+            if (again == bits) {
+                return (word >> (bit % 64)) & 1;
+            }
+            bits = again;
+        }
+        return loadAndTest(id, bit);
+    }
+
+    // Load a chunk and read one of its bits (takes the lock)
+    bool loadAndTest(std::uint32_t id, int bit) const;
+
+    // Hold a small world whole: fill a grid from every chunk
+    template <typename Grid>
+    void loadFlat(Grid& grid) const;
+
+    int rows_{0};
+    int cols_{0};
+    int chunkRows_{0};
+    int chunkCols_{0};
+    MappedFile file_;     // Closed for generated maps
+    std::string error_;
+    std::variant<std::monostate, RoomGrid, FlatGrid> flat_;  // Empty when chunked
+
+    // Resident chunk by id (nullptr = not loaded); read without the lock,
+    // written with it held
+    std::unique_ptr<std::atomic<const ChunkBits*>[]> resident_;
+
+    mutable std::mutex mutex_;                                         // Loading, editing, evicting
+    mutable std::unordered_map<std::uint32_t, std::uint32_t> slotOf_;  // Chunk id -> slot
+    mutable std::deque<ChunkBits> slots_;                              // Chunk data (never moves)
+    mutable std::vector<std::uint32_t> slotChunk_;                     // Slot -> chunk id
+    mutable std::vector<std::uint8_t> slotPinned_;                     // Edited, keep
+    mutable std::vector<std::uint32_t> freeSlots_;
+    mutable std::uint64_t loads_{0};
+
+    // Arguments and load count of the last evictOutside() that ran
+    std::uint32_t lastEvictChunk_{0xFFFFFFFFu};
+    int lastEvictRadius_{-1};
+    std::uint64_t loadsAtLastEvict_{0};
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+// TripleBuffer.hpp
+// Lock-free single-producer / single-consumer handoff of the latest value
+// Used to pass game state snapshots from the simulation to the renderer
+
+#include <atomic>
+#include <cstdint>
+
+// TripleBuffer Class
+// Three slots rotate between the producer (write slot), the consumer (read
+// slot) and a shared middle slot. publish() swaps the write slot into the
+// middle; acquire() swaps the middle into the read slot. Neither side ever
+// blocks the other, and when the consumer falls behind, older unread values
+// are simply overwritten (dropped) so it always sees the newest one.
+//
+// Usage:
+//   Producer: buffer.writeBuffer() = state; buffer.publish();
+//   Consumer: if (buffer.acquire()) use(buffer.readBuffer());
+//
+template <typename T>
+class TripleBuffer {
+public:
+    // Constructor: Every slot starts as a copy of the initial value
+    explicit TripleBuffer(const T& initial)
+        : slots_{initial, initial, initial} {}
+
+    // Producer Side
+
+    // Slot the producer may freely modify before publishing
+    T& writeBuffer() { return slots_[write_]; }
+
+    // Make the write slot the newest value and take back an unused slot
+    // Counts a dropped frame if the previous value was never acquired
+    void publish() {
+        std::uint8_t prev = middle_.exchange(
+            static_cast<std::uint8_t>(write_ | FRESH_BIT), std::memory_order_acq_rel);
+        write_ = prev & INDEX_MASK;
+        if (prev & FRESH_BIT) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+        sequence_.fetch_add(1, std::memory_order_release);
+        sequence_.notify_one();
+    }
+
+    // Wake a consumer blocked in waitForPublish() without new data
+    // Used to shut the consumer down
+    void close() {
+        closed_.store(true, std::memory_order_release);
+        sequence_.fetch_add(1, std::memory_order_release);
+        sequence_.notify_one();
+    }
+
+    // Consumer Side
+
+    // Swap in the newest published value if there is one
+    // Returns: true if readBuffer() now holds a value not seen before
+    bool acquire() {
+        if (!(middle_.load(std::memory_order_relaxed) & FRESH_BIT)) {
+            return false;
+        }
+        std::uint8_t prev = middle_.exchange(read_, std::memory_order_acq_rel);
+        read_ = prev & INDEX_MASK;
+        return true;
+    }
+
+    // Slot holding the most recently acquired value
+    const T& readBuffer() const { return slots_[read_]; }
+
+    // Block until something has been published after the given sequence
+    // Returns: the current sequence number (pass it back in next time)
+    std::uint64_t waitForPublish(std::uint64_t seen) const {
+        sequence_.wait(seen, std::memory_order_acquire);
+        return sequence_.load(std::memory_order_acquire);
+    }
+
+    bool isClosed() const { return closed_.load(std::memory_order_acquire); }
+
+    // Number of published values overwritten before the consumer saw them
+    std::uint64_t droppedCount() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    // Disable copying (slots are shared between two threads)
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+private:
+    static constexpr std::uint8_t INDEX_MASK = 0x3;
+    static constexpr std::uint8_t FRESH_BIT = 0x4;
+
+    T slots_[3];
+    std::uint8_t write_{0};                    // Owned by the producer
+    std::uint8_t read_{1};                     // Owned by the consumer
+    std::atomic<std::uint8_t> middle_{2};      // Shared slot index + fresh bit
+    std::atomic<std::uint64_t> sequence_{0};   // Bumped on every publish
+    std::atomic<std::uint64_t> dropped_{0};    // Frames never rendered
+    std::atomic<bool> closed_{false};          // Producer has finished
+};
@@ -0,0 +1,42 @@
+#include "Camera.hpp"
+
+#include <algorithm>
+
+// View Size
+
+void Camera::resize(int rows, int cols) {
+    rows = std::max(1, rows);
+    cols = std::max(1, cols);
+    if (placed_ && rows == viewRows_ && cols == viewCols_) {
+        return;
+    }
+    viewRows_ = rows;
+    viewCols_ = cols;
+    rows_ = viewRows_;
+    cols_ = viewCols_;
+    placed_ = false;
+}
+
+// Scrolling
+
+void Camera::follow(int row, int col, int worldRows, int worldCols) {
+    rows_ = std::min(viewRows_, worldRows);
+    cols_ = std::min(viewCols_, worldCols);
+    top_ = followAxis(row, top_, rows_, worldRows, !placed_);
+    left_ = followAxis(col, left_, cols_, worldCols, !placed_);
+    placed_ = true;
+}
+
+int Camera::followAxis(int position, int start, int view, int world, bool recentre) {
+    if (recentre) {
+        start = position - view / 2;
+    } else {
+        const int margin = view / DEAD_ZONE_MARGIN;
+        if (position < start + margin) {
+            start = position - margin;
+        } else if (position >= start + view - margin) {
+            start = position - view + margin + 1;
+        }
+    }
+    return std::clamp(start, 0, world - view);
+}
@@ -0,0 +1,200 @@
+#include "CombatKernel.hpp"
+#include "EnemyStore.hpp"
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+// Scalar Kernel
+
+// Resolve enemies [begin, end) one at a time (also handles SIMD tails)
+static void resolveRange(std::size_t begin, std::size_t end,
+                         int playerRow, int playerCol, int playerAttack,
+                         EnemyStore& enemies, CombatResult& result) {
+    int* health = enemies.health.data();
+    const int* row = enemies.row.data();
+    const int* col = enemies.col.data();
+    const int* attack = enemies.attack.data();
+    const std::uint8_t* alive = enemies.alive.data();
+
+    for (std::size_t i = begin; i < end; ++i) {
+        if (!(alive[i] && row[i] == playerRow && col[i] == playerCol)) {
+            continue;
+        }
+        int remaining = health[i] - playerAttack;
+        result.struck.push_back(static_cast<std::uint32_t>(i));
+        if (remaining <= 0) {
+            health[i] = 0;
+            result.killed.push_back(static_cast<std::uint32_t>(i));
+        } else {
+            health[i] = remaining;
+            result.damageToPlayer += attack[i];
+        }
+    }
+}
+
+// Health was written in place: report the struck enemies to the store
+static void markStruck(EnemyStore& enemies, const CombatResult& result) {
+    for (std::uint32_t index : result.struck) {
+        enemies.markChanged(index);
+    }
+}
+
+void resolveCombatScalar(int playerRow, int playerCol, int playerAttack,
+                         EnemyStore& enemies, CombatResult& result) {
+    result.clear();
+    resolveRange(0, enemies.size(), playerRow, playerCol, playerAttack, enemies, result);
+    markStruck(enemies, result);
+}
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+// Append lane indices whose bit is set in mask, lowest lane first
+static void pushLanes(std::vector<std::uint32_t>& out, std::size_t base, unsigned mask) {
+    while (mask) {
+        unsigned lane = static_cast<unsigned>(__builtin_ctz(mask));
+        out.push_back(static_cast<std::uint32_t>(base + lane));
+        mask &= mask - 1;
+    }
+}
+#endif
+
+// Vector Kernels
+// Both follow the same steps per block of lanes:
+//   hit      = alive && row == playerRow && col == playerCol
+//   health' = max(health - (hit ? attack : 0), 0)
+//   died     = hit && health - attack <= 0
+//   damage  += survived ? enemyAttack : 0
+// Blocks with no hits (the common case) skip everything after the compare.
+
+#if defined(__AVX2__)
+
+const char* combatKernelIsa() {
+    return "avx2";
+}
+
+void resolveCombat(int playerRow, int playerCol, int playerAttack,
+                   EnemyStore& enemies, CombatResult& result) {
+    result.clear();
+
+    const std::size_t count = enemies.size();
+    const std::size_t blocks = count / 8 * 8;
+
+    int* health = enemies.health.data();
+    const int* row = enemies.row.data();
+    const int* col = enemies.col.data();
+    const int* attack = enemies.attack.data();
+    const std::uint8_t* alive = enemies.alive.data();
+
+    const __m256i pRow = _mm256_set1_epi32(playerRow);
+    const __m256i pCol = _mm256_set1_epi32(playerCol);
+    const __m256i pAtk = _mm256_set1_epi32(playerAttack);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i damage = zero;
+
+    for (std::size_t i = 0; i < blocks; i += 8) {
+        __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i));
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(col + i));
+        __m128i a8 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(alive + i));
+        __m256i a = _mm256_cvtepu8_epi32(a8);
+
+        __m256i hit = _mm256_and_si256(_mm256_cmpeq_epi32(r, pRow),
+                                       _mm256_cmpeq_epi32(c, pCol));
+        hit = _mm256_andnot_si256(_mm256_cmpeq_epi32(a, zero), hit);
+        if (_mm256_testz_si256(hit, hit)) {
+            continue;
+        }
+
+        __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(health + i));
+        __m256i after = _mm256_sub_epi32(h, _mm256_and_si256(hit, pAtk));
+        __m256i died = _mm256_and_si256(hit, _mm256_cmpgt_epi32(_mm256_set1_epi32(1), after));
+        __m256i survived = _mm256_andnot_si256(died, hit);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(health + i), _mm256_max_epi32(after, zero));
+
+        __m256i e = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(attack + i));
+        damage = _mm256_add_epi32(damage, _mm256_and_si256(survived, e));
+
+        pushLanes(result.struck, i, static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(hit))));
+        pushLanes(result.killed, i, static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(died))));
+    }
+
+    // Horizontal sum of the per-lane damage
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(damage), _mm256_extracti128_si256(damage, 1));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    result.damageToPlayer += _mm_cvtsi128_si32(sum);
+
+    resolveRange(blocks, count, playerRow, playerCol, playerAttack, enemies, result);
+    markStruck(enemies, result);
+}
+
+#elif defined(__SSE4_1__)
+
+const char* combatKernelIsa() {
+    return "sse4.1";
+}
+
+void resolveCombat(int playerRow, int playerCol, int playerAttack,
+                   EnemyStore& enemies, CombatResult& result) {
+    result.clear();
+
+    const std::size_t count = enemies.size();
+    const std::size_t blocks = count / 4 * 4;
+
+    int* health = enemies.health.data();
+    const int* row = enemies.row.data();
+    const int* col = enemies.col.data();
+    const int* attack = enemies.attack.data();
+    const std::uint8_t* alive = enemies.alive.data();
+
+    const __m128i pRow = _mm_set1_epi32(playerRow);
+    const __m128i pCol = _mm_set1_epi32(playerCol);
+    const __m128i pAtk = _mm_set1_epi32(playerAttack);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i damage = zero;
+
+    for (std::size_t i = 0; i < blocks; i += 4) {
+        __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(col + i));
+        int a4;
+        __builtin_memcpy(&a4, alive + i, sizeof(a4));
+        __m128i a = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(a4));
+
+        __m128i hit = _mm_and_si128(_mm_cmpeq_epi32(r, pRow), _mm_cmpeq_epi32(c, pCol));
+        hit = _mm_andnot_si128(_mm_cmpeq_epi32(a, zero), hit);
+        if (_mm_testz_si128(hit, hit)) {
+            continue;
+        }
+
+        __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(health + i));
+        __m128i after = _mm_sub_epi32(h, _mm_and_si128(hit, pAtk));
+        __m128i died = _mm_and_si128(hit, _mm_cmplt_epi32(after, _mm_set1_epi32(1)));
+        __m128i survived = _mm_andnot_si128(died, hit);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(health + i), _mm_max_epi32(after, zero));
+
+        __m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i*>(attack + i));
+        damage = _mm_add_epi32(damage, _mm_and_si128(survived, e));
+
+        pushLanes(result.struck, i, static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(hit))));
+        pushLanes(result.killed, i, static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(died))));
+    }
+
+    __m128i sum = _mm_add_epi32(damage, _mm_shuffle_epi32(damage, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    result.damageToPlayer += _mm_cvtsi128_si32(sum);
+
+    resolveRange(blocks, count, playerRow, playerCol, playerAttack, enemies, result);
+    markStruck(enemies, result);
+}
+
+#else
+
+const char* combatKernelIsa() {
+    return "scalar";
+}
+
+void resolveCombat(int playerRow, int playerCol, int playerAttack,
+                   EnemyStore& enemies, CombatResult& result) {
+    resolveCombatScalar(playerRow, playerCol, playerAttack, enemies, result);
+}
+
+#endif
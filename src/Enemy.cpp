@@ -1,95 +1,242 @@
 #include "Enemy.hpp"
+#include "FlowField.hpp"
 #include "GameState.hpp"
+#include "Pathfinder.hpp"
 #include "Player.hpp"
-#include <random>
-#include <cmath>
+#include "Random.hpp"
+#include "ThreadPool.hpp"
+#include <cstdlib>
+#include <memory>
+#include <vector>
 
 // Enemy Management Implementation
 
-// Generate a random number within a range
-// Helper function for spawning enemies at random locations
-static int randomInRange(int min, int max) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dist(min, max);
-    return dist(gen);
+void seedEnemyRandom(GameState& state, std::uint32_t seed) {
+    state.spawnRng = Rng::forStream(seed, RngStream::Spawn);
 }
 
-// Calculate distance between two points (used to ensure enemies spawn away from player)
-static double distance(int row1, int col1, int row2, int col2) {
-    int dRow = row2 - row1;
-    int dCol = col2 - col1;
-    return std::sqrt(dRow * dRow + dCol * dCol);
-}
-
-// Spawn enemy at a random location, ensuring it's not too close to the player
-void spawnEnemy(Enemy& enemy, const Player& player) {
-    // Minimum distance from player when spawning (prevents unfair spawns)
-    const double MIN_SPAWN_DISTANCE = 8.0;
+// Spawn enemy on a random eligible tile (free floor away from the player)
+// Every eligible tile is known up front, so this never retries
+EnemyHandle spawnEnemy(EnemyStore& enemies, const Player& player, Rng& rng) {
+    if (enemies.occupancy() >= enemies.capacity()) {
+        return EnemyHandle::invalid();
+    }
 
-    // Try to find a valid spawn position
-    // Maximum attempts to prevent infinite loop
-    const int MAX_ATTEMPTS = 100;
-    int attempts = 0;
+    // The no-spawn zone follows the player
+    enemies.spawnCells.setPlayer(player.row, player.col);
 
     int spawnRow, spawnCol;
+    if (!enemies.spawnCells.sample(rng, spawnRow, spawnCol)) {
+        return EnemyHandle::invalid();
+    }
 
-    do {
-        // Generate random position within playable area
-        // Playable area: rows [1, MAP_ROWS-2], cols [1, MAP_COLS-2]
-        spawnRow = randomInRange(1, GameState::MAP_ROWS - 2);
-        spawnCol = randomInRange(1, GameState::MAP_COLS - 2);
-
-        attempts++;
+    // Take a slot from the pool at full health (the tile stops being eligible)
+    return enemies.add(EnemyStore::DEFAULT_HEALTH, EnemyStore::DEFAULT_ATTACK,
+                       spawnRow, spawnCol);
+}
 
-        // If we've tried too many times, just spawn anywhere valid
-        if (attempts >= MAX_ATTEMPTS) {
-            break;
+// Add enemies one at a time so each gets its own random tile
+void spawnEnemies(GameState& state, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        if (spawnEnemy(state.enemies, state.player, state.spawnRng).isNull()) {
+            break;  // Pool or free tiles used up
         }
-
-    } while (distance(spawnRow, spawnCol, player.row, player.col) < MIN_SPAWN_DISTANCE);
-
-    // Set enemy position
-    enemy.row = spawnRow;
-    enemy.col = spawnCol;
-
-    // Reset enemy state
-    enemy.health = enemy.maxHealth;
-    enemy.isAlive = true;
+    }
 }
 
 // Check if enemy is currently alive
-bool isEnemyAlive(const Enemy& enemy) {
-    return enemy.isAlive && enemy.health > 0;
+bool isEnemyAlive(const EnemyStore& enemies, std::size_t index) {
+    return enemies.alive[index] && enemies.health[index] > 0;
 }
 
 // Collision Detection Implementation
 
 // Check if player and enemy occupy the same tile
-bool checkCollision(const Player& player, const Enemy& enemy) {
+bool checkCollision(const Player& player, const EnemyStore& enemies, std::size_t index) {
     // Only consider collision if enemy is alive
-    if (!enemy.isAlive) {
+    if (!enemies.alive[index]) {
         return false;
     }
 
     // Check if positions match
-    return (player.row == enemy.row) && (player.col == enemy.col);
+    return (player.row == enemies.row[index]) && (player.col == enemies.col[index]);
+}
+
+// Enemy AI Implementation
+
+namespace {
+
+// One step an enemy wants to take this update
+// REPATH: stay put; its patrol route is not cached yet (searched after commit)
+enum EnemyMove : std::uint8_t { STAY, UP, DOWN, LEFT, RIGHT, REPATH };
+
+constexpr int MOVE_ROW[] = {0, -1, 1, 0, 0, 0};
+constexpr int MOVE_COL[] = {0, 0, 0, -1, 1, 0};
+
+// Every SENTRY_EVERY-th enemy slot patrols between posts instead of wandering
+constexpr std::size_t SENTRY_EVERY = 4;
+// Sentries move on to the next post this often
+constexpr std::uint64_t PATROL_SHIFT_TICKS = 2048;
+// Route searches per update; sentries beyond this wait for a later update
+constexpr std::size_t MAX_ROUTE_SEARCHES = 16;
+
+// Worker threads and per-enemy decisions, reused between updates
+struct EnemyAIContext {
+    unsigned threads = 0;                // Requested thread count (0 = hardware)
+    std::unique_ptr<ThreadPool> pool;    // Created on first parallel update
+    std::vector<std::uint8_t> moves;     // Decided move per enemy slot
+    std::vector<std::uint32_t> repath;   // Sentries whose route needs a search
+};
+
+EnemyAIContext& aiContext() {
+    static EnemyAIContext context;
+    return context;
 }
 
-// Enemy AI Implementation (Placeholder)
-
-// Simple AI to move enemy toward player
-// Currently unimplemented - enemies are stationary
-// Future enhancement: Add pathfinding or simple chase behavior
-void updateEnemyAI(Enemy& enemy, const Player& player) {
-    // TODO: Implement basic AI
-    // Possible behaviors:
-    //   - Move toward player (naive chase)
-    //   - Random movement
-    //   - Patrol behavior
-    //   - Only move when player is within detection range
-
-    // For now, enemies don't move
-    (void)enemy;   // Suppress unused parameter warning
-    (void)player;  // Suppress unused parameter warning
+// Stateless hash of (enemy, tick): wandering needs randomness that does
+// not depend on which thread handles which enemy, or in what order
+std::uint32_t wanderHash(std::uint64_t index, std::uint64_t generation, std::uint64_t tick) {
+    return static_cast<std::uint32_t>(
+        mixBits(index * 0x9E3779B97F4A7C15ull ^ generation * 0xC2B2AE3D27D4EB4Full ^ tick));
+}
+
+// Post a sentry is heading for: one of four points around the AI window, taken
+// in turn, with neighbouring sentries spread over different posts
+PathNode patrolPost(const Pathfinder& paths, std::size_t i, std::uint64_t tick) {
+    const std::size_t post = (i / SENTRY_EVERY + tick / PATROL_SHIFT_TICKS) % 4;
+    const int top = paths.originRow() + paths.rows() / 4;
+    const int bottom = paths.originRow() + paths.rows() - 1 - paths.rows() / 4;
+    const int left = paths.originCol() + paths.cols() / 4;
+    const int right = paths.originCol() + paths.cols() - 1 - paths.cols() / 4;
+    const PathNode POSTS[] = {{top, left}, {top, right}, {bottom, right}, {bottom, left}};
+    return POSTS[post];
+}
+
+// Move that takes an enemy from one tile to an adjacent one
+EnemyMove moveBetween(int r, int c, PathNode next) {
+    if (next.row < r) return UP;
+    if (next.row > r) return DOWN;
+    if (next.col < c) return LEFT;
+    if (next.col > c) return RIGHT;
+    return STAY;
+}
+
+// Pick one enemy's move from a read-only view of the store
+EnemyMove decideMove(const EnemyStore& enemies, std::size_t i, const FlowField& chase,
+                     const Pathfinder& paths, std::uint64_t tick) {
+    // Enemies notice the player within this many steps
+    const int DETECTION_RANGE = 8;
+
+    const int r = enemies.row[i];
+    const int c = enemies.col[i];
+
+    const int dist = chase.distance(r, c);
+    if (dist <= DETECTION_RANGE) {
+        if (dist == 0) {
+            return STAY;
+        }
+        // Chase: step to a neighbour one tile closer, closing the larger
+        // gap first so the approach looks direct rather than L-shaped
+        const int dRow = chase.rootRow() - r;
+        const int dCol = chase.rootCol() - c;
+        EnemyMove vertical = dRow < 0 ? UP : DOWN;
+        EnemyMove horizontal = dCol < 0 ? LEFT : RIGHT;
+        bool verticalFirst = std::abs(dRow) >= std::abs(dCol);
+        const EnemyMove order[] = {
+            verticalFirst ? vertical : horizontal,
+            verticalFirst ? horizontal : vertical,
+            verticalFirst ? (horizontal == LEFT ? RIGHT : LEFT) : (vertical == UP ? DOWN : UP),
+            verticalFirst ? (vertical == UP ? DOWN : UP) : (horizontal == LEFT ? RIGHT : LEFT),
+        };
+        for (EnemyMove m : order) {
+            if (chase.distance(r + MOVE_ROW[m], c + MOVE_COL[m]) == dist - 1) {
+                return m;
+            }
+        }
+        return STAY;
+    }
+
+    // Patrol: sentries follow cached A* routes (lookups only - searching
+    // would mutate the pathfinder from several threads)
+    if (i % SENTRY_EVERY == 0) {
+        PathNode next{};
+        switch (paths.cachedStep({r, c}, patrolPost(paths, i, tick), next)) {
+            case Pathfinder::StepResult::Step:    return moveBetween(r, c, next);
+            case Pathfinder::StepResult::Arrived: return STAY;
+            case Pathfinder::StepResult::Unknown: return REPATH;
+            case Pathfinder::StepResult::NoPath:  break;  // Wander instead
+        }
+    }
+
+    // Wander: half the time stay put, otherwise step in a random direction
+    std::uint32_t roll = wanderHash(i, enemies.generation[i], tick) & 7u;
+    EnemyMove move = roll < 4 ? static_cast<EnemyMove>(roll + 1) : STAY;
+    return chase.isWalkable(r + MOVE_ROW[move], c + MOVE_COL[move]) ? move : STAY;
+}
+
+}  // namespace
+
+void setEnemyAIThreads(unsigned threads) {
+    EnemyAIContext& ai = aiContext();
+    ai.threads = threads;
+    ai.pool.reset();
+}
+
+// Decide in parallel (read-only), then commit sequentially (deterministic)
+void updateEnemyAI(EnemyStore& enemies, const FlowField& chase, Pathfinder& paths,
+                   std::uint64_t tick) {
+    // Below this many enemies the handoff costs more than it saves
+    const std::size_t PARALLEL_MIN_ENEMIES = 4096;
+    // Enemies per work-stealing chunk
+    const std::size_t CHUNK_SIZE = 1024;
+
+    EnemyAIContext& ai = aiContext();
+    const std::size_t count = enemies.size();
+    ai.moves.resize(count);
+
+    const EnemyStore& view = enemies;
+    auto decide = [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            ai.moves[i] = view.alive[i] ? decideMove(view, i, chase, paths, tick) : STAY;
+        }
+    };
+
+    // DECIDE PHASE: Every enemy reads the same snapshot
+    if (count >= PARALLEL_MIN_ENEMIES && ai.threads != 1) {
+        if (!ai.pool) {
+            ai.pool = std::make_unique<ThreadPool>(ai.threads);
+        }
+        ai.pool->parallelFor(count, CHUNK_SIZE, decide);
+    } else {
+        decide(0, count);
+    }
+
+    // COMMIT PHASE: Apply moves in index order so the grid always ends up
+    // with the same layout
+    ai.repath.clear();
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint8_t m = ai.moves[i];
+        if (m == REPATH) {
+            ai.repath.push_back(static_cast<std::uint32_t>(i));
+        } else if (m != STAY) {
+            enemies.place(i, enemies.row[i] + MOVE_ROW[m], enemies.col[i] + MOVE_COL[m]);
+        }
+    }
+
+    // ROUTE PHASE: Search for uncached patrol routes, in index order and
+    // within a budget; the sentries start walking them on the next update
+    std::size_t searches = 0;
+    for (std::uint32_t i : ai.repath) {
+        PathNode from{enemies.row[i], enemies.col[i]};
+        PathNode post = patrolPost(paths, i, tick);
+        PathNode next{};
+        // An earlier search this update may already cover this sentry
+        if (paths.cachedStep(from, post, next) != Pathfinder::StepResult::Unknown) {
+            continue;
+        }
+        if (searches++ == MAX_ROUTE_SEARCHES) {
+            break;
+        }
+        paths.nextStep(from, post, next);
+    }
 }
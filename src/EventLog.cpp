@@ -0,0 +1,150 @@
+#include "EventLog.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+// Formatting
+
+int formatLogEvent(const LogEvent& event, char* out, std::size_t size) {
+    switch (event.type) {
+        case LogEventType::PlayerAttack:
+            return std::snprintf(out, size, "[COMBAT] Player attacks enemy for %d damage!", event.a);
+        case LogEventType::EnemyDefeated:
+            return std::snprintf(out, size, "[COMBAT] Enemy defeated!");
+        case LogEventType::EnemyAttack:
+            return std::snprintf(out, size, "[COMBAT] Enemy attacks back for %d damage!", event.a);
+        case LogEventType::ExperienceGained:
+            return std::snprintf(out, size, "[XP] Gained %d experience! (%d/%d)",
+                                 event.a, event.b, event.c);
+        case LogEventType::LevelUp:
+            return std::snprintf(out, size, "*** LEVEL UP! *** Level %d, max health %d, attack %d",
+                                 event.a, event.b, event.c);
+        case LogEventType::Healed:
+            return std::snprintf(out, size, "[HEAL] Restored %d health points!", event.a);
+    }
+    return std::snprintf(out, size, "[?] Unknown event");
+}
+
+// Ring Buffer
+
+EventLog::EventLog() = default;
+
+void EventLog::push(LogEventType type, int a, int b, int c) {
+    const std::uint64_t seq = written_.load(std::memory_order_relaxed);
+    Slot& slot = slots_[seq & (CAPACITY - 1)];
+
+    // Mark the slot unreadable before touching its fields
+    slot.seq.store(EMPTY, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.tick.store(tick_, std::memory_order_relaxed);
+    slot.typeAndA.store(static_cast<std::uint64_t>(type) << 32 | static_cast<std::uint32_t>(a),
+                        std::memory_order_relaxed);
+    slot.bAndC.store(static_cast<std::uint64_t>(static_cast<std::uint32_t>(b)) << 32 |
+                         static_cast<std::uint32_t>(c),
+                     std::memory_order_relaxed);
+
+    slot.seq.store(seq, std::memory_order_release);
+    written_.store(seq + 1, std::memory_order_release);
+}
+
+bool EventLog::read(std::uint64_t seq, LogEvent& out) const {
+    const Slot& slot = slots_[seq & (CAPACITY - 1)];
+    if (slot.seq.load(std::memory_order_acquire) != seq) {
+        return false;
+    }
+    const std::uint64_t tick = slot.tick.load(std::memory_order_relaxed);
+    const std::uint64_t typeAndA = slot.typeAndA.load(std::memory_order_relaxed);
+    const std::uint64_t bAndC = slot.bAndC.load(std::memory_order_relaxed);
+
+    // Still the same event? (the writer may have lapped us mid-read)
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.seq.load(std::memory_order_relaxed) != seq) {
+        return false;
+    }
+
+    out.tick = tick;
+    out.type = static_cast<LogEventType>(typeAndA >> 32);
+    out.a = static_cast<int>(static_cast<std::uint32_t>(typeAndA));
+    out.b = static_cast<int>(static_cast<std::uint32_t>(bAndC >> 32));
+    out.c = static_cast<int>(static_cast<std::uint32_t>(bAndC));
+    return true;
+}
+
+// File Sink
+
+EventLogFile::EventLogFile(std::shared_ptr<const EventLog> log, const std::string& path)
+    : log_{std::move(log)},
+      file_{std::fopen(path.c_str(), "w")},
+      next_{log_->written()},
+      thread_{[this] { run(); }} {}
+
+EventLogFile::~EventLogFile() {
+    {
+        std::lock_guard<std::mutex> lock{stopMutex_};
+        stopping_ = true;
+    }
+    stopSignal_.notify_one();
+    thread_.join();
+    if (file_) {
+        std::fclose(file_);
+    }
+}
+
+void EventLogFile::run() {
+    std::unique_lock<std::mutex> lock{stopMutex_};
+    while (true) {
+        const bool stop = stopSignal_.wait_for(lock, std::chrono::milliseconds{FLUSH_INTERVAL_MS},
+                                               [this] { return stopping_; });
+        lock.unlock();
+        writeBatch();
+        lock.lock();
+        if (stop) {
+            return;
+        }
+    }
+}
+
+void EventLogFile::writeBatch() {
+    if (!file_) {
+        return;
+    }
+    const std::uint64_t end = log_->written();
+    batch_.clear();
+
+    // Anything older than one ring's worth is already gone
+    std::uint64_t lost = 0;
+    if (end - next_ > EventLog::CAPACITY) {
+        lost = end - EventLog::CAPACITY - next_;
+        next_ = end - EventLog::CAPACITY;
+    }
+
+    std::uint64_t written = 0;
+    char line[128];
+    LogEvent event;
+    for (; next_ < end; ++next_) {
+        if (!log_->read(next_, event)) {
+            lost++;  // Overwritten while we were formatting
+            continue;
+        }
+        int n = std::snprintf(line, sizeof(line), "%llu ",
+                              static_cast<unsigned long long>(event.tick));
+        batch_.append(line, static_cast<std::size_t>(n));
+        n = formatLogEvent(event, line, sizeof(line));
+        batch_.append(line, std::min(static_cast<std::size_t>(n), sizeof(line) - 1));
+        batch_.push_back('\n');
+        written++;
+    }
+    if (lost > 0) {
+        int n = std::snprintf(line, sizeof(line), "... %llu events lost (log fell behind)\n",
+                              static_cast<unsigned long long>(lost));
+        batch_.append(line, static_cast<std::size_t>(n));
+    }
+
+    if (!batch_.empty()) {
+        std::fwrite(batch_.data(), 1, batch_.size(), file_);
+        std::fflush(file_);
+    }
+    eventsWritten_.fetch_add(written, std::memory_order_relaxed);
+    eventsLost_.fetch_add(lost, std::memory_order_relaxed);
+}
@@ -0,0 +1,37 @@
+#include "EventScheduler.hpp"
+
+#include <algorithm>
+
+// Heap Ordering
+
+// std heap functions build a max-heap, so "less" means "fires later"
+static bool firesLater(const TimedEvent& a, const TimedEvent& b) {
+    if (a.tick != b.tick) {
+        return a.tick > b.tick;
+    }
+    return a.sequence > b.sequence;
+}
+
+// Scheduling
+
+void EventScheduler::schedule(std::uint64_t tick, TimedEventType type, int payload) {
+    heap_.push_back(TimedEvent{tick, nextSequence_++, type, payload});
+    std::push_heap(heap_.begin(), heap_.end(), firesLater);
+}
+
+void EventScheduler::restore(const TimedEvent* events, std::size_t count,
+                             std::uint64_t nextSequence) {
+    heap_.assign(events, events + count);
+    std::make_heap(heap_.begin(), heap_.end(), firesLater);
+    nextSequence_ = nextSequence;
+}
+
+bool EventScheduler::popDue(std::uint64_t now, TimedEvent& out) {
+    if (heap_.empty() || heap_.front().tick > now) {
+        return false;
+    }
+    std::pop_heap(heap_.begin(), heap_.end(), firesLater);
+    out = heap_.back();
+    heap_.pop_back();
+    return true;
+}
@@ -0,0 +1,165 @@
+#include "FieldOfView.hpp"
+#include "TileMap.hpp"
+
+#include <algorithm>
+
+// Slope Arithmetic
+// Slopes stay exact fractions so tile edges never suffer rounding error
+
+namespace {
+
+// Floor and ceiling of a / b for b > 0
+int floorDiv(int a, int b) {
+    return a / b - (a % b != 0 && a < 0);
+}
+
+int ceilDiv(int a, int b) {
+    return -floorDiv(-a, b);
+}
+
+}  // namespace
+
+// Construction
+
+FieldOfView::FieldOfView(int radiusRows, int radiusCols)
+    : radiusRows_{radiusRows},
+      radiusCols_{radiusCols},
+      boxRows_{2 * radiusRows + 1},
+      boxCols_{2 * radiusCols + 1},
+      visible_((static_cast<std::size_t>(boxRows_) * boxCols_ + 63) / 64, 0) {}
+
+// Viewer
+
+bool FieldOfView::update(const TileMap& map, int row, int col) {
+    if (valid_ && row == viewerRow_ && col == viewerCol_) {
+        return false;
+    }
+    valid_ = true;
+    viewerRow_ = row;
+    viewerCol_ = col;
+    boxTop_ = row - radiusRows_;
+    boxLeft_ = col - radiusCols_;
+    std::fill(visible_.begin(), visible_.end(), 0);
+    visibleCount_ = 0;
+
+    reveal(row, col);
+    for (int quadrant = 0; quadrant < 4; ++quadrant) {
+        scanQuadrant(map, quadrant);
+    }
+    rememberVisible(map);
+    return true;
+}
+
+// Scan a quadrant row by row outward from the viewer. Each row spans the
+// columns between its start and end slopes; a run of walls ends the row's
+// light, and the floor beyond it starts a new, narrower row deeper in.
+void FieldOfView::scanQuadrant(const TileMap& map, int quadrant) {
+    const bool vertical = quadrant < 2;
+    const int sign = (quadrant % 2 == 0) ? -1 : 1;
+    // How far rows go out, and how far to each side they may reach
+    const int maxDepth = vertical ? radiusRows_ : radiusCols_;
+    const int maxSide = vertical ? radiusCols_ : radiusRows_;
+
+    auto toWorld = [&](int depth, int side, int& row, int& col) {
+        if (vertical) {
+            row = viewerRow_ + sign * depth;
+            col = viewerCol_ + side;
+        } else {
+            row = viewerRow_ + side;
+            col = viewerCol_ + sign * depth;
+        }
+    };
+
+    pending_.clear();
+    pending_.push_back(ScanRow{1, Slope{-1, 1}, Slope{1, 1}});
+    while (!pending_.empty()) {
+        ScanRow scan = pending_.back();
+        pending_.pop_back();
+        if (scan.depth > maxDepth) {
+            continue;
+        }
+
+        // Columns whose centre lies within the slopes, ties rounded inward
+        const int first = std::max(
+            floorDiv(2 * scan.depth * scan.start.num + scan.start.den, 2 * scan.start.den),
+            -maxSide);
+        const int last = std::min(
+            ceilDiv(2 * scan.depth * scan.end.num - scan.end.den, 2 * scan.end.den),
+            maxSide);
+
+        int previous = -1;  // Previous tile: -1 none, 0 floor, 1 wall
+        for (int side = first; side <= last; ++side) {
+            int row;
+            int col;
+            toWorld(scan.depth, side, row, col);
+            const bool wall = !map.contains(row, col) || !map.isWalkable(row, col);
+
+            // Walls show when any part is lit; floor only when its centre is
+            const bool centreLit = side * scan.start.den >= scan.depth * scan.start.num &&
+                                   side * scan.end.den <= scan.depth * scan.end.num;
+            if (wall || centreLit) {
+                reveal(row, col);
+            }
+
+            // Slope through the tile's near edge on the start side
+            const Slope edge{2 * side - 1, 2 * scan.depth};
+            if (previous == 1 && !wall) {
+                scan.start = edge;
+            } else if (previous == 0 && wall) {
+                pending_.push_back(ScanRow{scan.depth + 1, scan.start, edge});
+            }
+            previous = wall ? 1 : 0;
+        }
+        if (previous == 0) {
+            pending_.push_back(ScanRow{scan.depth + 1, scan.start, scan.end});
+        }
+    }
+}
+
+void FieldOfView::reveal(int row, int col) {
+    const std::size_t bit = static_cast<std::size_t>(row - boxTop_) * boxCols_ + (col - boxLeft_);
+    std::uint64_t& word = visible_[bit / 64];
+    const std::uint64_t mask = std::uint64_t{1} << (bit % 64);
+    visibleCount_ += (word & mask) == 0;
+    word |= mask;
+}
+
+// Copy the visible box into memory one chunk-wide row segment at a time,
+// so each segment costs one chunk lookup rather than one per tile
+void FieldOfView::rememberVisible(const TileMap& map) {
+    const int top = std::max(boxTop_, 0);
+    const int left = std::max(boxLeft_, 0);
+    const int bottom = std::min(boxTop_ + boxRows_, map.rows());
+    const int right = std::min(boxLeft_ + boxCols_, map.cols());
+    for (int row = top; row < bottom; ++row) {
+        for (int segment = left; segment < right;) {
+            const int segmentEnd = std::min(right, (segment / CHUNK_SIZE + 1) * CHUNK_SIZE);
+            ChunkBits* chunk = nullptr;
+            for (int col = segment; col < segmentEnd; ++col) {
+                if (!isVisible(row, col)) {
+                    continue;
+                }
+                if (!chunk) {
+                    chunk = &remembered_.try_emplace(chunkKey(row, col)).first->second;
+                }
+                const int inChunk = (row % CHUNK_SIZE) * CHUNK_SIZE + col % CHUNK_SIZE;
+                (*chunk)[inChunk / 64] |= std::uint64_t{1} << (inChunk % 64);
+            }
+            segment = segmentEnd;
+        }
+    }
+}
+
+// Queries
+
+bool FieldOfView::isRemembered(int row, int col) const {
+    if (row < 0 || col < 0) {
+        return false;
+    }
+    auto found = remembered_.find(chunkKey(row, col));
+    if (found == remembered_.end()) {
+        return false;
+    }
+    const int inChunk = (row % CHUNK_SIZE) * CHUNK_SIZE + col % CHUNK_SIZE;
+    return (found->second[inChunk / 64] >> (inChunk % 64)) & 1u;
+}
@@ -0,0 +1,373 @@
+#include "FlowField.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+// Neighbours
+
+// Call fn(neighbourCell, row, col) for each in-bounds 4-neighbour of the
+// cell at (row, col)
+template <typename Fn>
+static void forEachNeighbor(std::size_t cell, int row, int col, int rows, int cols, Fn&& fn) {
+    const std::size_t stride = static_cast<std::size_t>(cols);
+    if (row > 0)        fn(cell - stride, row - 1, col);
+    if (row < rows - 1) fn(cell + stride, row + 1, col);
+    if (col > 0)        fn(cell - 1, row, col - 1);
+    if (col < cols - 1) fn(cell + 1, row, col + 1);
+}
+
+template <typename Fn>
+static void forEachNeighbor(std::size_t cell, int rows, int cols, Fn&& fn) {
+    forEachNeighbor(cell, static_cast<int>(cell / cols), static_cast<int>(cell % cols),
+                    rows, cols, std::forward<Fn>(fn));
+}
+
+// Construction
+
+FlowField::FlowField(int rows, int cols)
+    : rows_{rows}, cols_{cols},
+      stored_(static_cast<std::size_t>(rows) * cols, INF),
+      walkable_(static_cast<std::size_t>(rows) * cols, 0),
+      mark_(static_cast<std::size_t>(rows) * cols, 0) {
+    queue_.reserve(stored_.size());
+}
+
+// Root
+
+void FlowField::setRoot(int row, int col) {
+    if (!contains(row, col)) {
+        return;
+    }
+    if (hasRoot_ && row == rootRow_ && col == rootCol_) {
+        touched_ = 0;
+        return;
+    }
+
+    const bool oneStep = hasRoot_ &&
+                         std::abs(row - rootRow_) + std::abs(col - rootCol_) == 1;
+    const std::size_t oldCell = rootCell_;
+    const std::size_t newCell = cellIndex(row, col);
+    const int oldRow = rootRow_ - originRow_;
+    const int oldCol = rootCol_ - originCol_;
+
+    hasRoot_ = true;
+    rootRow_ = row;
+    rootCol_ = col;
+    rootCell_ = newCell;
+
+    // A step keeps every distance within one of its old value only when
+    // both roots are walkable
+    if (!oneStep || !walkable_[oldCell] || !walkable_[newCell]) {
+        rebuild();
+        return;
+    }
+    stepRoot(oldRow, oldCol);
+}
+
+// Across a step from the old root to the new one, the straight-line
+// distance drops by one on the new root's side and grows by one on the
+// old root's, so stored values now read as (old distance - 1) and
+// (old distance + 1). Edges within either side shift together and stay
+// consistent; only the two lines either side of the step can be wrong:
+//   - Too low: tiles on the new side whose shortest path crossed the step.
+//     They are found like raiseAround's (walking children outward from the
+//     new side's line, keeping tiles with a surviving closer neighbour)
+//     and cleared.
+//   - Too high: tiles that a path across the step now shortens. Lowered
+//     outward from both lines together with the cleared tiles.
+void FlowField::stepRoot(int oldRow, int oldCol) {
+    const int rootRow = rootRow_ - originRow_;
+    const int rootCol = rootCol_ - originCol_;
+    const int dr = rootRow - oldRow;
+    const int dc = rootCol - oldCol;
+    auto newSide = [&](int r, int c) { return (r - rootRow) * dr + (c - rootCol) * dc >= 0; };
+
+    // Call fn(cell, row, col) for each tile on the line through (row, col)
+    // across the step
+    auto forEachOnLine = [&](int row, int col, auto&& fn) {
+        if (dc != 0) {
+            for (int r = 0; r < rows_; ++r) {
+                fn(static_cast<std::size_t>(r) * cols_ + col, r, col);
+            }
+        } else {
+            for (int c = 0; c < cols_; ++c) {
+                fn(static_cast<std::size_t>(row) * cols_ + c, row, c);
+            }
+        }
+    };
+
+    // FIND PHASE: In increasing distance order from the new side's line,
+    // so a tile's closer neighbours are settled before it is checked
+    nextMark();
+    seeds_.clear();
+    affected_.clear();
+    forEachOnLine(rootRow, rootCol, [&](std::size_t cell, int r, int c) {
+        const int d = load(cell, r, c);
+        if (d != UNREACHABLE) {
+            mark_[cell] = markStamp_;
+            addSeed(d, cell);
+        }
+    });
+    startPass();
+    int d = 0;
+    std::size_t cell = 0;
+    while (popNearest(d, cell)) {
+        const int row = static_cast<int>(cell / cols_);
+        const int col = static_cast<int>(cell % cols_);
+
+        bool supported = cell == rootCell_;
+        forEachNeighbor(cell, row, col, rows_, cols_, [&](std::size_t n, int nr, int nc) {
+            supported = supported || (passable(n) && load(n, nr, nc) == d - 1);
+        });
+        if (supported) {
+            continue;
+        }
+
+        affected_.push_back(static_cast<std::uint32_t>(cell));
+        forEachNeighbor(cell, row, col, rows_, cols_, [&](std::size_t n, int nr, int nc) {
+            if (mark_[n] != markStamp_ && newSide(nr, nc) && load(n, nr, nc) == d + 1) {
+                mark_[n] = markStamp_;
+                pushNext(d + 1, n);
+            }
+        });
+        store(cell, row, col, UNREACHABLE);
+    }
+
+    // SEED PHASE: Cleared tiles from their neighbours, and paths across
+    // the step from both lines
+    seedAffected();
+    auto relaxAcross = [&](std::size_t cell, int r, int c) {
+        const int d = load(cell, r, c);
+        if (d == UNREACHABLE || !passable(cell)) {
+            return;
+        }
+        forEachNeighbor(cell, r, c, rows_, cols_, [&](std::size_t n, int nr, int nc) {
+            if (walkable_[n] && load(n, nr, nc) > d + 1) {
+                addSeed(d + 1, n);
+            }
+        });
+    };
+    forEachOnLine(rootRow, rootCol, relaxAcross);
+    forEachOnLine(oldRow, oldCol, relaxAcross);
+
+    // REFILL PHASE
+    touched_ = affected_.size();
+    lowerFromSeeds();
+}
+
+void FlowField::rebuild() {
+    std::fill(stored_.begin(), stored_.end(), INF);
+    rebuilds_++;
+
+    store(rootCell_, 0);
+    queue_.clear();
+    queue_.push_back(static_cast<std::uint32_t>(rootCell_));
+    touched_ = 1;
+    lowerFromQueue();
+}
+
+// FIFO order visits tiles in increasing distance, so each is lowered once.
+// In stored values a step away from the root costs nothing and a step
+// toward it costs two, so neighbours are compared without recomputing
+// distances. (Locals instead of members: stores to stored_ could alias
+// them and keep the compiler from hoisting the loads.)
+void FlowField::lowerFromQueue() {
+    std::int32_t* stored = stored_.data();
+    const std::uint8_t* walkable = walkable_.data();
+    const std::size_t stride = static_cast<std::size_t>(cols_);
+    const int rootRow = rootRow_ - originRow_;
+    const int rootCol = rootCol_ - originCol_;
+    for (std::size_t head = 0; head < queue_.size(); ++head) {
+        const std::size_t cell = queue_[head];
+        const int row = static_cast<int>(cell / stride);
+        const int col = static_cast<int>(cell % stride);
+        const std::int32_t base = stored[cell];
+        auto relax = [&](std::size_t n, bool away) {
+            // INF is above any lowered value
+            const std::int32_t lowered = away ? base : base + 2;
+            if (walkable[n] && stored[n] > lowered) {
+                stored[n] = lowered;
+                queue_.push_back(static_cast<std::uint32_t>(n));
+                touched_++;
+            }
+        };
+        if (row > 0)         relax(cell - stride, row <= rootRow);
+        if (row < rows_ - 1) relax(cell + stride, row >= rootRow);
+        if (col > 0)         relax(cell - 1, col <= rootCol);
+        if (col < cols_ - 1) relax(cell + 1, col >= rootCol);
+    }
+    queue_.clear();
+}
+
+// Tiles are written when first reached, so a stale entry (lowered again
+// since it was pushed) is skipped when popped
+void FlowField::lowerFromSeeds() {
+    std::int32_t* stored = stored_.data();
+    const std::uint8_t* walkable = walkable_.data();
+    const std::size_t stride = static_cast<std::size_t>(cols_);
+    const int rootRow = rootRow_ - originRow_;
+    const int rootCol = rootCol_ - originCol_;
+    startPass();
+    int d = 0;
+    std::size_t cell = 0;
+    while (popNearest(d, cell)) {
+        const int row = static_cast<int>(cell / stride);
+        const int col = static_cast<int>(cell % stride);
+        const std::int32_t base = d - std::abs(row - rootRow) - std::abs(col - rootCol);
+        if (stored[cell] < base) {
+            continue;
+        }
+        if (stored[cell] > base) {
+            stored[cell] = base;
+            touched_++;
+        }
+        auto relax = [&](std::size_t n, bool away) {
+            const std::int32_t lowered = away ? base : base + 2;
+            if (walkable[n] && stored[n] > lowered) {
+                stored[n] = lowered;
+                touched_++;
+                pushNext(d + 1, n);
+            }
+        };
+        if (row > 0)         relax(cell - stride, row <= rootRow);
+        if (row < rows_ - 1) relax(cell + stride, row >= rootRow);
+        if (col > 0)         relax(cell - 1, col <= rootCol);
+        if (col < cols_ - 1) relax(cell + 1, col >= rootCol);
+    }
+}
+
+void FlowField::seedAffected() {
+    seeds_.clear();
+    for (std::uint32_t cell : affected_) {
+        if (!walkable_[cell]) {
+            continue;
+        }
+        int best = UNREACHABLE;
+        forEachNeighbor(cell, rows_, cols_, [&](std::size_t n, int nr, int nc) {
+            int d = load(n, nr, nc);
+            if (d != UNREACHABLE && passable(n)) {
+                best = std::min(best, d + 1);
+            }
+        });
+        if (best != UNREACHABLE) {
+            addSeed(best, cell);
+        }
+    }
+}
+
+void FlowField::startPass() {
+    std::sort(seeds_.begin(), seeds_.end());
+    seedHead_ = 0;
+    pending_.clear();
+    pendingHead_ = 0;
+}
+
+bool FlowField::popNearest(int& dist, std::size_t& cell) {
+    std::uint64_t entry = 0;
+    const bool haveSeed = seedHead_ < seeds_.size();
+    const bool havePending = pendingHead_ < pending_.size();
+    if (haveSeed && (!havePending || seeds_[seedHead_] <= pending_[pendingHead_])) {
+        entry = seeds_[seedHead_++];
+    } else if (havePending) {
+        entry = pending_[pendingHead_++];
+    } else {
+        return false;
+    }
+    dist = static_cast<int>(entry >> 32);
+    cell = static_cast<std::size_t>(entry & 0xFFFFFFFFu);
+    return true;
+}
+
+void FlowField::nextMark() {
+    if (++markStamp_ == 0) {
+        std::fill(mark_.begin(), mark_.end(), 0);
+        markStamp_ = 1;
+    }
+}
+
+// Walls
+
+void FlowField::setWalkable(int row, int col, bool walkable) {
+    if (!contains(row, col)) {
+        return;
+    }
+    const std::size_t cell = cellIndex(row, col);
+    if ((walkable_[cell] != 0) == walkable) {
+        return;
+    }
+    walkable_[cell] = walkable ? 1 : 0;
+    touched_ = 0;
+    if (!hasRoot_ || cell == rootCell_) {
+        return;  // The root is a source either way
+    }
+
+    if (walkable) {
+        // Opened tile: take the best neighbour, then lower outward
+        int best = UNREACHABLE;
+        forEachNeighbor(cell, rows_, cols_, [&](std::size_t n, int nr, int nc) {
+            int d = load(n, nr, nc);
+            if (d != UNREACHABLE && passable(n)) {
+                best = std::min(best, d + 1);
+            }
+        });
+        if (best != UNREACHABLE) {
+            store(cell, best);
+            queue_.clear();
+            queue_.push_back(static_cast<std::uint32_t>(cell));
+            touched_ = 1;
+            lowerFromQueue();
+        }
+    } else if (load(cell) != UNREACHABLE) {
+        raiseAround(cell);
+    }
+}
+
+// A new wall can only lengthen paths, and only for tiles with no shortest
+// path that avoids it. Those are found in increasing distance order (a
+// tile is affected if none of its one-step-closer neighbours survived),
+// cleared, then refilled in distance order seeded from their unaffected
+// neighbours.
+void FlowField::raiseAround(std::size_t wall) {
+    nextMark();
+
+    // FIND PHASE: Walk the shortest-path tree below the wall
+    affected_.clear();
+    queue_.clear();
+    queue_.push_back(static_cast<std::uint32_t>(wall));
+    mark_[wall] = markStamp_;
+    for (std::size_t head = 0; head < queue_.size(); ++head) {
+        const std::size_t cell = queue_[head];
+        const int row = static_cast<int>(cell / cols_);
+        const int col = static_cast<int>(cell % cols_);
+        const int d = load(cell, row, col);
+
+        bool supported = false;
+        if (cell != wall) {
+            forEachNeighbor(cell, row, col, rows_, cols_, [&](std::size_t n, int nr, int nc) {
+                supported = supported || (passable(n) && load(n, nr, nc) == d - 1);
+            });
+        }
+        if (supported) {
+            continue;
+        }
+
+        // Every path through here was through the wall: children may be too
+        affected_.push_back(static_cast<std::uint32_t>(cell));
+        forEachNeighbor(cell, row, col, rows_, cols_, [&](std::size_t n, int nr, int nc) {
+            if (mark_[n] != markStamp_ && load(n, nr, nc) == d + 1) {
+                mark_[n] = markStamp_;
+                queue_.push_back(static_cast<std::uint32_t>(n));
+            }
+        });
+        store(cell, row, col, UNREACHABLE);
+    }
+    queue_.clear();
+
+    // SEED PHASE: Best distance each cleared tile can get from outside
+    seedAffected();
+
+    // REFILL PHASE: Outward over the cleared region, nearest first
+    touched_ = affected_.size();
+    lowerFromSeeds();
+}
@@ -1,107 +1,489 @@
 #include "GameLoop.hpp"
+#include "Camera.hpp"
 #include "GameState.hpp"
+#include "CombatKernel.hpp"
 #include "Input.hpp"
 #include "Player.hpp"
+#include "Profiler.hpp"
 #include "Enemy.hpp"
 #include "Renderer.hpp"
+#include "Replay.hpp"
+#include "SaveGame.hpp"
+#include "RenderBackend.hpp"
+#include "RenderSnapshot.hpp"
+#include "HeadlessRenderer.hpp"
+#include "SimClock.hpp"
+#include "TileMap.hpp"
+#include "TripleBuffer.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <thread>
 
+// Render Thread
+
+// Draws game state snapshots on its own thread so a slow terminal never
+// stalls the simulation. After each update the simulation publishes what
+// the screen shows of the state (a RenderSnapshot of the camera's window,
+// so the cost follows the screen's size rather than the world's or the
+// enemy count); if several arrive while a frame is being drawn, only the
+// newest is rendered and the rest are dropped.
+// Also times input latency: when a drawn frame is the first to include a
+// key, the time from reading that key to the frame being written out.
+class RenderThread {
+public:
+    RenderThread(const GameState& initial, RenderBackend& backend)
+        : backend_{backend}, camera_{GameState::MAP_ROWS, GameState::MAP_COLS},
+          frames_{RenderSnapshot{}}, keysShown_{initial.keysApplied},
+          thread_{[this] { run(); }} {}
+
+    // Destructor: Same as finish()
+    ~RenderThread() { finish(); }
+
+    // Capture the current state into the handoff buffer (simulation thread)
+    // The view is sized to the frames the render thread last drew
+    void publish(const GameState& state) {
+        camera_.resize(viewRows_.load(std::memory_order_relaxed),
+                       viewCols_.load(std::memory_order_relaxed));
+        captureRenderSnapshot(state, camera_, frames_.writeBuffer());
+        frames_.publish();
+    }
+
+    // Stop the thread once it has finished its current frame
+    void finish() {
+        if (thread_.joinable()) {
+            frames_.close();
+            thread_.join();
+        }
+    }
+
+    // Input latency seen so far (call after finish())
+    void latency(InputStats& out) const {
+        out.latencySamples = latencySamples_;
+        out.meanLatencyMs = latencySamples_ > 0 ? latencyTotalMs_ / latencySamples_ : 0.0;
+        out.maxLatencyMs = latencyMaxMs_;
+    }
+
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+private:
+    void run() {
+        PROFILE_THREAD("render");
+        std::uint64_t seen = 0;
+        updateViewSize();
+        while (!frames_.isClosed()) {
+            seen = frames_.waitForPublish(seen);
+            if (frames_.acquire()) {
+                const RenderSnapshot& frame = frames_.readBuffer();
+                {
+                    PROFILE_SCOPE(Render);
+                    printMap(frame, backend_);
+                }
+                updateViewSize();
+                if (frame.keysApplied != keysShown_) {
+                    keysShown_ = frame.keysApplied;
+                    recordLatency(frame.lastKeyTime);
+                }
+            }
+        }
+    }
+
+    // Tell the simulation how much map the backend's frames have room for
+    // (asked here, as the backend may block while a frame is being written)
+    void updateViewSize() {
+        int rows;
+        int cols;
+        mapViewSize(backend_, rows, cols);
+        viewRows_.store(rows, std::memory_order_relaxed);
+        viewCols_.store(cols, std::memory_order_relaxed);
+    }
+
+    void recordLatency(std::chrono::steady_clock::time_point keyTime) {
+        const double ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - keyTime).count();
+        latencySamples_++;
+        latencyTotalMs_ += ms;
+        latencyMaxMs_ = std::max(latencyMaxMs_, ms);
+    }
+
+    RenderBackend& backend_;               // Where frames are drawn
+    Camera camera_;                        // Follows the player (simulation thread)
+    TripleBuffer<RenderSnapshot> frames_;  // Snapshots from the simulation
+
+    // Map window of the frames being drawn (written by the render thread)
+    std::atomic<int> viewRows_{GameState::MAP_ROWS};
+    std::atomic<int> viewCols_{GameState::MAP_COLS};
+
+    // Input latency (render thread only until finish())
+    std::uint64_t keysShown_;         // keysApplied of the last frame drawn
+    std::uint64_t latencySamples_{0};
+    double latencyTotalMs_{0.0};
+    double latencyMaxMs_{0.0};
+
+    std::thread thread_;              // Declared last: starts after everything above
+};
+
 // Game Loop Implementation
-// Main game loop with smooth, persistent movement
-void runGame(GameState& state) {
-    // Initialize raw input handler (automatically restores terminal on exit)
-    RawInput input;
+// Main game loop: a dedicated thread reads the keyboard, the simulation
+// advances in fixed ticks and applies every key queued before each one,
+// and a snapshot is handed to the render thread
+GameRunStats runGame(GameState& state, const SimClockConfig& clockConfig,
+                     ReplayRecorder* recorder, AutoSaver* autosaver) {
+    // Terminal in raw mode (restored on exit), read by the input thread
+    RawInput terminal;
+    InputThread input;
 
-    // Timing system for consistent movement speed
-    using clock = std::chrono::steady_clock;
-    auto lastMove = clock::now();
+    // Start drawing on a separate thread (joined when runGame returns)
+    RenderThread renderer{state, terminalBackend()};
 
-    // Movement delay: controls how fast player moves (80ms = ~12 moves/second)
-    // Lower = faster movement, Higher = slower movement
-    const auto moveDelay = std::chrono::milliseconds(150);
+    // Fixed-timestep clock: wall time in, whole simulation ticks out
+    state.ticksPerSecond = clockConfig.ticksPerSecond;
+    SimClock simClock{clockConfig};
+    simClock.start(SimClock::clock::now());
 
-    // Game loop state
-    bool running = true;
-    char lastDir = 0;  // Stores last pressed direction for persistent movement
+    PROFILE_THREAD("simulation");
 
     // Main game loop - runs every frame
-    while (running && isPlayerAlive(state.player)) {
-        // INPUT PHASE: Check for keyboard input
-        int k = input.pollKey();  // Non-blocking input check
-
-        if (k != -1) {
-            // A key was pressed this frame
-            char ch = static_cast<char>(k);
-
-            // Check for quit command
-            if (ch == 'q' || ch == 'Q') {
-                running = false;
-                continue;
+    while (state.isGameRunning && isPlayerAlive(state.player)) {
+        PROFILE_SCOPE(Frame);
+
+        // UPDATE PHASE: Run however many ticks are due (may be zero)
+        int ticks = simClock.advance(SimClock::clock::now());
+        for (int i = 0; i < ticks; ++i) {
+            // INPUT PHASE: Every key that arrived before this tick, in order
+            {
+                PROFILE_SCOPE(Input);
+                InputEvent event;
+                while (state.isGameRunning && input.pop(event)) {
+                    if (recorder) {
+                        recorder->record(state.tick, event.key);
+                    }
+                    handleInput(state, event.key);
+                    state.keysApplied++;
+                    state.lastKeyTime = event.time;
+                }
+            }
+            if (!state.isGameRunning) {
+                break;
             }
 
-            // Check for movement keys (WASD)
-            if (ch == 'w' || ch == 'W' ||
-                ch == 'a' || ch == 'A' ||
-                ch == 's' || ch == 'S' ||
-                ch == 'd' || ch == 'D') {
+            tickGame(state);
+            if (autosaver) {
+                PROFILE_SCOPE(Autosave);
+                autosaver->onTick(state);
+            }
+        }
+
+        // RENDER PHASE: Hand a snapshot to the render thread (never blocks)
+        if (ticks > 0) {
+            PROFILE_SCOPE(Publish);
+            renderer.publish(state);
+        }
+
+        // FRAME RATE: Sleep until the next tick is due
+        PROFILE_SCOPE(Sleep);
+        std::this_thread::sleep_until(simClock.nextTickTime());
+    }
+
+    if (recorder) {
+        recorder->finish(state);
+    }
+    if (autosaver && isPlayerAlive(state.player)) {
+        autosaver->saveNow(state);
+    }
+
+    GameRunStats stats;
+    stats.clock = simClock.stats();
+    renderer.finish();
+    renderer.latency(stats.input);
+    stats.input.keysRead = input.keysRead();
+    stats.input.keysDropped = input.keysDropped();
+    return stats;
+}
+
+// Headless Simulation
+// Same per-tick path as runGame, minus the terminal, clock and sleeps
+HeadlessResult runHeadless(GameState& state, const HeadlessConfig& config,
+                           ReplayRecorder* recorder, AutoSaver* autosaver) {
+    static constexpr char DIRECTIONS[] = {'w', 'a', 's', 'd'};
+
+    Rng inputRng = Rng::forStream(config.seed, RngStream::Input);
+    std::size_t scriptPos = 0;
+    const std::uint64_t keyInterval =
+        static_cast<std::uint64_t>(config.keyInterval > 0 ? config.keyInterval : 1);
 
-                // Store direction for persistent movement
-                // Convert to lowercase for consistency
-                lastDir = (ch >= 'A' && ch <= 'Z') ? (ch + 32) : ch;
+    HeadlessRenderer frames;
+    HeadlessResult result;
+
+    PROFILE_THREAD("simulation");
+
+    auto start = std::chrono::steady_clock::now();
+
+    while (result.ticksRun < config.ticks &&
+           state.isGameRunning && isPlayerAlive(state.player)) {
+        // INPUT PHASE: Simulated key press every keyInterval ticks
+        if (result.ticksRun % keyInterval == 0) {
+            int key;
+            if (!config.script.empty()) {
+                key = config.script[scriptPos];
+                scriptPos = (scriptPos + 1) % config.script.size();
+            } else {
+                key = DIRECTIONS[inputRng.below(4)];
+            }
+            if (recorder) {
+                recorder->record(state.tick, key);
+            }
+            handleInput(state, key);
+            if (!state.isGameRunning) {
+                break;
             }
         }
 
-        // MOVEMENT PHASE: Apply persistent movement with rate limiting
-        auto now = clock::now();
+        // UPDATE PHASE
+        tickGame(state);
+        result.ticksRun++;
+        if (autosaver) {
+            PROFILE_SCOPE(Autosave);
+            autosaver->onTick(state);
+        }
 
-        // Only move if:
-        //   1. A direction is held (lastDir != 0)
-        //   2. Enough time has passed since last move (rate limiting)
-        if (lastDir && (now - lastMove >= moveDelay)) {
-            movePlayer(state.player, lastDir);
-            lastMove = now;  // Reset movement timer
+        // RENDER PHASE: Optional, into memory only
+        if (config.renderEvery > 0 &&
+            result.ticksRun % static_cast<std::uint64_t>(config.renderEvery) == 0) {
+            PROFILE_SCOPE(Render);
+            printMap(state, frames);
         }
+    }
+
+    result.seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    result.framesRendered = frames.frameCount();
 
-        // UPDATE PHASE: Update game logic
-        updateGame(state);
+    if (recorder) {
+        recorder->finish(state);
+    }
+    if (autosaver && isPlayerAlive(state.player)) {
+        autosaver->saveNow(state);
+    }
+    return result;
+}
 
-        // RENDER PHASE: Draw current frame
-        printMap(state);
+// Replay
+// Feeds logged keys back in on the exact ticks they were first applied
+ReplayResult runReplay(GameState& state, ReplayReader& reader) {
+    seedEnemyRandom(state, reader.seed());
+    state.ticksPerSecond = reader.ticksPerSecond();
 
-        // FRAME RATE: Small sleep to prevent excessive CPU usage
-        // Sleep for 8ms (~120 FPS) - balances responsiveness and CPU usage
-        std::this_thread::sleep_for(std::chrono::milliseconds(8));
+    // Recreate the recorded population (spawned right after seeding)
+    if (reader.enemyCount() > state.enemies.size()) {
+        spawnEnemies(state, reader.enemyCount() - state.enemies.size());
     }
+
+    ReplayResult result;
+    ReplayEvent pending{};
+    bool hasPending = reader.next(pending);
+
+    auto start = std::chrono::steady_clock::now();
+
+    while (true) {
+        // INPUT PHASE: Every key recorded for this tick, in order
+        while (hasPending && pending.tick <= state.tick) {
+            handleInput(state, pending.key);
+            result.eventsApplied++;
+            hasPending = reader.next(pending);
+        }
+
+        // The footer's final tick is only known once all events are read
+        bool reachedEnd = !hasPending && reader.hasFooter() &&
+                          state.tick >= reader.finalTick();
+        if (reachedEnd || !reader.isValid() ||
+            !state.isGameRunning || !isPlayerAlive(state.player)) {
+            break;
+        }
+
+        // UPDATE PHASE
+        tickGame(state);
+        result.ticksRun++;
+    }
+
+    result.seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    result.expectedHash = reader.stateHash();
+    result.actualHash = hashGameState(state);
+    result.matched = reader.isValid() && reader.hasFooter() &&
+                     state.tick == reader.finalTick() &&
+                     result.actualHash == result.expectedHash;
+    return result;
+}
+
+// Input Handling
+
+// Apply a single key press to the game state
+void handleInput(GameState& state, int key) {
+    char ch = static_cast<char>(key);
+
+    // Check for quit command
+    if (ch == 'q' || ch == 'Q') {
+        state.isGameRunning = false;
+        return;
+    }
+
+    // Arrow keys move like their WASD counterparts
+    switch (key) {
+        case KEY_UP:    ch = 'w'; break;
+        case KEY_LEFT:  ch = 'a'; break;
+        case KEY_DOWN:  ch = 's'; break;
+        case KEY_RIGHT: ch = 'd'; break;
+        default: break;
+    }
+
+    // Check for movement keys (WASD)
+    if (ch == 'w' || ch == 'W' ||
+        ch == 'a' || ch == 'A' ||
+        ch == 's' || ch == 'S' ||
+        ch == 'd' || ch == 'D') {
+
+        // Store direction for persistent movement
+        // Convert to lowercase for consistency
+        state.heldDirection = (ch >= 'A' && ch <= 'Z') ? (ch + 32) : ch;
+    }
+}
+
+// Simulation Step
+
+// Convert a game-time duration into whole ticks at the state's tick rate
+std::uint64_t ticksFromMilliseconds(const GameState& state, int milliseconds) {
+    return static_cast<std::uint64_t>(milliseconds) * state.ticksPerSecond / 1000;
+}
+
+// Advance the simulation by exactly one fixed tick
+void tickGame(GameState& state) {
+    // Movement delay: controls how fast player moves (150ms = ~6-7 moves/second)
+    // Lower = faster movement, Higher = slower movement
+    const int MOVE_DELAY_MS = 150;
+
+    PROFILE_SCOPE(Tick);
+
+    // Messages from this tick carry its number
+    state.log->setTick(state.tick);
+
+    // MOVEMENT PHASE: Apply persistent movement with rate limiting
+    // Only move if:
+    //   1. A direction is held
+    //   2. Enough ticks have passed since last move (rate limiting)
+    if (state.heldDirection && state.tick >= state.nextMoveTick) {
+        PROFILE_SCOPE(MovePlayer);
+        movePlayer(state.player, *state.map, state.heldDirection);
+        state.nextMoveTick = state.tick + ticksFromMilliseconds(state, MOVE_DELAY_MS);
+    }
+
+    // UPDATE PHASE: Update game logic
+    updateGame(state);
+
+    state.tick++;
 }
 
 // Game Logic Updates
 
-// Update game state each frame
-void updateGame(GameState& state) {
-    // Check if player and enemy are on the same tile
-    if (checkCollision(state.player, state.enemy)) {
-        // Collision detected - trigger combat
-        attackEnemy(state.player, state.enemy);
-
-        // Check if enemy was defeated
-        if (!isEnemyAlive(state.enemy)) {
-            // Enemy defeated - show victory and respawn
-            displayVictory();
-            state.enemiesDefeated++;
-
-            // Wait a moment so player can see victory message
-            std::this_thread::sleep_for(std::chrono::milliseconds(1500));
-
-            // Spawn new enemy
-            spawnEnemy(state.enemy, state.player);
+// Fire every scheduled event that is due on the current tick
+static void processTimedEvents(GameState& state) {
+    TimedEvent event;
+    while (state.events.popDue(state.tick, event)) {
+        switch (event.type) {
+            case TimedEventType::HideVictoryBanner:
+                // A later kill keeps the banner up for its own pause
+                if (event.tick >= state.victoryBannerUntil) {
+                    state.showVictoryBanner = false;
+                }
+                break;
+            case TimedEventType::RespawnEnemy:
+                spawnEnemy(state.enemies, state.player, state.spawnRng);
+                break;
         }
     }
+}
 
+// Recentre the enemy AI window once the player gets close to one of its
+// edges (edges on the world boundary do not count)
+static void followPlayerWithAIWindow(GameState& state) {
+    // Tiles between the player and a window edge before it moves
+    const int WINDOW_MARGIN = 32;
+
+    const FlowField& window = state.chaseField;
+    const int top = window.originRow();
+    const int left = window.originCol();
+    const int bottom = top + window.rows();
+    const int right = left + window.cols();
+    const Player& player = state.player;
+
+    const bool nearEdge =
+        (top > 0 && player.row - top < WINDOW_MARGIN) ||
+        (bottom < state.map->rows() && bottom - player.row <= WINDOW_MARGIN) ||
+        (left > 0 && player.col - left < WINDOW_MARGIN) ||
+        (right < state.map->cols() && right - player.col <= WINDOW_MARGIN);
+    if (nearEdge) {
+        state.centerAIWindow();
+    }
+}
+
+// Update game state each tick
+void updateGame(GameState& state) {
+    // How long the victory banner stays up before the next enemy appears
+    const int VICTORY_PAUSE_MS = 1500;
+    // Enemies step a little slower than the player so they can be outrun
+    const int ENEMY_MOVE_DELAY_MS = 400;
 
-    //   - Update enemy AI
-    //   - Check for pickups/items
-    //   - Update timers or cooldowns
-    //   - Spawn additional enemies
+    // Map chunks kept in memory around the player, in each direction
+    const int RESIDENT_CHUNK_RADIUS = 4;
+
+    PROFILE_SCOPE(UpdateGame);
+
+    // TIMERS: Fire scheduled events (never blocks - they are just due or not)
+    processTimedEvents(state);
+
+    // WORLD: Let go of map chunks the player has left far behind
+    state.map->evictOutside(state.player.row, state.player.col, RESIDENT_CHUNK_RADIUS);
+
+    // SIGHT: Recompute what the player sees (only after they move)
+    state.sight.update(*state.map, state.player.row, state.player.col);
+
+    // AI: Keep the AI window around the player, then let enemies react to
+    // the player's current position
+    followPlayerWithAIWindow(state);
+    // The player moves at most one tile per tick, so the shared flow field
+    // is patched incrementally rather than rebuilt
+    state.chaseField.setRoot(state.player.row, state.player.col);
+    if (state.tick >= state.nextEnemyMoveTick) {
+        PROFILE_SCOPE(EnemyAI);
+        updateEnemyAI(state.enemies, state.chaseField, state.paths, state.tick);
+        state.nextEnemyMoveTick = state.tick + ticksFromMilliseconds(state, ENEMY_MOVE_DELAY_MS);
+    }
+
+    // COMBAT: Fight every enemy sharing the player's tile
+    // The spatial grid tells us in O(1) whether there is a fight at all;
+    // if so, one batched pass resolves it against every enemy at once
+    EnemyStore& enemies = state.enemies;
+    if (enemies.grid.countAt(state.player.row, state.player.col) > 0) {
+        PROFILE_SCOPE(Combat);
+        thread_local CombatResult combat;
+        resolveCombat(state.player.row, state.player.col, state.player.attack,
+                      enemies, combat);
+        applyCombatResult(state.player, enemies, combat, *state.log);
+
+        // Enemies defeated - show victory now, respawn after a pause
+        // The game keeps running while the banner is up
+        if (!combat.killed.empty()) {
+            state.enemiesDefeated += static_cast<int>(combat.killed.size());
+            state.showVictoryBanner = true;
+
+            std::uint64_t due = state.tick + ticksFromMilliseconds(state, VICTORY_PAUSE_MS);
+            state.victoryBannerUntil = due;
+            state.events.schedule(due, TimedEventType::HideVictoryBanner);
+            for (std::size_t i = 0; i < combat.killed.size(); ++i) {
+                state.events.schedule(due, TimedEventType::RespawnEnemy);
+            }
+        }
+    }
 }
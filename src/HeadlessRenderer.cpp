@@ -0,0 +1,37 @@
+#include "HeadlessRenderer.hpp"
+
+// Construction
+
+HeadlessRenderer::HeadlessRenderer(std::size_t historyLimit)
+    : historyLimit_{historyLimit} {
+    history_.reserve(historyLimit_);
+}
+
+// Frame Capture
+
+// Copy the frame into the capture slot (reuses storage after the first one)
+void HeadlessRenderer::present(const CellGrid& frame) {
+    last_ = frame;
+    if (history_.size() < historyLimit_) {
+        history_.push_back(frame);
+    }
+    ++frameCount_;
+}
+
+void HeadlessRenderer::reset() {
+    last_ = CellGrid{0, 0};
+    history_.clear();
+    frameCount_ = 0;
+}
+
+// Text Conversion
+
+std::string HeadlessRenderer::toText(const CellGrid& frame) {
+    std::string text;
+    text.reserve(static_cast<std::size_t>(frame.rows()) * (frame.cols() + 1));
+    for (int r = 0; r < frame.rows(); ++r) {
+        text.append(frame.rowData(r), static_cast<std::size_t>(frame.cols()));
+        text.push_back('\n');
+    }
+    return text;
+}
@@ -0,0 +1,145 @@
+#include "Input.hpp"
+
+#include <poll.h>
+
+#include <cerrno>
+
+// Escape Sequence Decoding
+
+int InputDecoder::feed(unsigned char byte) {
+    switch (state_) {
+        case State::Ground:
+            if (byte == KEY_ESCAPE) {
+                state_ = State::Escape;
+                return KEY_NONE;
+            }
+            return byte < 0x80 ? byte : KEY_NONE;
+
+        case State::Escape:
+            if (byte == '[') {
+                state_ = State::Csi;
+                return KEY_NONE;
+            }
+            if (byte == 'O') {
+                state_ = State::Ss3;
+                return KEY_NONE;
+            }
+            if (byte == KEY_ESCAPE) {
+                return KEY_ESCAPE;  // ESC ESC: the first was a key press
+            }
+            state_ = State::Ground;
+            return byte < 0x80 ? byte : KEY_NONE;  // Alt+key
+
+        case State::Csi:
+            // Parameter and intermediate bytes (0x20-0x3F) continue the
+            // sequence; a final byte (0x40-0x7E) ends it
+            if (byte >= 0x20 && byte <= 0x3F) {
+                return KEY_NONE;
+            }
+            [[fallthrough]];
+
+        case State::Ss3:
+            state_ = State::Ground;
+            switch (byte) {
+                case 'A': return KEY_UP;
+                case 'B': return KEY_DOWN;
+                case 'C': return KEY_RIGHT;
+                case 'D': return KEY_LEFT;
+                default:  return KEY_NONE;
+            }
+    }
+    return KEY_NONE;
+}
+
+int InputDecoder::flush() {
+    const bool loneEscape = state_ == State::Escape;
+    state_ = State::Ground;
+    return loneEscape ? KEY_ESCAPE : KEY_NONE;
+}
+
+// Input Thread
+
+InputThread::InputThread(int fd) : fd_{fd} {
+    int fds[2];
+    if (pipe(fds) == 0) {
+        wakeRead_ = fds[0];
+        wakeWrite_ = fds[1];
+    }
+    thread_ = std::thread{[this] { run(); }};
+}
+
+InputThread::~InputThread() {
+    stopping_.store(true, std::memory_order_release);
+    if (wakeWrite_ >= 0) {
+        const char wake = 1;
+        [[maybe_unused]] ssize_t n = write(wakeWrite_, &wake, 1);
+    }
+    thread_.join();
+    if (wakeRead_ >= 0) {
+        close(wakeRead_);
+        close(wakeWrite_);
+    }
+}
+
+void InputThread::push(int key, std::chrono::steady_clock::time_point time) {
+    keysRead_.fetch_add(1, std::memory_order_relaxed);
+    if (!queue_.tryPush(InputEvent{key, time})) {
+        keysDropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void InputThread::run() {
+    // Without a wake pipe, check for shutdown this often instead
+    const int STOP_CHECK_MS = 50;
+
+    InputDecoder decoder;
+    unsigned char bytes[64];
+    bool readable = true;  // False once fd reaches end of file or fails
+
+    while (!stopping_.load(std::memory_order_acquire)) {
+        pollfd fds[2] = {
+            {readable ? fd_ : -1, POLLIN, 0},   // poll() skips negative fds
+            {wakeRead_, POLLIN, 0},
+        };
+        int timeout = wakeRead_ >= 0 ? -1 : STOP_CHECK_MS;
+        if (decoder.isPending()) {
+            timeout = InputDecoder::ESCAPE_TIMEOUT_MS;
+        }
+
+        const int ready = poll(fds, 2, timeout);
+        if (ready < 0 && errno != EINTR) {
+            return;
+        }
+        const auto now = std::chrono::steady_clock::now();
+
+        if (ready == 0 && decoder.isPending()) {
+            // Nothing followed the ESC in time: it was the Escape key
+            const int key = decoder.flush();
+            if (key != KEY_NONE) {
+                push(key, now);
+            }
+            continue;
+        }
+        if (ready <= 0 || !(fds[0].revents & (POLLIN | POLLHUP | POLLERR))) {
+            continue;
+        }
+
+        // Everything that has arrived, in one read (the terminal may be in
+        // non-blocking mode, so a spurious wakeup just reads nothing)
+        const ssize_t n = read(fd_, bytes, sizeof(bytes));
+        if (n == 0 || (n < 0 && errno != EAGAIN && errno != EINTR)) {
+            readable = false;
+            const int key = decoder.flush();
+            if (key != KEY_NONE) {
+                push(key, now);
+            }
+            continue;
+        }
+        for (ssize_t i = 0; i < n; ++i) {
+            const int key = decoder.feed(bytes[i]);
+            if (key != KEY_NONE) {
+                push(key, now);
+            }
+        }
+    }
+}
@@ -0,0 +1,105 @@
+#include "MappedFile.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Construction
+
+MappedFile::MappedFile(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error_ = path + ": " + std::strerror(errno);
+        return;
+    }
+
+    struct stat info {};
+    if (fstat(fd, &info) != 0) {
+        error_ = path + ": " + std::strerror(errno);
+        close(fd);
+        return;
+    }
+
+    opened_ = true;
+    size_ = static_cast<std::size_t>(info.st_size);
+
+    // mmap of zero bytes is an error; an empty file is simply empty
+    if (size_ > 0) {
+        void* mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            error_ = path + ": " + std::strerror(errno);
+            opened_ = false;
+            size_ = 0;
+        } else {
+            data_ = static_cast<const std::uint8_t*>(mapping);
+        }
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    close(fd);
+}
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_{other.data_}, size_{other.size_}, opened_{other.opened_},
+      error_{std::move(other.error_)} {
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.opened_ = false;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        data_ = other.data_;
+        size_ = other.size_;
+        opened_ = other.opened_;
+        error_ = std::move(other.error_);
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.opened_ = false;
+    }
+    return *this;
+}
+
+// Mapping Management
+
+void MappedFile::adviseSequential() const {
+    if (data_) {
+        madvise(const_cast<std::uint8_t*>(data_), size_, MADV_SEQUENTIAL);
+    }
+}
+
+void MappedFile::adviseRandom() const {
+    if (data_) {
+        madvise(const_cast<std::uint8_t*>(data_), size_, MADV_RANDOM);
+    }
+}
+
+void MappedFile::dropPages(std::size_t offset, std::size_t length) const {
+    if (!data_ || offset >= size_) {
+        return;
+    }
+    const std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    std::size_t begin = (offset + page - 1) / page * page;
+    std::size_t end = std::min(offset + length, size_) / page * page;
+    if (begin < end) {
+        madvise(const_cast<std::uint8_t*>(data_) + begin, end - begin, MADV_DONTNEED);
+    }
+}
+
+void MappedFile::release() {
+    if (data_) {
+        munmap(const_cast<std::uint8_t*>(data_), size_);
+        data_ = nullptr;
+    }
+    size_ = 0;
+    opened_ = false;
+}
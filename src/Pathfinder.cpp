@@ -0,0 +1,357 @@
+#include "Pathfinder.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+
+// Construction
+
+Pathfinder::Pathfinder(int rows, int cols)
+    : rows_{rows}, cols_{cols},
+      walkable_(static_cast<std::size_t>(rows) * cols, 0),
+      wordsPerRow_{cols / 64 + 1},
+      bits_(static_cast<std::size_t>(rows + 2) * wordsPerRow_, 0),
+      gScore_(walkable_.size(), 0),
+      parent_(walkable_.size(), NONE),
+      openStamp_(walkable_.size(), 0),
+      closedStamp_(walkable_.size(), 0) {
+    open_.reserve(walkable_.size());
+    cache_.reserve(MAX_CACHED_GOALS);
+}
+
+// Walls
+
+void Pathfinder::setWalkable(int row, int col, bool walkable) {
+    if (!contains(row, col)) {
+        return;
+    }
+    std::uint8_t& tile = walkable_[worldCell({row, col})];
+    if ((tile != 0) != walkable) {
+        tile = walkable ? 1 : 0;
+        setBit(row - originRow_, col - originCol_, walkable);
+        mapVersion_++;
+    }
+}
+
+void Pathfinder::rebuildBits() {
+    std::fill(bits_.begin(), bits_.end(), 0);
+    for (int r = 0; r < rows_; ++r) {
+        for (int c = 0; c < cols_; ++c) {
+            if (walkable_[cellIndex(r, c)]) {
+                setBit(r, c, true);
+            }
+        }
+    }
+}
+
+void Pathfinder::setBit(int row, int col, bool walkable) {
+    std::uint64_t& word = bits_[static_cast<std::size_t>(row + 1) * wordsPerRow_ + col / 64];
+    std::uint64_t mask = std::uint64_t{1} << (col % 64);
+    word = walkable ? (word | mask) : (word & ~mask);
+}
+
+// Search
+
+// Heap order: the front is the entry with the lowest f, and among equal f
+// the highest g
+bool Pathfinder::openAfter(const OpenEntry& a, const OpenEntry& b) {
+    return a.f != b.f ? a.f > b.f : a.g < b.g;
+}
+
+int Pathfinder::heuristic(std::size_t cell) const {
+    PathNode a = nodeAt(cell);
+    PathNode b = nodeAt(goalCell_);
+    return std::abs(a.row - b.row) + std::abs(a.col - b.col);
+}
+
+bool Pathfinder::findPath(PathNode start, PathNode goal, std::vector<PathNode>& path) {
+    path.clear();
+    if (!contains(start.row, start.col) || !isWalkable(goal.row, goal.col)) {
+        return false;
+    }
+
+    const std::size_t startCell = worldCell(start);
+    const std::size_t goalCell = worldCell(goal);
+    if (!search(startCell, goalCell)) {
+        return false;
+    }
+
+    // Walk parents back from the goal, filling in the straight runs
+    // between jump points (plain A* parents are always one step apart)
+    std::size_t cell = goalCell;
+    while (true) {
+        PathNode at = worldNode(cell);
+        path.push_back(at);
+        if (cell == startCell) {
+            break;
+        }
+        PathNode from = worldNode(parent_[cell]);
+        int dRow = (from.row > at.row) - (from.row < at.row);
+        int dCol = (from.col > at.col) - (from.col < at.col);
+        for (int r = at.row + dRow, c = at.col + dCol; r != from.row || c != from.col;
+             r += dRow, c += dCol) {
+            path.push_back({r, c});
+        }
+        cell = parent_[cell];
+    }
+    std::reverse(path.begin(), path.end());
+    return true;
+}
+
+bool Pathfinder::search(std::size_t start, std::size_t goal) {
+    // New stamp invalidates every entry from the previous search
+    if (++searchStamp_ == 0) {
+        std::fill(openStamp_.begin(), openStamp_.end(), 0);
+        std::fill(closedStamp_.begin(), closedStamp_.end(), 0);
+        searchStamp_ = 1;
+    }
+    stats_.searches++;
+    goalCell_ = goal;
+    open_.clear();
+
+    gScore_[start] = 0;
+    parent_[start] = NONE;
+    openStamp_[start] = searchStamp_;
+    open_.push_back({heuristic(start), 0, static_cast<std::uint32_t>(start)});
+
+    while (!open_.empty()) {
+        std::pop_heap(open_.begin(), open_.end(), openAfter);
+        const OpenEntry top = open_.back();
+        open_.pop_back();
+
+        // Stale duplicate (a cheaper entry was already expanded)
+        if (closedStamp_[top.cell] == searchStamp_) {
+            continue;
+        }
+        closedStamp_[top.cell] = searchStamp_;
+        stats_.nodesExpanded++;
+
+        if (top.cell == goal) {
+            return true;
+        }
+
+        if (jumpPoints_) {
+            expandJumpPoints(top.cell, top.g);
+            continue;
+        }
+
+        const PathNode at = nodeAt(top.cell);
+        if (open(at.row - 1, at.col)) pushOpen(top.cell, top.cell - cols_, top.g + 1);
+        if (open(at.row + 1, at.col)) pushOpen(top.cell, top.cell + cols_, top.g + 1);
+        if (open(at.row, at.col - 1)) pushOpen(top.cell, top.cell - 1, top.g + 1);
+        if (open(at.row, at.col + 1)) pushOpen(top.cell, top.cell + 1, top.g + 1);
+    }
+    return false;
+}
+
+void Pathfinder::pushOpen(std::size_t from, std::size_t to, std::int32_t g) {
+    if (closedStamp_[to] == searchStamp_) {
+        return;
+    }
+    if (openStamp_[to] == searchStamp_ && gScore_[to] <= g) {
+        return;
+    }
+    openStamp_[to] = searchStamp_;
+    gScore_[to] = g;
+    parent_[to] = static_cast<std::uint32_t>(from);
+    open_.push_back({g + heuristic(to), g, static_cast<std::uint32_t>(to)});
+    std::push_heap(open_.begin(), open_.end(), openAfter);
+}
+
+// Jump Point Search
+
+// Successors depend on how the tile was entered:
+//   - start: all four directions
+//   - horizontally: keep going, or turn up/down
+//   - vertically: keep going, or turn left/right
+void Pathfinder::expandJumpPoints(std::size_t cell, std::int32_t g) {
+    const PathNode at = nodeAt(cell);
+    bool horizontal = true;
+    bool vertical = true;
+    int dRow = 0;
+    int dCol = 0;
+    if (parent_[cell] != NONE) {
+        PathNode from = nodeAt(parent_[cell]);
+        dRow = (at.row > from.row) - (at.row < from.row);
+        dCol = (at.col > from.col) - (at.col < from.col);
+    }
+
+    auto add = [&](std::uint32_t jump) {
+        if (jump != NONE) {
+            PathNode to = nodeAt(jump);
+            int steps = std::abs(to.row - at.row) + std::abs(to.col - at.col);
+            pushOpen(cell, jump, g + steps);
+        }
+    };
+
+    if (dCol != 0) {
+        // Entered horizontally: no reversing
+        add(jumpHorizontal(at.row, at.col, dCol));
+        horizontal = false;
+    }
+    if (dRow != 0) {
+        // Entered vertically: no reversing
+        add(jumpVertical(at.row, at.col, dRow));
+        vertical = false;
+    }
+    if (horizontal) {
+        add(jumpHorizontal(at.row, at.col, -1));
+        add(jumpHorizontal(at.row, at.col, 1));
+    }
+    if (vertical) {
+        add(jumpVertical(at.row, at.col, -1));
+        add(jumpVertical(at.row, at.col, 1));
+    }
+}
+
+// Run sideways until the goal, a wall, or a tile where stepping up or
+// down becomes possible for the first time (the tile behind was blocked).
+// Each word answers 64 tiles: a stop bit is set for walls and for tiles
+// whose row above/below is open while the previous tile's is not.
+std::uint32_t Pathfinder::jumpHorizontal(int row, int col, int dCol) const {
+    const int goalRow = static_cast<int>(goalCell_ / cols_);
+    const int goalCol = static_cast<int>(goalCell_ % cols_);
+    int x = col + dCol;
+
+    while (x >= 0) {
+        const int w = x / 64;
+        const int b = x % 64;
+        const std::uint64_t here = bitWord(row, w);
+        const std::uint64_t up = bitWord(row - 1, w);
+        const std::uint64_t down = bitWord(row + 1, w);
+
+        std::uint64_t stop;
+        if (dCol > 0) {
+            // Bit i of *Behind = the tile at i - 1
+            std::uint64_t upBehind = (up << 1) | (bitWord(row - 1, w - 1) >> 63);
+            std::uint64_t downBehind = (down << 1) | (bitWord(row + 1, w - 1) >> 63);
+            stop = ~here | (up & ~upBehind) | (down & ~downBehind);
+            stop &= ~std::uint64_t{0} << b;
+        } else {
+            // Bit i of *Behind = the tile at i + 1
+            std::uint64_t upBehind = (up >> 1) | (bitWord(row - 1, w + 1) << 63);
+            std::uint64_t downBehind = (down >> 1) | (bitWord(row + 1, w + 1) << 63);
+            stop = ~here | (up & ~upBehind) | (down & ~downBehind);
+            stop &= b == 63 ? ~std::uint64_t{0} : (std::uint64_t{1} << (b + 1)) - 1;
+        }
+        if (row == goalRow && goalCol / 64 == w) {
+            std::uint64_t goalBit = std::uint64_t{1} << (goalCol % 64);
+            if (dCol > 0 ? goalCol >= x : goalCol <= x) {
+                stop |= goalBit;
+            }
+        }
+
+        if (stop) {
+            int hit = w * 64 + (dCol > 0 ? std::countr_zero(stop) : 63 - std::countl_zero(stop));
+            if (!((here >> (hit % 64)) & 1)) {
+                return NONE;
+            }
+            return static_cast<std::uint32_t>(cellIndex(row, hit));
+        }
+        x = dCol > 0 ? (w + 1) * 64 : w * 64 - 1;
+    }
+    return NONE;
+}
+
+// Run up or down; stop on the goal or wherever a horizontal run from the
+// tile finds a jump point
+std::uint32_t Pathfinder::jumpVertical(int row, int col, int dRow) const {
+    while (true) {
+        row += dRow;
+        if (!open(row, col)) {
+            return NONE;
+        }
+        std::size_t cell = cellIndex(row, col);
+        if (cell == goalCell_ ||
+            jumpHorizontal(row, col, -1) != NONE || jumpHorizontal(row, col, 1) != NONE) {
+            return static_cast<std::uint32_t>(cell);
+        }
+    }
+}
+
+// Path Cache
+
+const Pathfinder::GoalCache* Pathfinder::findCache(std::size_t goal) const {
+    for (const GoalCache& entry : cache_) {
+        if (entry.goal == goal) {
+            return entry.version == mapVersion_ ? &entry : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+// Existing entry for the goal (emptied if stale), else a new or recycled one
+Pathfinder::GoalCache& Pathfinder::cacheFor(std::size_t goal) {
+    GoalCache* slot = nullptr;
+    for (GoalCache& entry : cache_) {
+        if (entry.goal == goal) {
+            slot = &entry;
+            break;
+        }
+    }
+    if (!slot) {
+        if (cache_.size() < MAX_CACHED_GOALS) {
+            cache_.push_back({static_cast<std::uint32_t>(goal), mapVersion_, 0, {}});
+            slot = &cache_.back();
+        } else {
+            slot = &*std::min_element(cache_.begin(), cache_.end(),
+                [](const GoalCache& a, const GoalCache& b) { return a.lastUsed < b.lastUsed; });
+            slot->goal = static_cast<std::uint32_t>(goal);
+            slot->next.clear();
+        }
+    }
+    if (slot->version != mapVersion_) {
+        slot->version = mapVersion_;
+        slot->next.clear();
+    }
+    slot->lastUsed = ++useCounter_;
+    return *slot;
+}
+
+Pathfinder::StepResult Pathfinder::cachedStep(PathNode from, PathNode goal, PathNode& next) const {
+    if (from == goal) {
+        return StepResult::Arrived;
+    }
+    if (!contains(from.row, from.col) || !contains(goal.row, goal.col)) {
+        return StepResult::NoPath;
+    }
+    const GoalCache* entry = findCache(worldCell(goal));
+    if (!entry) {
+        return StepResult::Unknown;
+    }
+    auto it = entry->next.find(static_cast<std::uint32_t>(worldCell(from)));
+    if (it == entry->next.end()) {
+        return StepResult::Unknown;
+    }
+    if (it->second == NONE) {
+        return StepResult::NoPath;
+    }
+    next = worldNode(it->second);
+    return StepResult::Step;
+}
+
+Pathfinder::StepResult Pathfinder::nextStep(PathNode from, PathNode goal, PathNode& next) {
+    StepResult cached = cachedStep(from, goal, next);
+    if (cached != StepResult::Unknown) {
+        if (cached == StepResult::Step) {
+            stats_.cacheHits++;
+            cacheFor(worldCell(goal));  // Mark recently used
+        }
+        return cached;
+    }
+
+    // Miss: search, then remember the successor of every tile on the path
+    thread_local std::vector<PathNode> path;
+    const bool found = findPath(from, goal, path);
+    GoalCache& entry = cacheFor(worldCell(goal));
+    if (!found) {
+        entry.next[static_cast<std::uint32_t>(worldCell(from))] = NONE;
+        return StepResult::NoPath;
+    }
+    for (std::size_t i = 0; i + 1 < path.size(); ++i) {
+        entry.next[static_cast<std::uint32_t>(worldCell(path[i]))] =
+            static_cast<std::uint32_t>(worldCell(path[i + 1]));
+    }
+    next = path[1];
+    return StepResult::Step;
+}
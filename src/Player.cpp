@@ -1,20 +1,20 @@
 #include "Player.hpp"
 #include "GameState.hpp"
-#include <iostream>
+#include "CombatKernel.hpp"
+#include "EventLog.hpp"
+#include "TileMap.hpp"
 
 // Movement Implementation
 
-// Check if a position is within valid map boundaries
-// Map has walls at edges: row [1, 18] and col [1, 38] are playable
-bool canMoveTo(int row, int col) {
-    // Check against map boundaries (accounting for walls at edges)
-    return row >= 1 && row < GameState::MAP_ROWS - 1 &&
-           col >= 1 && col < GameState::MAP_COLS - 1;
+// Check if a position is open floor
+// Walls (including the map edge) come from the tile map
+bool canMoveTo(const TileMap& map, int row, int col) {
+    return map.isWalkable(row, col);
 }
 
 // Move player based on directional input
 // Uses WASD controls: W=up, A=left, S=down, D=right
-void movePlayer(Player& player, char direction) {
+void movePlayer(Player& player, const TileMap& map, char direction) {
     // Store current position in case we need to revert
     int oldRow = player.row;
     int oldCol = player.col;
@@ -40,7 +40,7 @@ void movePlayer(Player& player, char direction) {
     }
 
     // Validate the new position - if invalid, revert to old position
-    if (!canMoveTo(player.row, player.col)) {
+    if (!canMoveTo(map, player.row, player.col)) {
         player.row = oldRow;
         player.col = oldCol;
     }
@@ -49,49 +49,47 @@ void movePlayer(Player& player, char direction) {
 // Combat Implementation
 
 // Player initiates attack on an enemy
-void attackEnemy(Player& player, Enemy& enemy) {
+void attackEnemy(Player& player, EnemyStore& enemies, std::size_t index, EventLog& log) {
     // Only attack if enemy is alive
-    if (!enemy.isAlive) {
+    if (!enemies.alive[index]) {
         return;
     }
 
-    // Display attack message
-    std::cout << "\n[COMBAT] Player attacks enemy for "
-              << player.attack << " damage!\n";
+    log.push(LogEventType::PlayerAttack, player.attack);
 
     // Apply damage to enemy
-    enemy.health -= player.attack;
+    enemies.health[index] -= player.attack;
+    enemies.markChanged(index);
 
     // Check if enemy died from the attack
-    if (enemy.health <= 0) {
-        enemy.health = 0;
-        enemy.isAlive = false;
-        std::cout << "[COMBAT] Enemy defeated!\n";
+    if (enemies.health[index] <= 0) {
+        enemies.health[index] = 0;
+        enemies.release(index);
+        log.push(LogEventType::EnemyDefeated);
 
         // Grant experience for the kill
         const int EXPERIENCE_REWARD = 25;
-        grantExperience(player, EXPERIENCE_REWARD);
+        grantExperience(player, EXPERIENCE_REWARD, log);
 
         return;  // Enemy is dead, no counter-attack
     }
 
     // Enemy survived - counter-attack the player
-    enemyAttacksPlayer(enemy, player);
+    enemyAttacksPlayer(enemies, index, player, log);
 }
 
 // Enemy counter-attacks the player
-void enemyAttacksPlayer(const Enemy& enemy, Player& player) {
+void enemyAttacksPlayer(const EnemyStore& enemies, std::size_t index, Player& player,
+                        EventLog& log) {
     // Only attack if enemy is alive
-    if (!enemy.isAlive) {
+    if (!enemies.alive[index]) {
         return;
     }
 
-    // Display counter-attack message
-    std::cout << "[COMBAT] Enemy attacks back for "
-              << enemy.attack << " damage!\n";
+    log.push(LogEventType::EnemyAttack, enemies.attack[index]);
 
     // Apply damage to player
-    player.health -= enemy.attack;
+    player.health -= enemies.attack[index];
 
     // Ensure health doesn't go below zero
     if (player.health < 0) {
@@ -99,6 +97,43 @@ void enemyAttacksPlayer(const Enemy& enemy, Player& player) {
     }
 }
 
+// Apply a batched combat round: state changes first, log afterwards
+void applyCombatResult(Player& player, EnemyStore& enemies, const CombatResult& result,
+                       EventLog& log) {
+    if (result.struck.empty()) {
+        return;
+    }
+
+    // Experience for each kill (same reward as a single fight)
+    const int EXPERIENCE_REWARD = 25;
+
+    // Killed enemies leave the world and their slots go back to the pool
+    for (std::uint32_t index : result.killed) {
+        enemies.release(index);
+    }
+
+    // Counter-attacks from every survivor land together
+    player.health -= result.damageToPlayer;
+    if (player.health < 0) {
+        player.health = 0;
+    }
+
+    // Combat log, written after the numbers are settled
+    for (std::uint32_t index : result.struck) {
+        log.push(LogEventType::PlayerAttack, player.attack);
+        if (enemies.health[index] == 0) {
+            log.push(LogEventType::EnemyDefeated);
+        } else {
+            log.push(LogEventType::EnemyAttack, enemies.attack[index]);
+        }
+    }
+
+    // Rewards last - a level up may change player.attack for next round
+    if (!result.killed.empty()) {
+        grantExperience(player, EXPERIENCE_REWARD * static_cast<int>(result.killed.size()), log);
+    }
+}
+
 // Check if player is still alive
 bool isPlayerAlive(const Player& player) {
     return player.health > 0;
@@ -114,21 +149,20 @@ int experienceForNextLevel(const Player& player) {
 }
 
 // Grant experience points to player and check for level up
-void grantExperience(Player& player, int amount) {
+void grantExperience(Player& player, int amount, EventLog& log) {
     player.experience += amount;
-    std::cout << "[XP] Gained " << amount << " experience! ("
-              << player.experience << "/"
-              << experienceForNextLevel(player) << ")\n";
+    log.push(LogEventType::ExperienceGained, amount, player.experience,
+             experienceForNextLevel(player));
 
     // Check if player has enough XP to level up
     while (player.experience >= experienceForNextLevel(player)) {
         player.experience -= experienceForNextLevel(player);
-        levelUpPlayer(player);
+        levelUpPlayer(player, log);
     }
 }
 
 // Level up the player, improving their stats
-void levelUpPlayer(Player& player) {
+void levelUpPlayer(Player& player, EventLog& log) {
     player.level++;
 
     // Stat increases per level
@@ -143,15 +177,11 @@ void levelUpPlayer(Player& player) {
     player.attack += ATTACK_INCREASE;
 
     // Notify player of level up
-    std::cout << "\n*** LEVEL UP! ***\n";
-    std::cout << "Level: " << player.level << "\n";
-    std::cout << "Max Health: " << player.maxHealth << " (+" << HEALTH_INCREASE << ")\n";
-    std::cout << "Attack: " << player.attack << " (+" << ATTACK_INCREASE << ")\n";
-    std::cout << "****************\n\n";
+    log.push(LogEventType::LevelUp, player.level, player.maxHealth, player.attack);
 }
 
 // Restore player health by specified amount
-void healPlayer(Player& player, int amount) {
+void healPlayer(Player& player, int amount, EventLog& log) {
     // Store old health to show how much was healed
     int oldHealth = player.health;
 
@@ -166,8 +196,8 @@ void healPlayer(Player& player, int amount) {
     // Calculate actual amount healed
     int actualHealing = player.health - oldHealth;
 
-    // Display healing message
+    // Report healing message
     if (actualHealing > 0) {
-        std::cout << "[HEAL] Restored " << actualHealing << " health points!\n";
+        log.push(LogEventType::Healed, actualHealing);
     }
 }
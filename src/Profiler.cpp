@@ -0,0 +1,341 @@
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Names
+
+const char* profilePhaseName(ProfilePhase phase) {
+    switch (phase) {
+        case ProfilePhase::Frame:      return "frame";
+        case ProfilePhase::Input:      return "input";
+        case ProfilePhase::Tick:       return "tickGame";
+        case ProfilePhase::MovePlayer: return "movePlayer";
+        case ProfilePhase::UpdateGame: return "updateGame";
+        case ProfilePhase::EnemyAI:    return "updateEnemyAI";
+        case ProfilePhase::Combat:     return "combat";
+        case ProfilePhase::Autosave:   return "autosave";
+        case ProfilePhase::Publish:    return "publish";
+        case ProfilePhase::Sleep:      return "sleep";
+        case ProfilePhase::Render:     return "printMap";
+        case ProfilePhase::Compose:    return "composeMap";
+        case ProfilePhase::Present:    return "present";
+        case ProfilePhase::Count:      break;
+    }
+    return "?";
+}
+
+const char* profileCounterName(ProfileCounter counter) {
+    switch (counter) {
+        case ProfileCounter::BytesWritten: return "bytesWritten";
+        case ProfileCounter::CellsChanged: return "cellsChanged";
+        case ProfileCounter::Count:        break;
+    }
+    return "?";
+}
+
+// Unit of a counter's values (CSV column)
+static const char* profileCounterUnit(ProfileCounter counter) {
+    switch (counter) {
+        case ProfileCounter::BytesWritten: return "bytes";
+        case ProfileCounter::CellsChanged: return "cells";
+        case ProfileCounter::Count:        break;
+    }
+    return "";
+}
+
+// Histogram
+
+int ProfileHistogram::bucketOf(std::uint64_t value) {
+    if (value < 16) {
+        return static_cast<int>(value);
+    }
+    // Top bit picks the power of two, the next three bits the eighth of it
+    const int exponent = std::bit_width(value) - 1;
+    const int eighth = static_cast<int>((value >> (exponent - 3)) & 7);
+    return 16 + (exponent - 4) * 8 + eighth;
+}
+
+std::uint64_t ProfileHistogram::bucketValue(int bucket) {
+    if (bucket < 16) {
+        return static_cast<std::uint64_t>(bucket);
+    }
+    const int exponent = (bucket - 16) / 8 + 4;
+    const std::uint64_t eighth = static_cast<std::uint64_t>((bucket - 16) % 8);
+    const std::uint64_t width = std::uint64_t{1} << (exponent - 3);
+    return (8 + eighth) * width + width / 2;  // Middle of the bucket
+}
+
+void ProfileHistogram::add(std::uint64_t value) {
+    // Only the owning thread writes, so load + store cannot lose an update
+    std::atomic<std::uint64_t>& bucket = buckets_[bucketOf(value)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    total_.store(total_.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    if (value > max_.load(std::memory_order_relaxed)) {
+        max_.store(value, std::memory_order_relaxed);
+    }
+}
+
+void ProfileHistogram::clear() {
+    for (std::atomic<std::uint64_t>& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    total_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+// Per-Thread Buffers
+
+namespace {
+
+constexpr std::size_t PHASES = static_cast<std::size_t>(ProfilePhase::Count);
+constexpr std::size_t METRICS = PHASES + static_cast<std::size_t>(ProfileCounter::Count);
+
+std::size_t metricOf(ProfileCounter counter) {
+    return PHASES + static_cast<std::size_t>(counter);
+}
+
+// One span (metric < PHASES: value is its duration) or counter sample
+struct ProfileRecord {
+    std::uint64_t start;   // ns since the epoch
+    std::uint64_t value;
+    std::uint8_t metric;
+};
+
+// Everything one thread has recorded; written by that thread only
+struct ThreadProfile {
+    explicit ThreadProfile(std::uint32_t threadId)
+        : id{threadId}, records{std::make_unique<ProfileRecord[]>(Profiler::TRACE_CAPACITY)} {}
+
+    std::uint32_t id;
+    std::string name;                            // Guarded by the registry mutex
+    std::unique_ptr<ProfileRecord[]> records;    // Ring of the newest spans
+    std::atomic<std::uint64_t> written{0};       // Records ever added
+    std::array<ProfileHistogram, METRICS> histograms;
+
+    void add(std::size_t metric, std::uint64_t start, std::uint64_t value) {
+        const std::uint64_t n = written.load(std::memory_order_relaxed);
+        records[n & (Profiler::TRACE_CAPACITY - 1)] =
+            ProfileRecord{start, value, static_cast<std::uint8_t>(metric)};
+        written.store(n + 1, std::memory_order_release);
+        histograms[metric].add(value);
+    }
+};
+
+struct Registry {
+    std::mutex mutex;                                     // Guards threads and names
+    std::vector<std::unique_ptr<ThreadProfile>> threads;  // Never shrinks
+    std::array<std::atomic<std::uint64_t>, METRICS> last{};  // Newest sample per metric
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+const std::chrono::steady_clock::time_point EPOCH = std::chrono::steady_clock::now();
+
+// The calling thread's buffer, created (and its name applied) on first use,
+// so threads that never record while profiling is on cost no memory
+thread_local ThreadProfile* currentThread = nullptr;
+thread_local const char* currentThreadName = nullptr;
+
+ThreadProfile& thisThread() {
+    if (!currentThread) {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock{r.mutex};
+        const auto id = static_cast<std::uint32_t>(r.threads.size() + 1);
+        r.threads.push_back(std::make_unique<ThreadProfile>(id));
+        currentThread = r.threads.back().get();
+        currentThread->name = currentThreadName ? currentThreadName
+                                                : "thread " + std::to_string(id);
+    }
+    return *currentThread;
+}
+
+ProfileSummary summarize(std::size_t metric) {
+    Registry& r = registry();
+    std::array<std::uint64_t, ProfileHistogram::BUCKETS> buckets{};
+    ProfileSummary summary;
+    {
+        std::lock_guard<std::mutex> lock{r.mutex};
+        for (const std::unique_ptr<ThreadProfile>& thread : r.threads) {
+            const ProfileHistogram& histogram = thread->histograms[metric];
+            for (int b = 0; b < ProfileHistogram::BUCKETS; ++b) {
+                buckets[b] += histogram.count(b);
+            }
+            summary.total += histogram.total();
+            summary.max = std::max(summary.max, histogram.max());
+        }
+    }
+    summary.last = r.last[metric].load(std::memory_order_relaxed);
+    for (std::uint64_t count : buckets) {
+        summary.count += count;
+    }
+    if (summary.count == 0) {
+        return summary;
+    }
+
+    // Walk the buckets once, picking off each percentile as it is passed
+    const std::uint64_t ranks[3] = {(summary.count * 50 + 99) / 100,
+                                    (summary.count * 90 + 99) / 100,
+                                    (summary.count * 99 + 99) / 100};
+    std::uint64_t* outputs[3] = {&summary.p50, &summary.p90, &summary.p99};
+    std::uint64_t seen = 0;
+    int next = 0;
+    for (int b = 0; b < ProfileHistogram::BUCKETS && next < 3; ++b) {
+        seen += buckets[b];
+        while (next < 3 && seen >= ranks[next]) {
+            *outputs[next++] = std::min(ProfileHistogram::bucketValue(b), summary.max);
+        }
+    }
+    return summary;
+}
+
+}  // namespace
+
+// Recording
+
+std::uint64_t Profiler::now() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - EPOCH).count());
+}
+
+void Profiler::recordPhase(ProfilePhase phase, std::uint64_t start, std::uint64_t end) {
+    const auto metric = static_cast<std::size_t>(phase);
+    const std::uint64_t duration = end - start;
+    thisThread().add(metric, start, duration);
+    registry().last[metric].store(duration, std::memory_order_relaxed);
+}
+
+void Profiler::recordCounter(ProfileCounter counter, std::uint64_t value) {
+    const std::size_t metric = metricOf(counter);
+    thisThread().add(metric, now(), value);
+    registry().last[metric].store(value, std::memory_order_relaxed);
+}
+
+void Profiler::nameThread(const char* name) {
+    currentThreadName = name;
+    if (currentThread) {
+        std::lock_guard<std::mutex> lock{registry().mutex};
+        currentThread->name = name;
+    }
+}
+
+ProfileSummary Profiler::summary(ProfilePhase phase) {
+    return summarize(static_cast<std::size_t>(phase));
+}
+
+ProfileSummary Profiler::summary(ProfileCounter counter) {
+    return summarize(metricOf(counter));
+}
+
+void Profiler::reset() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock{r.mutex};
+    for (const std::unique_ptr<ThreadProfile>& thread : r.threads) {
+        thread->written.store(0, std::memory_order_relaxed);
+        for (ProfileHistogram& histogram : thread->histograms) {
+            histogram.clear();
+        }
+    }
+    for (std::atomic<std::uint64_t>& value : r.last) {
+        value.store(0, std::memory_order_relaxed);
+    }
+}
+
+// Export
+
+// Chrome trace_event format: one complete ("X") event per span, one counter
+// ("C") event per counter sample, and a thread_name record per thread.
+// Timestamps are in microseconds.
+bool Profiler::writeChromeTrace(const std::string& path, std::string& error) {
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        error = path + ": " + std::strerror(errno);
+        return false;
+    }
+
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock{r.mutex};
+    std::uint64_t overwritten = 0;
+    const char* separator = "\n";
+
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", file);
+    for (const std::unique_ptr<ThreadProfile>& thread : r.threads) {
+        std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+                     "\"args\":{\"name\":\"%s\"}}",
+                     separator, thread->id, thread->name.c_str());
+        separator = ",\n";
+
+        const std::uint64_t end = thread->written.load(std::memory_order_acquire);
+        const std::uint64_t begin = end > TRACE_CAPACITY ? end - TRACE_CAPACITY : 0;
+        overwritten += begin;
+        for (std::uint64_t i = begin; i < end; ++i) {
+            const ProfileRecord& record = thread->records[i & (TRACE_CAPACITY - 1)];
+            const double ts = static_cast<double>(record.start) / 1000.0;
+            if (record.metric < PHASES) {
+                std::fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                             "\"pid\":1,\"tid\":%u}",
+                             profilePhaseName(static_cast<ProfilePhase>(record.metric)), ts,
+                             static_cast<double>(record.value) / 1000.0, thread->id);
+            } else {
+                std::fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"C\",\"ts\":%.3f,"
+                             "\"pid\":1,\"tid\":%u,\"args\":{\"value\":%llu}}",
+                             profileCounterName(static_cast<ProfileCounter>(record.metric - PHASES)),
+                             ts, thread->id, static_cast<unsigned long long>(record.value));
+            }
+        }
+    }
+    std::fprintf(file, "\n],\"otherData\":{\"spansOverwritten\":%llu}}\n",
+                 static_cast<unsigned long long>(overwritten));
+
+    const bool ok = !std::ferror(file);
+    if (std::fclose(file) != 0 || !ok) {
+        error = path + ": write failed";
+        return false;
+    }
+    return true;
+}
+
+// One row per phase (times in microseconds) and per counter
+bool Profiler::writeCsv(const std::string& path, std::string& error) {
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        error = path + ": " + std::strerror(errno);
+        return false;
+    }
+
+    std::fputs("kind,name,unit,count,total,mean,p50,p90,p99,max\n", file);
+    for (std::size_t p = 0; p < PHASES; ++p) {
+        const ProfileSummary s = summary(static_cast<ProfilePhase>(p));
+        std::fprintf(file, "phase,%s,us,%llu,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n",
+                     profilePhaseName(static_cast<ProfilePhase>(p)),
+                     static_cast<unsigned long long>(s.count), s.total / 1000.0, s.mean() / 1000.0,
+                     s.p50 / 1000.0, s.p90 / 1000.0, s.p99 / 1000.0, s.max / 1000.0);
+    }
+    for (std::size_t c = 0; c < METRICS - PHASES; ++c) {
+        const ProfileSummary s = summary(static_cast<ProfileCounter>(c));
+        std::fprintf(file, "counter,%s,%s,%llu,%llu,%.3f,%llu,%llu,%llu,%llu\n",
+                     profileCounterName(static_cast<ProfileCounter>(c)),
+                     profileCounterUnit(static_cast<ProfileCounter>(c)),
+                     static_cast<unsigned long long>(s.count),
+                     static_cast<unsigned long long>(s.total), s.mean(),
+                     static_cast<unsigned long long>(s.p50), static_cast<unsigned long long>(s.p90),
+                     static_cast<unsigned long long>(s.p99), static_cast<unsigned long long>(s.max));
+    }
+
+    const bool ok = !std::ferror(file);
+    if (std::fclose(file) != 0 || !ok) {
+        error = path + ": write failed";
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,64 @@
+#include "Random.hpp"
+
+// Seeding and Streams
+
+void Rng::reseed(std::uint64_t seed) {
+    // SplitMix64 sequence; never yields the all-zero state
+    for (std::uint64_t& word : s_) {
+        seed += 0x9E3779B97F4A7C15ull;
+        word = mixBits(seed);
+    }
+}
+
+void Rng::jump() {
+    static constexpr std::uint64_t JUMP[] = {
+        0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull,
+        0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull,
+    };
+    std::uint64_t jumped[4] = {0, 0, 0, 0};
+    for (std::uint64_t word : JUMP) {
+        for (int bit = 0; bit < 64; ++bit) {
+            if (word & (std::uint64_t{1} << bit)) {
+                for (int i = 0; i < 4; ++i) {
+                    jumped[i] ^= s_[i];
+                }
+            }
+            next();
+        }
+    }
+    for (int i = 0; i < 4; ++i) {
+        s_[i] = jumped[i];
+    }
+}
+
+Rng Rng::forStream(std::uint64_t seed, std::uint64_t stream) {
+    Rng rng{seed};
+    for (std::uint64_t i = 0; i < stream; ++i) {
+        rng.jump();
+    }
+    return rng;
+}
+
+// Bulk
+
+void Rng::fill(std::uint64_t* out, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = next();
+    }
+}
+
+// Two draws per 64-bit value: the high and low halves are each a full
+// 32-bit sample, rejected separately in the rare biased zone
+void Rng::fillBelow(std::uint32_t* out, std::size_t count, std::uint32_t bound) {
+    const std::uint32_t threshold = static_cast<std::uint32_t>(-bound) % bound;
+    std::size_t i = 0;
+    while (i < count) {
+        const std::uint64_t bits = next();
+        for (int half = 0; half < 2 && i < count; ++half) {
+            const std::uint64_t product = (half ? (bits & 0xFFFFFFFFu) : (bits >> 32)) * bound;
+            if (static_cast<std::uint32_t>(product) >= threshold) {
+                out[i++] = static_cast<std::uint32_t>(product >> 32);
+            }
+        }
+    }
+}
@@ -1,8 +1,117 @@
 #include "Renderer.hpp"
+#include "Camera.hpp"
 #include "GameState.hpp"
+#include "Profiler.hpp"
 #include "Enemy.hpp"
+#include "CellGrid.hpp"
+#include "RenderSnapshot.hpp"
+#include "TerminalRenderer.hpp"
+#include "TileMap.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
+// Frame Layout
+
+// HUD lines drawn below the map (stats, then the message panel), and the
+// frame width needed to fit them
+static constexpr int LOG_PANEL_ROWS = 6;  // Separator plus the 5 newest messages
+static constexpr int HUD_ROWS = 8 + LOG_PANEL_ROWS;
+static constexpr int FRAME_ROWS = GameState::MAP_ROWS + HUD_ROWS;
+static constexpr int FRAME_COLS = GameState::MAP_COLS > 60 ? GameState::MAP_COLS : 60;
+
+int frameRows() {
+    return FRAME_ROWS;
+}
+
+int frameCols() {
+    return FRAME_COLS;
+}
+
+// Frame size for a backend: its own if it asks for one, else the default
+static void frameSize(RenderBackend& backend, int& rows, int& cols) {
+    rows = FRAME_ROWS;
+    cols = FRAME_COLS;
+    if (backend.preferredSize(rows, cols)) {
+        // At least one map row above the HUD
+        rows = std::max(rows, HUD_ROWS + 1);
+    }
+}
+
+void mapViewSize(RenderBackend& backend, int& rows, int& cols) {
+    frameSize(backend, rows, cols);
+    rows -= HUD_ROWS;
+}
+
+// Scratch frame for the calling thread, reused across calls
+// Parameters:
+//   - backend: Device the frame is for; it may ask for its own size
+static CellGrid& scratchFrame(RenderBackend& backend) {
+    int rows;
+    int cols;
+    frameSize(backend, rows, cols);
+    thread_local CellGrid frame{FRAME_ROWS, FRAME_COLS};
+    if (frame.rows() != rows || frame.cols() != cols) {
+        frame = CellGrid{rows, cols};
+    }
+    return frame;
+}
+
+// Camera for the calling thread, kept between frames so it can scroll
+static Camera& followCamera() {
+    thread_local Camera camera{GameState::MAP_ROWS, GameState::MAP_COLS};
+    return camera;
+}
+
+// Draw lines of text one per row, starting at the given row
+static void writeLines(CellGrid& frame, int row,
+                       std::initializer_list<const char*> lines) {
+    for (const char* line : lines) {
+        frame.writeText(row++, 0, line);
+    }
+}
+
+// Draw the victory banner with its top-left corner at (row, col)
+static void drawVictoryBanner(CellGrid& frame, int row, int col) {
+    const char* lines[] = {
+        "**************************************",
+        "*         VICTORY!                   *",
+        "*    The enemy has been defeated!    *",
+        "**************************************",
+    };
+    for (const char* line : lines) {
+        frame.writeText(row++, col, line);
+    }
+}
+
+#if GAME_PROFILING
+// Profiler readout across the top row of the map: the last simulation frame
+// and its percentiles, the slowest frames to draw, and the bytes the last
+// frame sent to the terminal (fits the default 60-column frame)
+static void drawProfileOverlay(CellGrid& frame) {
+    const ProfileSummary loop = Profiler::summary(ProfilePhase::Frame);
+    const ProfileSummary draw = Profiler::summary(ProfilePhase::Render);
+    const ProfileSummary bytes = Profiler::summary(ProfileCounter::BytesWritten);
+    char line[128];
+    std::snprintf(line, sizeof(line), " frame %.2fms p50 %.2f p99 %.2f | draw p99 %.2fms | %lluB ",
+                  loop.last / 1e6, loop.p50 / 1e6, loop.p99 / 1e6, draw.p99 / 1e6,
+                  static_cast<unsigned long long>(bytes.last));
+    frame.writeText(0, 0, line);
+}
+#endif
+
+// Backends
+
+// Terminal output device, shared by every frame so it can diff against
+// whatever the previous frame left on screen
+RenderBackend& terminalBackend() {
+    static TerminalRenderer renderer{FRAME_ROWS, FRAME_COLS};
+    return renderer;
+}
+
 // Screen Management
 
 // Clear terminal screen using ANSI escape codes
@@ -10,123 +119,255 @@
 void clearScreen() {
     // ANSI escape sequence: ESC[2J clears screen, ESC[H moves cursor to home
     std::cout << "\033[2J\033[H" << std::flush;
+
+    // The diff renderer's view of the screen is now stale
+    terminalBackend().invalidate();
 }
 
 // Map Rendering
 
-// Render the complete game state to terminal
-void printMap(const GameState& state) {
-    // Clear previous frame for smooth animation
-    clearScreen();
+// Capture the camera's window over the game state
+void captureRenderSnapshot(const GameState& state, Camera& camera, RenderSnapshot& out) {
+    const TileMap& map = *state.map;
+    camera.follow(state.player.row, state.player.col, map.rows(), map.cols());
+    const int top = camera.top();
+    const int left = camera.left();
+    const int rows = camera.rows();
+    const int cols = camera.cols();
+    out.top = top;
+    out.left = left;
+    out.rows = rows;
+    out.cols = cols;
+    if (out.tiles.rows() != rows || out.tiles.cols() != cols) {
+        out.tiles = TileGrid<>{rows, cols};
+        out.sight.resize(static_cast<std::size_t>(rows) * cols);
+    }
 
-    // Create map array - 0 = empty, 1 = wall, 2 = player, 3 = enemy
-    int map[GameState::MAP_ROWS][GameState::MAP_COLS]{};
+    // Floor and walls: whole rows copied from small worlds, chunked ones
+    // tile by tile
+    const bool flat = map.visitFlat([&](const auto& grid) {
+        for (int r = 0; r < rows; ++r) {
+            std::memcpy(out.tiles.rowData(r), grid.rowData(top + r) + left,
+                        static_cast<std::size_t>(cols));
+        }
+    });
+    if (!flat) {
+        for (int r = 0; r < rows; ++r) {
+            for (int c = 0; c < cols; ++c) {
+                out.tiles.setWalkable(r, c, map.isWalkable(top + r, left + c));
+            }
+        }
+    }
 
-    // Draw border walls around the entire map
-    // Top and bottom walls
-    for (int c = 0; c < GameState::MAP_COLS; ++c) {
-        map[0][c] = 1;                              // Top wall
-        map[GameState::MAP_ROWS - 1][c] = 1;       // Bottom wall
+    // Sight, and the enemies in it (plus the nearest one for the HUD).
+    // Work is bounded by the window, however large the world or the
+    // enemy count.
+    const FieldOfView& sight = state.sight;
+    const EnemyStore& enemies = state.enemies;
+    out.enemies.clear();
+    std::uint32_t nearest = SpatialGrid::NONE;
+    int nearestDistance = 0;
+    TileSight* seen = out.sight.data();
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c, ++seen) {
+            const int row = top + r;
+            const int col = left + c;
+            if (!sight.isVisible(row, col)) {
+                *seen = sight.isRemembered(row, col) ? TileSight::Remembered : TileSight::Unseen;
+                continue;
+            }
+            *seen = TileSight::Visible;
+            if (enemies.grid.countAt(row, col) == 0) {
+                continue;
+            }
+            out.enemies.push_back(ViewCell{r, c});
+            const int d = std::abs(row - state.player.row) + std::abs(col - state.player.col);
+            if (nearest == SpatialGrid::NONE || d < nearestDistance) {
+                enemies.grid.forEachAt(row, col, [&](std::uint32_t id) { nearest = id; });
+                nearestDistance = d;
+            }
+        }
     }
-    // Left and right walls
-    for (int r = 0; r < GameState::MAP_ROWS; ++r) {
-        map[r][0] = 1;                              // Left wall
-        map[r][GameState::MAP_COLS - 1] = 1;       // Right wall
+    out.hasNearestEnemy = nearest != SpatialGrid::NONE;
+    if (out.hasNearestEnemy) {
+        out.nearestHealth = enemies.health[nearest];
+        out.nearestMaxHealth = enemies.maxHealth[nearest];
     }
 
-    // Place player on map
-    if (state.player.row >= 0 && state.player.row < GameState::MAP_ROWS &&
-        state.player.col >= 0 && state.player.col < GameState::MAP_COLS) {
-        map[state.player.row][state.player.col] = 2;
-    }
+    const Player& player = state.player;
+    out.playerRow = player.row;
+    out.playerCol = player.col;
+    out.health = player.health;
+    out.maxHealth = player.maxHealth;
+    out.attack = player.attack;
+    out.level = player.level;
+    out.experience = player.experience;
 
-    // Place enemy on map (only if alive)
-    if (isEnemyAlive(state.enemy) &&
-        state.enemy.row >= 0 && state.enemy.row < GameState::MAP_ROWS &&
-        state.enemy.col >= 0 && state.enemy.col < GameState::MAP_COLS) {
+    out.enemiesDefeated = state.enemiesDefeated;
+    out.enemiesAlive = enemies.aliveCount();
+    out.showVictoryBanner = state.showVictoryBanner;
+    out.log = state.log;
+    out.keysApplied = state.keysApplied;
+    out.lastKeyTime = state.lastKeyTime;
+}
 
-        // If enemy and player are on same tile, show player (they're fighting)
-        if (map[state.enemy.row][state.enemy.col] != 2) {
-            map[state.enemy.row][state.enemy.col] = 3;
-        }
+// Draw a captured view and its HUD into a frame
+void composeMap(const RenderSnapshot& snapshot, CellGrid& frame) {
+    frame.fill(' ');
+
+    // The map fills the frame above the HUD. A snapshot captured before
+    // the terminal shrank is cut to fit; the next one has the new size.
+    const int viewRows = std::min(snapshot.rows, frame.rows() - HUD_ROWS);
+    const int viewCols = std::min(snapshot.cols, frame.cols());
+
+    // Draw floor and walls, through code specialised for the default
+    // window size when that is what is shown
+    if (viewRows == GameState::MAP_ROWS && viewCols == GameState::MAP_COLS) {
+        drawTileWindow<GameState::MAP_ROWS, GameState::MAP_COLS>(snapshot.tiles, 0, 0, frame);
+    } else {
+        drawTileWindow(snapshot.tiles, 0, 0, viewRows, viewCols, frame);
     }
 
-    // Render the map character by character
-    for (int r = 0; r < GameState::MAP_ROWS; ++r) {
-        for (int c = 0; c < GameState::MAP_COLS; ++c) {
-            char tile;
-
-            // Convert tile type to display character
-            switch (map[r][c]) {
-                case 0:  // Empty floor
-                    tile = '.';
-                    break;
-                case 1:  // Wall
-                    tile = '#';
-                    break;
-                case 2:  // Player
-                    tile = '@';
-                    break;
-                case 3:  // Enemy
-                    tile = 'E';
-                    break;
-                default: // Unknown (shouldn't happen)
-                    tile = '?';
-                    break;
+    // Fog of war: tiles out of sight are dimmed if remembered, blank if
+    // never seen; enemies show only in sight
+    for (int r = 0; r < viewRows; ++r) {
+        const TileSight* seen = snapshot.sight.data() + static_cast<std::size_t>(r) * snapshot.cols;
+        for (int c = 0; c < viewCols; ++c) {
+            if (seen[c] == TileSight::Remembered) {
+                frame.setStyle(r, c, CellStyle::Dim);
+            } else if (seen[c] == TileSight::Unseen) {
+                frame.set(r, c, ' ');
             }
-
-            std::cout << tile;
         }
-        std::cout << '\n';  // New line after each row
+    }
+    for (const ViewCell& enemy : snapshot.enemies) {
+        if (enemy.row < viewRows && enemy.col < viewCols) {
+            frame.set(enemy.row, enemy.col, 'E');
+        }
+    }
+
+    // Place player on map - drawn last so the player shows when fighting
+    const int playerRow = snapshot.playerRow - snapshot.top;
+    const int playerCol = snapshot.playerCol - snapshot.left;
+    if (playerRow < viewRows && playerCol < viewCols) {
+        frame.set(playerRow, playerCol, '@');
+    }
+
+    // Victory overlay across the middle of the map while it is showing
+    if (snapshot.showVictoryBanner) {
+        drawVictoryBanner(frame, viewRows / 2 - 2, 1);
     }
 
     // Display player statistics below the map
-    std::cout << "\n========================================\n";
-    std::cout << "Level: " << state.player.level
-              << " | Health: " << state.player.health
-              << "/" << state.player.maxHealth
-              << " | Attack: " << state.player.attack << "\n";
-    std::cout << "XP: " << state.player.experience
-              << "/" << (100 * state.player.level)
-              << " | Enemies Defeated: " << state.enemiesDefeated << "\n";
-    std::cout << "========================================\n";
-
-    // Display enemy status if alive
-    if (isEnemyAlive(state.enemy)) {
-        std::cout << "Enemy Health: " << state.enemy.health
-                  << "/" << state.enemy.maxHealth << "\n";
+    char line[FRAME_COLS + 1];
+    int hud = viewRows + 1;
+
+    frame.writeText(hud++, 0, "========================================");
+    std::snprintf(line, sizeof(line), "Level: %d | Health: %d/%d | Attack: %d",
+                  snapshot.level, snapshot.health, snapshot.maxHealth, snapshot.attack);
+    frame.writeText(hud++, 0, line);
+    std::snprintf(line, sizeof(line), "XP: %d/%d | Enemies Defeated: %d",
+                  snapshot.experience, 100 * snapshot.level, snapshot.enemiesDefeated);
+    frame.writeText(hud++, 0, line);
+    frame.writeText(hud++, 0, "========================================");
+
+    // Display status of the nearest enemy in sight, if any
+    if (snapshot.hasNearestEnemy) {
+        std::snprintf(line, sizeof(line), "Enemy Health: %d/%d | Enemies Alive: %zu",
+                      snapshot.nearestHealth, snapshot.nearestMaxHealth,
+                      snapshot.enemiesAlive);
+        frame.writeText(hud, 0, line);
     }
+    hud += 2;
 
     // Display controls
-    std::cout << "\nControls: W/A/S/D to move, Q to quit\n";
+    frame.writeText(hud++, 0, "Controls: W/A/S/D to move, Q to quit");
+
+    // Message panel: the newest messages, oldest at the top. Read straight
+    // from the log, which the simulation may be writing to meanwhile; a
+    // message overwritten under us is skipped rather than waited for.
+    frame.writeText(hud++, 0, "---------------- Messages ----------------");
+    if (!snapshot.log) {
+        return;
+    }
+    const EventLog& log = *snapshot.log;
+    const std::uint64_t end = log.written();
+    const std::uint64_t shown = LOG_PANEL_ROWS - 1;
+    LogEvent event;
+    char message[128];
+    for (std::uint64_t seq = end > shown ? end - shown : 0; seq < end; ++seq) {
+        if (log.read(seq, event)) {
+            formatLogEvent(event, message, sizeof(message));
+            frame.writeText(hud, 0, message);
+        }
+        hud++;
+    }
+}
+
+// Render a captured view through a backend
+// Only the cells that differ from the previous frame reach the terminal
+void printMap(const RenderSnapshot& snapshot, RenderBackend& backend) {
+    CellGrid& frame = scratchFrame(backend);
+    {
+        PROFILE_SCOPE(Compose);
+        composeMap(snapshot, frame);
+#if GAME_PROFILING
+        if (Profiler::isEnabled()) {
+            drawProfileOverlay(frame);
+        }
+#endif
+    }
+    PROFILE_SCOPE(Present);
+    backend.present(frame);
+}
+
+// Render the game state through a backend
+void printMap(const GameState& state, RenderBackend& backend) {
+    thread_local RenderSnapshot snapshot;
+    int rows;
+    int cols;
+    mapViewSize(backend, rows, cols);
+    Camera& camera = followCamera();
+    camera.resize(rows, cols);
+    captureRenderSnapshot(state, camera, snapshot);
+    printMap(snapshot, backend);
+}
+
+void printMap(const GameState& state) {
+    printMap(state, terminalBackend());
 }
 
 // Game Over Screen
 
 // Display game over message with final statistics
+void displayGameOver(const GameState& state, RenderBackend& backend) {
+    CellGrid& frame = scratchFrame(backend);
+    frame.fill(' ');
+
+    writeLines(frame, 1, {
+        "========================================",
+        "           GAME OVER!                   ",
+        "========================================",
+        "",
+        "Final Statistics:",
+    });
+
+    char line[FRAME_COLS + 1];
+    std::snprintf(line, sizeof(line), "  Level Reached: %d", state.player.level);
+    frame.writeText(6, 0, line);
+    std::snprintf(line, sizeof(line), "  Enemies Defeated: %d", state.enemiesDefeated);
+    frame.writeText(7, 0, line);
+    std::snprintf(line, sizeof(line), "  Final Attack: %d", state.player.attack);
+    frame.writeText(8, 0, line);
+
+    writeLines(frame, 10, {
+        "Thank you for playing!",
+        "========================================",
+    });
+
+    backend.present(frame);
+}
+
 void displayGameOver(const GameState& state) {
-    clearScreen();
-
-    std::cout << "\n";
-    std::cout << "========================================\n";
-    std::cout << "           GAME OVER!                   \n";
-    std::cout << "========================================\n";
-    std::cout << "\n";
-    std::cout << "Final Statistics:\n";
-    std::cout << "  Level Reached: " << state.player.level << "\n";
-    std::cout << "  Enemies Defeated: " << state.enemiesDefeated << "\n";
-    std::cout << "  Final Attack: " << state.player.attack << "\n";
-    std::cout << "\n";
-    std::cout << "Thank you for playing!\n";
-    std::cout << "========================================\n";
-}
-
-// Display victory message when enemy is defeated
-void displayVictory() {
-    std::cout << "\n";
-    std::cout << "**************************************\n";
-    std::cout << "          VICTORY!                    \n";
-    std::cout << "     The enemy has been defeated!     \n";
-    std::cout << "**************************************\n";
-    std::cout << "\n";
+    displayGameOver(state, terminalBackend());
 }
@@ -0,0 +1,235 @@
+#include "Replay.hpp"
+#include "GameState.hpp"
+
+#include <cstring>
+
+// File Format Constants
+
+namespace {
+constexpr char MAGIC[4] = {'D', 'C', 'R', 'P'};
+constexpr std::uint16_t VERSION = 4;
+constexpr std::size_t HEADER_SIZE = 20;
+constexpr std::size_t FLUSH_THRESHOLD = 4096;
+
+// FNV-1a, fed one integer at a time
+struct StateHasher {
+    std::uint64_t hash = 14695981039346656037ULL;
+
+    void add(std::uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            hash ^= (value >> (i * 8)) & 0xFF;
+            hash *= 1099511628211ULL;
+        }
+    }
+};
+
+void putU16(std::uint8_t* out, std::uint16_t value) {
+    out[0] = static_cast<std::uint8_t>(value);
+    out[1] = static_cast<std::uint8_t>(value >> 8);
+}
+
+void putU32(std::uint8_t* out, std::uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out[i] = static_cast<std::uint8_t>(value >> (i * 8));
+    }
+}
+
+std::uint32_t getU32(const std::uint8_t* in) {
+    std::uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        value |= static_cast<std::uint32_t>(in[i]) << (i * 8);
+    }
+    return value;
+}
+}  // namespace
+
+// State Hashing
+
+std::uint64_t hashGameState(const GameState& state) {
+    StateHasher h;
+
+    const Player& p = state.player;
+    h.add(static_cast<std::uint64_t>(p.health));
+    h.add(static_cast<std::uint64_t>(p.maxHealth));
+    h.add(static_cast<std::uint64_t>(p.attack));
+    h.add(static_cast<std::uint64_t>(p.level));
+    h.add(static_cast<std::uint64_t>(p.experience));
+    h.add(static_cast<std::uint64_t>(p.row));
+    h.add(static_cast<std::uint64_t>(p.col));
+
+    const EnemyStore& e = state.enemies;
+    h.add(e.size());
+    for (std::size_t i = 0; i < e.size(); ++i) {
+        h.add(static_cast<std::uint64_t>(e.health[i]));
+        h.add(static_cast<std::uint64_t>(e.maxHealth[i]));
+        h.add(static_cast<std::uint64_t>(e.attack[i]));
+        h.add(static_cast<std::uint64_t>(e.row[i]));
+        h.add(static_cast<std::uint64_t>(e.col[i]));
+        h.add(e.alive[i]);
+        h.add(e.generation[i]);
+    }
+
+    h.add(state.isGameRunning ? 1 : 0);
+    h.add(static_cast<std::uint64_t>(state.enemiesDefeated));
+    h.add(state.tick);
+    h.add(static_cast<std::uint64_t>(state.ticksPerSecond));
+    h.add(state.showVictoryBanner ? 1 : 0);
+    h.add(static_cast<std::uint64_t>(state.heldDirection));
+    h.add(state.nextMoveTick);
+    h.add(state.nextEnemyMoveTick);
+    h.add(state.events.size());
+    for (int i = 0; i < 4; ++i) {
+        h.add(state.spawnRng.state()[i]);
+    }
+
+    return h.hash;
+}
+
+// Recording
+
+ReplayRecorder::ReplayRecorder(const std::string& path, std::uint32_t seed,
+                               int ticksPerSecond, std::size_t enemyCount)
+    : out_{path, std::ios::binary | std::ios::trunc} {
+    buffer_.reserve(FLUSH_THRESHOLD * 2);
+
+    std::uint8_t header[HEADER_SIZE]{};
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    putU16(header + 4, VERSION);
+    putU16(header + 6, 0);
+    putU32(header + 8, seed);
+    putU32(header + 12, static_cast<std::uint32_t>(ticksPerSecond));
+    putU32(header + 16, static_cast<std::uint32_t>(enemyCount));
+    buffer_.insert(buffer_.end(), header, header + HEADER_SIZE);
+}
+
+ReplayRecorder::~ReplayRecorder() {
+    flushBuffer();
+}
+
+void ReplayRecorder::record(std::uint64_t tick, int key) {
+    if (finished_ || key <= 0 || key > 0xFF) {
+        return;  // Key 0 is reserved for the footer marker
+    }
+    appendVarint(tick - lastTick_);
+    buffer_.push_back(static_cast<std::uint8_t>(key));
+    lastTick_ = tick;
+
+    if (buffer_.size() >= FLUSH_THRESHOLD) {
+        flushBuffer();
+    }
+}
+
+void ReplayRecorder::finish(const GameState& finalState) {
+    if (finished_) {
+        return;
+    }
+    appendVarint(finalState.tick - lastTick_);
+    buffer_.push_back(0);
+
+    std::uint64_t footer[2] = {finalState.tick, hashGameState(finalState)};
+    for (std::uint64_t value : footer) {
+        for (int i = 0; i < 8; ++i) {
+            buffer_.push_back(static_cast<std::uint8_t>(value >> (i * 8)));
+        }
+    }
+
+    flushBuffer();
+    out_.close();
+    finished_ = true;
+}
+
+// LEB128: 7 bits per byte, high bit set on all but the last byte
+void ReplayRecorder::appendVarint(std::uint64_t value) {
+    while (value >= 0x80) {
+        buffer_.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    buffer_.push_back(static_cast<std::uint8_t>(value));
+}
+
+void ReplayRecorder::flushBuffer() {
+    if (!buffer_.empty() && out_.is_open()) {
+        out_.write(reinterpret_cast<const char*>(buffer_.data()),
+                   static_cast<std::streamsize>(buffer_.size()));
+    }
+    buffer_.clear();
+}
+
+// Playback
+
+ReplayReader::ReplayReader(const std::string& path)
+    : file_{path} {
+    if (!file_.isOpen()) {
+        error_ = file_.error();
+        return;
+    }
+    if (file_.size() < HEADER_SIZE ||
+        std::memcmp(file_.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        error_ = path + ": not a replay file";
+        return;
+    }
+
+    const std::uint8_t* header = file_.data();
+    std::uint16_t version = static_cast<std::uint16_t>(header[4] | (header[5] << 8));
+    if (version != VERSION) {
+        error_ = path + ": unsupported replay version " + std::to_string(version);
+        return;
+    }
+
+    seed_ = getU32(header + 8);
+    ticksPerSecond_ = static_cast<int>(getU32(header + 12));
+    enemyCount_ = getU32(header + 16);
+    pos_ = HEADER_SIZE;
+    file_.adviseSequential();
+}
+
+bool ReplayReader::next(ReplayEvent& event) {
+    if (!isValid() || hasFooter_) {
+        return false;
+    }
+
+    std::uint64_t delta = 0;
+    if (!readVarint(delta) || pos_ >= file_.size()) {
+        error_ = "replay truncated (no footer)";
+        return false;
+    }
+    std::uint8_t key = file_.data()[pos_++];
+    lastTick_ += delta;
+
+    if (key == 0) {
+        // Footer: final tick and expected state hash
+        if (!readU64(finalTick_) || !readU64(stateHash_)) {
+            error_ = "replay footer truncated";
+            return false;
+        }
+        hasFooter_ = true;
+        return false;
+    }
+
+    event.tick = lastTick_;
+    event.key = key;
+    return true;
+}
+
+bool ReplayReader::readVarint(std::uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && pos_ < file_.size(); shift += 7) {
+        std::uint8_t byte = file_.data()[pos_++];
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ReplayReader::readU64(std::uint64_t& value) {
+    if (file_.size() - pos_ < 8) {
+        return false;
+    }
+    value = 0;
+    for (int i = 0; i < 8; ++i) {
+        value |= static_cast<std::uint64_t>(file_.data()[pos_++]) << (i * 8);
+    }
+    return true;
+}
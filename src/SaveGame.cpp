@@ -0,0 +1,566 @@
+#include "SaveGame.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+// File Format
+
+// Sections are the in-memory arrays written as-is, so the file is only
+// portable between little-endian machines with 32-bit int - every target
+// this game builds for
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "save files are little-endian");
+static_assert(sizeof(int) == 4, "save files store int as 32 bits");
+
+namespace {
+constexpr char MAGIC[4] = {'D', 'C', 'S', 'V'};
+constexpr std::uint16_t VERSION = 1;
+constexpr std::size_t ALIGNMENT = 8;
+
+// Fixed-size header, written and read with one memcpy
+struct SaveHeader {
+    char magic[4];
+    std::uint16_t version;
+    std::uint16_t headerBytes;
+    std::int32_t mapRows;
+    std::int32_t mapCols;
+
+    // Player
+    std::int32_t health;
+    std::int32_t maxHealth;
+    std::int32_t attack;
+    std::int32_t level;
+    std::int32_t experience;
+    std::int32_t row;
+    std::int32_t col;
+
+    // Game
+    std::int32_t enemiesDefeated;
+    std::uint64_t tick;
+    std::int32_t ticksPerSecond;
+    std::uint8_t showVictoryBanner;
+    std::uint8_t heldDirection;
+    std::uint8_t reserved[2];
+    std::uint64_t nextMoveTick;
+    std::uint64_t nextEnemyMoveTick;
+    std::uint64_t spawnRng[4];
+    std::int32_t aiWindowTop;
+    std::int32_t aiWindowLeft;
+    std::int32_t spawnZoneRow;
+    std::int32_t spawnZoneCol;
+
+    // Section sizes
+    std::uint64_t enemyCapacity;
+    std::uint64_t enemyHighWater;
+    std::uint64_t enemyCount;
+    std::uint64_t freeCount;
+    std::uint64_t eventCount;
+    std::uint64_t nextEventSequence;
+    std::uint64_t spawnCount;
+};
+static_assert(sizeof(SaveHeader) == 184 && std::is_trivially_copyable_v<SaveHeader>,
+              "SaveHeader must have no hidden padding");
+
+// A timed event as stored (TimedEvent has padding of unspecified content)
+struct SavedEvent {
+    std::uint64_t tick;
+    std::uint64_t sequence;
+    std::uint32_t type;
+    std::int32_t payload;
+};
+static_assert(sizeof(SavedEvent) == 24, "SavedEvent must have no hidden padding");
+
+std::size_t alignUp(std::size_t offset) {
+    return (offset + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+// Byte offset of every section, for n enemies, f free slots, e events and
+// s spawn tiles
+struct SectionLayout {
+    std::size_t health;
+    std::size_t maxHealth;
+    std::size_t attack;
+    std::size_t row;
+    std::size_t col;
+    std::size_t alive;
+    std::size_t generation;
+    std::size_t freeSlots;
+    std::size_t events;
+    std::size_t spawnOrder;
+    std::size_t end;
+};
+
+SectionLayout layoutFor(std::size_t n, std::size_t f, std::size_t e, std::size_t s) {
+    SectionLayout layout{};
+    std::size_t offset = alignUp(sizeof(SaveHeader));
+    auto next = [&offset](std::size_t bytes) {
+        std::size_t start = offset;
+        offset = alignUp(offset + bytes);
+        return start;
+    };
+    layout.health = next(n * sizeof(int));
+    layout.maxHealth = next(n * sizeof(int));
+    layout.attack = next(n * sizeof(int));
+    layout.row = next(n * sizeof(int));
+    layout.col = next(n * sizeof(int));
+    layout.alive = next(n * sizeof(std::uint8_t));
+    layout.generation = next(n * sizeof(std::uint32_t));
+    layout.freeSlots = next(f * sizeof(std::uint32_t));
+    layout.events = next(e * sizeof(SavedEvent));
+    layout.spawnOrder = next(s * sizeof(std::uint32_t));
+    layout.end = offset;
+    return layout;
+}
+
+SectionLayout layoutOf(const SaveHeader& header) {
+    return layoutFor(header.enemyCount, header.freeCount, header.eventCount, header.spawnCount);
+}
+
+// Copy a section out of the mapped file into a vector
+template <typename T>
+void copySection(const std::uint8_t* data, std::size_t offset, std::size_t count,
+                 std::vector<T>& out) {
+    out.resize(count);
+    if (count > 0) {
+        std::memcpy(out.data(), data + offset, count * sizeof(T));
+    }
+}
+}  // namespace
+
+// Capture
+
+void captureSave(const GameState& state, SaveSnapshot& out) {
+    out.mapRows = state.map->rows();
+    out.mapCols = state.map->cols();
+
+    out.player = state.player;
+    out.enemiesDefeated = state.enemiesDefeated;
+    out.tick = state.tick;
+    out.ticksPerSecond = state.ticksPerSecond;
+    out.showVictoryBanner = state.showVictoryBanner;
+    out.heldDirection = state.heldDirection;
+    out.nextMoveTick = state.nextMoveTick;
+    out.nextEnemyMoveTick = state.nextEnemyMoveTick;
+    std::memcpy(out.spawnRng, state.spawnRng.state(), sizeof(out.spawnRng));
+    out.aiWindowTop = state.chaseField.originRow();
+    out.aiWindowLeft = state.chaseField.originCol();
+
+    const EnemyStore& enemies = state.enemies;
+    out.enemyCapacity = enemies.capacity();
+    out.enemyHighWater = enemies.highWaterMark();
+
+    // Slot arrays: if this snapshot was last filled from the same store
+    // recently, recopy only the slots written since; else copy them all
+    const std::size_t n = enemies.size();
+    bool refreshed = false;
+    if (out.enemySource == enemies.changes().id() && out.health.size() <= n) {
+        out.health.resize(n);
+        out.maxHealth.resize(n);
+        out.attack.resize(n);
+        out.row.resize(n);
+        out.col.resize(n);
+        out.alive.resize(n);
+        out.generation.resize(n);
+        refreshed = enemies.changes().forEachSince(out.enemyEpoch, [&](std::size_t i) {
+            out.health[i] = enemies.health[i];
+            out.maxHealth[i] = enemies.maxHealth[i];
+            out.attack[i] = enemies.attack[i];
+            out.row[i] = enemies.row[i];
+            out.col[i] = enemies.col[i];
+            out.alive[i] = enemies.alive[i];
+            out.generation[i] = enemies.generation[i];
+        });
+    }
+    if (!refreshed) {
+        out.health = enemies.health;
+        out.maxHealth = enemies.maxHealth;
+        out.attack = enemies.attack;
+        out.row = enemies.row;
+        out.col = enemies.col;
+        out.alive = enemies.alive;
+        out.generation = enemies.generation;
+    }
+    out.enemySource = enemies.changes().id();
+    out.enemyEpoch = enemies.endChangeEpoch();
+    out.freeSlots = enemies.freeSlots();
+
+    out.events = state.events.pending();
+    out.nextEventSequence = state.events.nextSequence();
+    out.spawnZoneRow = enemies.spawnCells.playerRow();
+    out.spawnZoneCol = enemies.spawnCells.playerCol();
+    out.spawnOrder = enemies.spawnCells.order();
+}
+
+// Writing
+
+bool writeSave(const SaveSnapshot& snapshot, const std::string& path, std::string& error) {
+    const std::string tempPath = path + ".tmp";
+    std::FILE* file = std::fopen(tempPath.c_str(), "wb");
+    if (!file) {
+        error = tempPath + ": " + std::strerror(errno);
+        return false;
+    }
+
+    const Player& player = snapshot.player;
+    SaveHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.headerBytes = sizeof(SaveHeader);
+    header.mapRows = snapshot.mapRows;
+    header.mapCols = snapshot.mapCols;
+    header.health = player.health;
+    header.maxHealth = player.maxHealth;
+    header.attack = player.attack;
+    header.level = player.level;
+    header.experience = player.experience;
+    header.row = player.row;
+    header.col = player.col;
+    header.enemiesDefeated = snapshot.enemiesDefeated;
+    header.tick = snapshot.tick;
+    header.ticksPerSecond = snapshot.ticksPerSecond;
+    header.showVictoryBanner = snapshot.showVictoryBanner ? 1 : 0;
+    header.heldDirection = static_cast<std::uint8_t>(snapshot.heldDirection);
+    header.nextMoveTick = snapshot.nextMoveTick;
+    header.nextEnemyMoveTick = snapshot.nextEnemyMoveTick;
+    std::memcpy(header.spawnRng, snapshot.spawnRng, sizeof(header.spawnRng));
+    header.aiWindowTop = snapshot.aiWindowTop;
+    header.aiWindowLeft = snapshot.aiWindowLeft;
+    header.spawnZoneRow = snapshot.spawnZoneRow;
+    header.spawnZoneCol = snapshot.spawnZoneCol;
+    header.enemyCapacity = snapshot.enemyCapacity;
+    header.enemyHighWater = snapshot.enemyHighWater;
+    header.enemyCount = snapshot.health.size();
+    header.freeCount = snapshot.freeSlots.size();
+    header.eventCount = snapshot.events.size();
+    header.nextEventSequence = snapshot.nextEventSequence;
+    header.spawnCount = snapshot.spawnOrder.size();
+
+    std::vector<SavedEvent> events;
+    events.reserve(snapshot.events.size());
+    for (const TimedEvent& event : snapshot.events) {
+        events.push_back(SavedEvent{event.tick, event.sequence,
+                                    static_cast<std::uint32_t>(event.type), event.payload});
+    }
+
+    // Each section straight from its array, then zero padding up to the
+    // next 8-byte boundary
+    static constexpr char PADDING[ALIGNMENT] = {};
+    std::size_t offset = 0;
+    bool ok = true;
+    auto writeSection = [&](const void* bytes, std::size_t size) {
+        if (size > 0) {
+            ok = ok && std::fwrite(bytes, 1, size, file) == size;
+        }
+        offset += size;
+        const std::size_t padding = alignUp(offset) - offset;
+        if (padding > 0) {
+            ok = ok && std::fwrite(PADDING, 1, padding, file) == padding;
+        }
+        offset += padding;
+    };
+    writeSection(&header, sizeof(header));
+    writeSection(snapshot.health.data(), snapshot.health.size() * sizeof(int));
+    writeSection(snapshot.maxHealth.data(), snapshot.maxHealth.size() * sizeof(int));
+    writeSection(snapshot.attack.data(), snapshot.attack.size() * sizeof(int));
+    writeSection(snapshot.row.data(), snapshot.row.size() * sizeof(int));
+    writeSection(snapshot.col.data(), snapshot.col.size() * sizeof(int));
+    writeSection(snapshot.alive.data(), snapshot.alive.size());
+    writeSection(snapshot.generation.data(), snapshot.generation.size() * sizeof(std::uint32_t));
+    writeSection(snapshot.freeSlots.data(), snapshot.freeSlots.size() * sizeof(std::uint32_t));
+    writeSection(events.data(), events.size() * sizeof(SavedEvent));
+    writeSection(snapshot.spawnOrder.data(), snapshot.spawnOrder.size() * sizeof(std::uint32_t));
+
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok) {
+        error = tempPath + ": write failed";
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        error = path + ": " + std::strerror(errno);
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool saveGame(const GameState& state, const std::string& path, std::string& error) {
+    SaveSnapshot snapshot;
+    captureSave(state, snapshot);
+    return writeSave(snapshot, path, error);
+}
+
+// Loading
+
+SaveReader::SaveReader(const std::string& path)
+    : file_{path} {
+    if (!file_.isOpen()) {
+        error_ = file_.error();
+        return;
+    }
+    SaveHeader header;
+    if (file_.size() < sizeof(SaveHeader) ||
+        std::memcmp(file_.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        error_ = path + ": not a save file";
+        return;
+    }
+    std::memcpy(&header, file_.data(), sizeof(header));
+    if (header.version != VERSION || header.headerBytes != sizeof(SaveHeader)) {
+        error_ = path + ": unsupported save version " + std::to_string(header.version);
+        return;
+    }
+
+    // Every count is bounded by the file size before any offset is computed
+    const std::size_t size = file_.size();
+    if (header.enemyCount > size || header.freeCount > size || header.eventCount > size ||
+        header.spawnCount > size ||
+        layoutOf(header).end != size) {
+        error_ = path + ": save file truncated or corrupt";
+        return;
+    }
+    if (header.mapRows <= 0 || header.mapCols <= 0 || header.ticksPerSecond <= 0 ||
+        header.enemyCount > header.enemyCapacity || header.enemyHighWater > header.enemyCount ||
+        (header.spawnRng[0] | header.spawnRng[1] | header.spawnRng[2] | header.spawnRng[3]) == 0) {
+        error_ = path + ": save file corrupt";
+        return;
+    }
+
+    // The spawn zone's centre on the map, and the enemy AI window inside it
+    // (as GameState::moveAIWindow places it)
+    if (header.spawnZoneRow < 0 || header.spawnZoneRow >= header.mapRows ||
+        header.spawnZoneCol < 0 || header.spawnZoneCol >= header.mapCols) {
+        error_ = path + ": save file corrupt (spawn zone off the map)";
+        return;
+    }
+    const int windowRows = std::min(header.mapRows, GameState::AI_WINDOW_ROWS);
+    const int windowCols = std::min(header.mapCols, GameState::AI_WINDOW_COLS);
+    if (header.aiWindowTop < 0 || header.aiWindowTop > header.mapRows - windowRows ||
+        header.aiWindowLeft < 0 || header.aiWindowLeft > header.mapCols - windowCols) {
+        error_ = path + ": save file corrupt (AI window off the map)";
+        return;
+    }
+
+    // Live enemies on the saved map (walls are checked by restore(), which
+    // has the map)
+    const std::uint8_t* data = file_.data();
+    const SectionLayout layout = layoutOf(header);
+    const auto* alive = data + layout.alive;
+    const auto* rows = reinterpret_cast<const std::int32_t*>(data + layout.row);
+    const auto* cols = reinterpret_cast<const std::int32_t*>(data + layout.col);
+    for (std::size_t i = 0; i < header.enemyCount; ++i) {
+        if (alive[i] && (rows[i] < 0 || rows[i] >= header.mapRows ||
+                         cols[i] < 0 || cols[i] >= header.mapCols)) {
+            error_ = path + ": save file corrupt (enemy off the map)";
+            return;
+        }
+    }
+
+    // Free slots: each a dead slot below the high-water mark, listed once
+    const auto* freeSlots = reinterpret_cast<const std::uint32_t*>(data + layout.freeSlots);
+    std::vector<std::uint8_t> listed(header.enemyHighWater, 0);
+    for (std::size_t i = 0; i < header.freeCount; ++i) {
+        const std::uint32_t slot = freeSlots[i];
+        if (slot >= header.enemyHighWater || alive[slot] || listed[slot]) {
+            error_ = path + ": save file corrupt (bad free slot)";
+            return;
+        }
+        listed[slot] = 1;
+    }
+
+    // Timed events of a known type
+    const auto* events = reinterpret_cast<const SavedEvent*>(data + layout.events);
+    for (std::size_t i = 0; i < header.eventCount; ++i) {
+        if (events[i].type > static_cast<std::uint32_t>(LAST_EVENT_TYPE)) {
+            error_ = path + ": save file corrupt (unknown event type)";
+            return;
+        }
+    }
+
+    // The pool is reserved up front, so a capacity the file cannot back
+    // would allocate whatever the header claims. A game's pool is its
+    // starting population or the default, whichever is larger, so cap it
+    // to the slots saved or the default.
+    enemyCapacity_ = std::min<std::size_t>(
+        header.enemyCapacity, std::max<std::size_t>(header.enemyCount, EnemyStore::DEFAULT_CAPACITY));
+}
+
+bool SaveReader::restore(GameState& state) {
+    if (!isValid()) {
+        return false;
+    }
+    SaveHeader header;
+    std::memcpy(&header, file_.data(), sizeof(header));
+
+    const TileMap& map = *state.map;
+    if (header.mapRows != map.rows() || header.mapCols != map.cols()) {
+        error_ = "save is for a " + std::to_string(header.mapRows) + "x" +
+                 std::to_string(header.mapCols) + " map (use the same --map)";
+        return false;
+    }
+    if (header.enemyCount > state.enemies.capacity()) {
+        error_ = "save has more enemies than the enemy pool holds";
+        return false;
+    }
+    if (header.row < 0 || header.row >= map.rows() || header.col < 0 || header.col >= map.cols()) {
+        error_ = "save file corrupt (player off the map)";
+        return false;
+    }
+
+    // Live enemies stand on floor (the reader checked they are on the map)
+    const std::uint8_t* data = file_.data();
+    const SectionLayout layout = layoutOf(header);
+    const std::size_t n = header.enemyCount;
+    const auto* alive = data + layout.alive;
+    const auto* rows = reinterpret_cast<const std::int32_t*>(data + layout.row);
+    const auto* cols = reinterpret_cast<const std::int32_t*>(data + layout.col);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (alive[i] && !map.isWalkable(rows[i], cols[i])) {
+            error_ = "save does not fit this map (enemy inside a wall)";
+            return false;
+        }
+    }
+
+    // Enemies: one memcpy per array, then rebuild the tile index
+    EnemyStore& enemies = state.enemies;
+    enemies.clear();
+    copySection(data, layout.health, n, enemies.health);
+    copySection(data, layout.maxHealth, n, enemies.maxHealth);
+    copySection(data, layout.attack, n, enemies.attack);
+    copySection(data, layout.row, n, enemies.row);
+    copySection(data, layout.col, n, enemies.col);
+    copySection(data, layout.alive, n, enemies.alive);
+    copySection(data, layout.generation, n, enemies.generation);
+    enemies.adoptSlots(reinterpret_cast<const std::uint32_t*>(data + layout.freeSlots),
+                       header.freeCount, header.enemyHighWater);
+
+    // Timed events
+    std::vector<TimedEvent> events(header.eventCount);
+    const auto* saved = reinterpret_cast<const SavedEvent*>(data + layout.events);
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        events[i] = TimedEvent{saved[i].tick, saved[i].sequence,
+                               static_cast<TimedEventType>(saved[i].type), saved[i].payload};
+    }
+    state.events.restore(events.data(), events.size(), header.nextEventSequence);
+    state.victoryBannerUntil = 0;
+    for (const TimedEvent& event : events) {
+        if (event.type == TimedEventType::HideVictoryBanner) {
+            state.victoryBannerUntil = std::max(state.victoryBannerUntil, event.tick);
+        }
+    }
+
+    // Player and game
+    Player& player = state.player;
+    player.health = header.health;
+    player.maxHealth = header.maxHealth;
+    player.attack = header.attack;
+    player.level = header.level;
+    player.experience = header.experience;
+    player.row = header.row;
+    player.col = header.col;
+    state.isGameRunning = true;
+    state.enemiesDefeated = header.enemiesDefeated;
+    state.tick = header.tick;
+    state.ticksPerSecond = header.ticksPerSecond;
+    state.showVictoryBanner = header.showVictoryBanner != 0;
+    state.heldDirection = static_cast<char>(header.heldDirection);
+    state.nextMoveTick = header.nextMoveTick;
+    state.nextEnemyMoveTick = header.nextEnemyMoveTick;
+    state.spawnRng.setState(header.spawnRng);
+
+    // Derived state, rebuilt as the constructor builds it
+    state.sight = FieldOfView{GameState::MAP_ROWS - 1, GameState::MAP_COLS - 1};
+    state.sight.update(map, player.row, player.col);
+    enemies.spawnCells.setPlayer(header.spawnZoneRow, header.spawnZoneCol);
+    state.moveAIWindow(header.aiWindowTop, header.aiWindowLeft);
+    state.chaseField.setRoot(player.row, player.col);
+
+    // Spawn tiles in their saved order, so enemies appear where they would
+    // have; a map with other walls (but the same size) keeps the new order
+    enemies.spawnCells.restoreOrder(reinterpret_cast<const std::uint32_t*>(data + layout.spawnOrder),
+                                    header.spawnCount);
+    return true;
+}
+
+// Autosave
+
+AutoSaver::AutoSaver(std::string path, std::uint64_t intervalTicks)
+    : path_{std::move(path)},
+      intervalTicks_{intervalTicks > 0 ? intervalTicks : 1},
+      thread_{[this] { run(); }} {}
+
+AutoSaver::~AutoSaver() {
+    finish();
+}
+
+void AutoSaver::finish() {
+    if (!thread_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+}
+
+void AutoSaver::onTick(const GameState& state) {
+    if (!armed_) {
+        nextSaveTick_ = state.tick + intervalTicks_;
+        armed_ = true;
+    }
+    if (state.tick >= nextSaveTick_) {
+        nextSaveTick_ = state.tick + intervalTicks_;
+        saveNow(state);
+    }
+}
+
+void AutoSaver::saveNow(const GameState& state) {
+    // The writer holds the lock only to swap buffers, never during I/O
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        if (stopping_) {
+            return;
+        }
+        captureSave(state, pending_);
+        hasPending_ = true;
+    }
+    wake_.notify_one();
+}
+
+std::uint64_t AutoSaver::savesWritten() const {
+    std::lock_guard<std::mutex> lock{mutex_};
+    return savesWritten_;
+}
+
+std::string AutoSaver::lastError() const {
+    std::lock_guard<std::mutex> lock{mutex_};
+    return lastError_;
+}
+
+void AutoSaver::run() {
+    std::unique_lock<std::mutex> lock{mutex_};
+    while (true) {
+        wake_.wait(lock, [this] { return hasPending_ || stopping_; });
+        if (!hasPending_) {
+            return;  // Stopping with nothing left to write
+        }
+        // Take the snapshot, leaving our old buffers for the next capture
+        std::swap(pending_, writing_);
+        hasPending_ = false;
+        lock.unlock();
+
+        std::string error;
+        const bool ok = writeSave(writing_, path_, error);
+
+        lock.lock();
+        if (ok) {
+            savesWritten_++;
+        } else {
+            lastError_ = error;
+        }
+    }
+}
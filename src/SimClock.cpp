@@ -0,0 +1,45 @@
+#include "SimClock.hpp"
+
+#include <algorithm>
+
+// Construction
+
+SimClock::SimClock(const SimClockConfig& config)
+    : tickDuration_{std::chrono::duration_cast<clock::duration>(
+          std::chrono::nanoseconds{1'000'000'000LL / std::max(1, config.ticksPerSecond)})},
+      maxTicksPerFrame_{std::max(1, config.maxTicksPerFrame)} {}
+
+void SimClock::start(clock::time_point now) {
+    last_ = now;
+    accumulator_ = clock::duration{0};
+}
+
+// Tick Scheduling
+
+int SimClock::advance(clock::time_point now) {
+    accumulator_ += now - last_;
+    last_ = now;
+
+    auto due = accumulator_ / tickDuration_;
+    if (due <= 0) {
+        return 0;
+    }
+
+    // The first due tick is on schedule; every extra one is catch-up work
+    // for time that already passed
+    stats_.lateTicks += static_cast<std::uint64_t>(std::min<decltype(due)>(due, maxTicksPerFrame_) - 1);
+
+    accumulator_ -= due * tickDuration_;
+    if (due > maxTicksPerFrame_) {
+        // Too far behind: run the maximum and forget the rest
+        stats_.droppedTicks += static_cast<std::uint64_t>(due - maxTicksPerFrame_);
+        due = maxTicksPerFrame_;
+    }
+
+    stats_.ticks += static_cast<std::uint64_t>(due);
+    return static_cast<int>(due);
+}
+
+SimClock::clock::time_point SimClock::nextTickTime() const {
+    return last_ + (tickDuration_ - accumulator_);
+}
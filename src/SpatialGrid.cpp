@@ -0,0 +1,140 @@
+#include "SpatialGrid.hpp"
+
+#include <algorithm>
+
+// Construction
+
+SpatialGrid::SpatialGrid(int rows, int cols)
+    : rows_{rows}, cols_{cols},
+      chunkCols_{(cols + CHUNK_SIZE - 1) / CHUNK_SIZE},
+      directory_(static_cast<std::size_t>((rows + CHUNK_SIZE - 1) / CHUNK_SIZE) * chunkCols_,
+                 NONE) {}
+
+// Chunks keep their pool slot while any entity is in them; a slot given
+// back has every bucket empty again, so it is reused as is
+SpatialGrid::Chunk& SpatialGrid::occupyChunk(int row, int col) {
+    const std::size_t index = chunkIndex(row, col);
+    std::uint32_t slot = directory_[index];
+    if (slot == NONE) {
+        if (!freeChunks_.empty()) {
+            slot = freeChunks_.back();
+            freeChunks_.pop_back();
+        } else {
+            slot = static_cast<std::uint32_t>(chunks_.size());
+            Chunk& fresh = chunks_.emplace_back();
+            fresh.head.fill(NONE);
+            fresh.count.fill(0);
+            fresh.population = 0;
+        }
+        chunks_[slot].id = static_cast<std::uint32_t>(index);
+        directory_[index] = slot;
+    }
+    return chunks_[slot];
+}
+
+void SpatialGrid::ensureEntity(std::uint32_t id) {
+    if (id >= next_.size()) {
+        std::size_t size = std::max<std::size_t>(id + 1, next_.size() * 2);
+        next_.resize(size, NONE);
+        prev_.resize(size, NONE);
+    }
+}
+
+void SpatialGrid::reserveEntities(std::size_t count) {
+    if (count > next_.size()) {
+        next_.resize(count, NONE);
+        prev_.resize(count, NONE);
+    }
+}
+
+// Incremental Updates
+
+// Push onto the front of the tile's list
+void SpatialGrid::insert(std::uint32_t id, int row, int col) {
+    if (!contains(row, col)) {
+        return;
+    }
+    ensureEntity(id);
+
+    Chunk& chunk = occupyChunk(row, col);
+    std::size_t tile = tileIndex(row, col);
+    std::uint32_t first = chunk.head[tile];
+    next_[id] = first;
+    prev_[id] = NONE;
+    if (first != NONE) {
+        prev_[first] = id;
+    }
+    chunk.head[tile] = id;
+    chunk.count[tile]++;
+    chunk.population++;
+}
+
+// Unlink from the tile's list, giving the chunk's buckets back to the pool
+// when it empties
+void SpatialGrid::remove(std::uint32_t id, int row, int col) {
+    if (!contains(row, col)) {
+        return;
+    }
+    const std::uint32_t slot = directory_[chunkIndex(row, col)];
+    if (slot == NONE) {
+        return;
+    }
+
+    Chunk& chunk = chunks_[slot];
+    std::size_t tile = tileIndex(row, col);
+    std::uint32_t before = prev_[id];
+    std::uint32_t after = next_[id];
+    if (before != NONE) {
+        next_[before] = after;
+    } else {
+        chunk.head[tile] = after;
+    }
+    if (after != NONE) {
+        prev_[after] = before;
+    }
+    next_[id] = NONE;
+    prev_[id] = NONE;
+    chunk.count[tile]--;
+    if (--chunk.population == 0) {
+        directory_[chunk.id] = NONE;
+        freeChunks_.push_back(slot);
+    }
+}
+
+void SpatialGrid::move(std::uint32_t id, int oldRow, int oldCol, int newRow, int newCol) {
+    if (oldRow == newRow && oldCol == newCol) {
+        return;
+    }
+    remove(id, oldRow, oldCol);
+    insert(id, newRow, newCol);
+}
+
+void SpatialGrid::clear() {
+    std::fill(directory_.begin(), directory_.end(), NONE);
+    chunks_.clear();
+    freeChunks_.clear();
+    std::fill(next_.begin(), next_.end(), NONE);
+    std::fill(prev_.begin(), prev_.end(), NONE);
+}
+
+// Queries
+
+std::size_t SpatialGrid::countInRadius(int row, int col, int radius) const {
+    std::size_t total = 0;
+    const int radiusSq = radius * radius;
+    for (int dr = -radius; dr <= radius; ++dr) {
+        for (int dc = -radius; dc <= radius; ++dc) {
+            if (dr * dr + dc * dc <= radiusSq) {
+                total += countAt(row + dr, col + dc);
+            }
+        }
+    }
+    return total;
+}
+
+std::size_t SpatialGrid::memoryBytes() const {
+    return directory_.capacity() * sizeof(std::uint32_t) +
+           chunks_.capacity() * sizeof(Chunk) +
+           freeChunks_.capacity() * sizeof(std::uint32_t) +
+           (next_.capacity() + prev_.capacity()) * sizeof(std::uint32_t);
+}
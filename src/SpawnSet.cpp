@@ -0,0 +1,98 @@
+#include "SpawnSet.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+// Dense Array
+
+void SpawnSet::insert(std::size_t cell) {
+    slot_[cell] = static_cast<std::uint32_t>(cells_.size());
+    cells_.push_back(static_cast<std::uint32_t>(cell));
+}
+
+// Swap the last eligible tile into the hole
+void SpawnSet::erase(std::size_t cell) {
+    const std::uint32_t hole = slot_[cell];
+    const std::uint32_t last = cells_.back();
+    cells_[hole] = last;
+    slot_[last] = hole;
+    cells_.pop_back();
+    slot_[cell] = NONE;
+}
+
+bool SpawnSet::restoreOrder(const std::uint32_t* cells, std::size_t count) {
+    if (count != cells_.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        if (cells[i] >= flags_.size() || flags_[cells[i]] != WALKABLE) {
+            return false;
+        }
+    }
+    // Same size and all eligible: it is the same set unless a tile repeats
+    for (std::uint32_t cell : cells_) {
+        slot_[cell] = NONE;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        if (slot_[cells[i]] != NONE) {
+            for (std::size_t j = 0; j < cells_.size(); ++j) {
+                slot_[cells_[j]] = static_cast<std::uint32_t>(j);
+            }
+            return false;
+        }
+        slot_[cells[i]] = static_cast<std::uint32_t>(i);
+    }
+    cells_.assign(cells, cells + count);
+    return true;
+}
+
+void SpawnSet::setFlag(std::size_t cell, std::uint8_t flag, bool on) {
+    const std::uint8_t before = flags_[cell];
+    const std::uint8_t after = on ? (before | flag) : (before & ~flag);
+    if (before == after) {
+        return;
+    }
+    flags_[cell] = after;
+    if (after == WALKABLE) {
+        insert(cell);
+    } else if (before == WALKABLE) {
+        erase(cell);
+    }
+}
+
+// Player Zone
+
+void SpawnSet::setPlayer(int row, int col) {
+    if (hasPlayer_ && row == playerRow_ && col == playerCol_) {
+        return;
+    }
+    // Tiles within this many rows/columns can be inside the zone
+    const int REACH = MIN_SPAWN_DISTANCE - 1;
+
+    const bool hadPlayer = hasPlayer_;
+    const int oldRow = playerRow_;
+    const int oldCol = playerCol_;
+    hasPlayer_ = true;
+    playerRow_ = row;
+    playerCol_ = col;
+
+    // Re-test every tile in the old zone's box and the new zone's box
+    auto refresh = [&](int centerRow, int centerCol, bool skipOldBox) {
+        const int top = std::max(centerRow - REACH, originRow_);
+        const int bottom = std::min(centerRow + REACH, originRow_ + rows_ - 1);
+        const int left = std::max(centerCol - REACH, originCol_);
+        const int right = std::min(centerCol + REACH, originCol_ + cols_ - 1);
+        for (int r = top; r <= bottom; ++r) {
+            for (int c = left; c <= right; ++c) {
+                if (skipOldBox && std::abs(r - oldRow) <= REACH && std::abs(c - oldCol) <= REACH) {
+                    continue;
+                }
+                setFlag(cellIndex(r, c), NEAR_PLAYER, nearPlayer(r, c));
+            }
+        }
+    };
+    if (hadPlayer) {
+        refresh(oldRow, oldCol, false);
+    }
+    refresh(row, col, hadPlayer);
+}
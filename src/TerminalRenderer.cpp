@@ -0,0 +1,287 @@
+#include "TerminalRenderer.hpp"
+#include "Profiler.hpp"
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+// Escape Sequences
+
+namespace {
+constexpr char HIDE_CURSOR[] = "\033[?25l";
+constexpr char SHOW_CURSOR[] = "\033[?25h";
+constexpr char CLEAR_SCREEN[] = "\033[2J";
+constexpr char CLEAR_BELOW[] = "\033[J";
+constexpr char STYLE_DIM[] = "\033[2m";
+constexpr char STYLE_NORMAL[] = "\033[22m";
+
+// Longest style switch we emit
+constexpr std::size_t MAX_STYLE_BYTES = sizeof(STYLE_NORMAL) - 1;
+
+// Longest cursor move we emit: ESC [ rrrrr ; ccccc H
+constexpr std::size_t MAX_MOVE_BYTES = 16;
+
+// Unchanged cells shorter than this are rewritten instead of skipped,
+// since a cursor move costs at least as many bytes
+constexpr int MIN_SKIP_RUN = 6;
+
+// Set by SIGWINCH (and initially) until the size is read again
+std::atomic<bool> terminalResized{true};
+
+extern "C" void onWindowChange(int) {
+    terminalResized.store(true, std::memory_order_relaxed);
+}
+}  // namespace
+
+// Construction
+
+TerminalRenderer::TerminalRenderer(int rows, int cols)
+    : front_{rows, cols} {
+    resize(rows, cols);
+
+    struct sigaction action {};
+    action.sa_handler = onWindowChange;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    sigaction(SIGWINCH, &action, nullptr);
+}
+
+// Worst case output: every row split into as many changed runs as the gap
+// rule allows, each with its own cursor move, a style switch before every
+// cell, plus the clear/hide/park sequences. Allocating once keeps present()
+// heap-free.
+void TerminalRenderer::resize(int rows, int cols) {
+    if (front_.rows() != rows || front_.cols() != cols) {
+        front_ = CellGrid{rows, cols};
+        fullRedraw_.store(true, std::memory_order_relaxed);
+    }
+    std::size_t movesPerRow = static_cast<std::size_t>(cols / (MIN_SKIP_RUN + 1) + 1);
+    out_.resize(static_cast<std::size_t>(rows) *
+                    (cols * (1 + MAX_STYLE_BYTES) + movesPerRow * MAX_MOVE_BYTES) +
+                4 * MAX_MOVE_BYTES + MAX_STYLE_BYTES);
+}
+
+TerminalRenderer::~TerminalRenderer() {
+    if (cursorHidden_) {
+        outSize_ = 0;
+        appendBytes(SHOW_CURSOR, sizeof(SHOW_CURSOR) - 1);
+        flush();
+    }
+}
+
+// Frame Output
+
+void TerminalRenderer::invalidate() {
+    fullRedraw_.store(true, std::memory_order_release);
+}
+
+bool TerminalRenderer::preferredSize(int& rows, int& cols) {
+    std::lock_guard<std::mutex> lock{presentMutex_};
+    if (terminalResized.exchange(false, std::memory_order_relaxed)) {
+        winsize size{};
+        if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_row > 1 && size.ws_col > 0) {
+            terminalRows_ = size.ws_row - 1;
+            terminalCols_ = size.ws_col;
+        } else {
+            terminalRows_ = 0;
+            terminalCols_ = 0;
+        }
+        // Terminals rewrap or drop their contents on resize
+        fullRedraw_.store(true, std::memory_order_release);
+    }
+    if (terminalRows_ == 0) {
+        return false;
+    }
+    rows = terminalRows_;
+    cols = terminalCols_;
+    return true;
+}
+
+void TerminalRenderer::present(const CellGrid& frame) {
+    std::lock_guard<std::mutex> lock{presentMutex_};
+
+    if (frame.rows() != front_.rows() || frame.cols() != front_.cols()) {
+        resize(frame.rows(), frame.cols());
+    }
+
+    outSize_ = 0;
+    flushedBytes_ = 0;
+    lastFrameCells_ = 0;
+
+    const int rows = front_.rows();
+    const int cols = front_.cols();
+
+    if (!cursorHidden_) {
+        appendBytes(HIDE_CURSOR, sizeof(HIDE_CURSOR) - 1);
+        cursorHidden_ = true;
+    }
+
+    if (fullRedraw_.exchange(false, std::memory_order_acq_rel)) {
+        // Screen contents are unknown: clear and paint every row
+        appendBytes(CLEAR_SCREEN, sizeof(CLEAR_SCREEN) - 1);
+        for (int r = 0; r < rows; ++r) {
+            appendMoveCursor(r, 0);
+            appendCells(frame, r, 0, cols);
+        }
+        lastFrameCells_ = rows * cols;
+        front_ = frame;
+    } else {
+        // Walk each row and emit runs of changed cells
+        for (int r = 0; r < rows; ++r) {
+            const char* next = frame.rowData(r);
+            const char* shown = front_.rowData(r);
+            const CellStyle* nextStyle = frame.styleRowData(r);
+            const CellStyle* shownStyle = front_.styleRowData(r);
+
+            if (std::memcmp(next, shown, static_cast<std::size_t>(cols)) == 0 &&
+                std::memcmp(nextStyle, shownStyle, static_cast<std::size_t>(cols) * sizeof(CellStyle)) == 0) {
+                continue;  // Row unchanged - the common case
+            }
+            auto changed = [&](int i) {
+                return next[i] != shown[i] || nextStyle[i] != shownStyle[i];
+            };
+
+            int c = 0;
+            while (c < cols) {
+                if (!changed(c)) {
+                    ++c;
+                    continue;
+                }
+
+                // Found a changed cell: extend the run, absorbing short gaps
+                // of unchanged cells so we don't pay for extra cursor moves
+                int runEnd = c + 1;
+                int gap = 0;
+                for (int i = runEnd; i < cols && gap < MIN_SKIP_RUN; ++i) {
+                    if (changed(i)) {
+                        runEnd = i + 1;
+                        gap = 0;
+                    } else {
+                        ++gap;
+                    }
+                }
+
+                appendMoveCursor(r, c);
+                appendCells(frame, r, c, runEnd);
+                lastFrameCells_ += runEnd - c;
+                c = runEnd;
+            }
+        }
+
+        if (lastFrameCells_ == 0) {
+            // Nothing changed: no bytes, no syscall
+            lastFrameBytes_ = flushedBytes_ + outSize_;
+            if (outSize_ > 0) {
+                flush();
+            }
+            PROFILE_COUNT(BytesWritten, lastFrameBytes_);
+            PROFILE_COUNT(CellsChanged, 0);
+            return;
+        }
+        front_ = frame;
+    }
+
+    // Park the cursor below the frame and clear anything that was printed
+    // there since the last frame, so stray output never accumulates
+    if (pen_ != CellStyle::Normal) {
+        appendBytes(STYLE_NORMAL, sizeof(STYLE_NORMAL) - 1);
+        pen_ = CellStyle::Normal;
+    }
+    appendMoveCursor(rows, 0);
+    appendBytes(CLEAR_BELOW, sizeof(CLEAR_BELOW) - 1);
+
+    lastFrameBytes_ = flushedBytes_ + outSize_;
+    flush();
+    PROFILE_COUNT(BytesWritten, lastFrameBytes_);
+    PROFILE_COUNT(CellsChanged, static_cast<std::uint64_t>(lastFrameCells_));
+}
+
+// Output Buffer Helpers
+
+// resize() sizes the buffer for the worst case, so a frame normally goes
+// out in one write; should that estimate ever fall short, what is queued
+// so far is written early rather than running past the buffer
+void TerminalRenderer::appendBytes(const char* data, std::size_t n) {
+    if (outSize_ + n > out_.size()) {
+        flushedBytes_ += outSize_;
+        flush();
+        if (n > out_.size()) {
+            out_.resize(n);
+        }
+    }
+    std::memcpy(out_.data() + outSize_, data, n);
+    outSize_ += n;
+}
+
+// Append cells [begin, end) of a row, switching style where it changes
+void TerminalRenderer::appendCells(const CellGrid& frame, int row, int begin, int end) {
+    const char* cells = frame.rowData(row);
+    const CellStyle* styles = frame.styleRowData(row);
+    int runStart = begin;
+    for (int c = begin; c < end; ++c) {
+        if (styles[c] == pen_) {
+            continue;
+        }
+        appendBytes(cells + runStart, static_cast<std::size_t>(c - runStart));
+        if (styles[c] == CellStyle::Dim) {
+            appendBytes(STYLE_DIM, sizeof(STYLE_DIM) - 1);
+        } else {
+            appendBytes(STYLE_NORMAL, sizeof(STYLE_NORMAL) - 1);
+        }
+        pen_ = styles[c];
+        runStart = c;
+    }
+    appendBytes(cells + runStart, static_cast<std::size_t>(end - runStart));
+}
+
+// Append ESC[row;colH (1-based) without going through printf
+void TerminalRenderer::appendMoveCursor(int row, int col) {
+    char buf[MAX_MOVE_BYTES];
+    std::size_t n = 0;
+    buf[n++] = '\033';
+    buf[n++] = '[';
+
+    auto appendNumber = [&](int value) {
+        char digits[8];
+        int count = 0;
+        do {
+            digits[count++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value > 0 && count < 8);
+        while (count > 0) {
+            buf[n++] = digits[--count];
+        }
+    };
+
+    appendNumber(row + 1);
+    buf[n++] = ';';
+    appendNumber(col + 1);
+    buf[n++] = 'H';
+
+    appendBytes(buf, n);
+}
+
+// Hand the queued frame to the terminal in one write() call
+void TerminalRenderer::flush() {
+    // Anything still sitting in iostream buffers must reach the terminal
+    // before our frame, or the two streams interleave out of order
+    std::cout.flush();
+
+    const char* data = out_.data();
+    std::size_t remaining = outSize_;
+    while (remaining > 0) {
+        ssize_t n = write(STDOUT_FILENO, data, remaining);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;  // Terminal gone - nothing useful to do
+        }
+        data += n;
+        remaining -= static_cast<std::size_t>(n);
+    }
+    outSize_ = 0;
+}
@@ -0,0 +1,142 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+
+// Construction
+
+ThreadPool::ThreadPool(unsigned threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    queues_.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) {
+        queues_.push_back(std::make_unique<WorkQueue>());
+    }
+
+    // Queue 0 belongs to whichever thread calls parallelFor
+    workers_.reserve(threads - 1);
+    for (unsigned i = 1; i < threads; ++i) {
+        workers_.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock{stateMutex_};
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+// Parallel Loop
+
+void ThreadPool::parallelFor(std::size_t count, std::size_t chunkSize, const RangeFn& fn) {
+    if (count == 0) {
+        return;
+    }
+    chunkSize = std::max<std::size_t>(chunkSize, 1);
+    const std::size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+
+    // Nothing to share - skip the handoff entirely
+    if (workers_.empty() || chunkCount == 1) {
+        for (std::size_t begin = 0; begin < count; begin += chunkSize) {
+            fn(begin, std::min(begin + chunkSize, count));
+        }
+        return;
+    }
+
+    // Deal out contiguous runs of chunks, one run per participant
+    const std::size_t participants = queues_.size();
+    for (std::size_t p = 0; p < participants; ++p) {
+        std::size_t first = p * chunkCount / participants;
+        std::size_t last = (p + 1) * chunkCount / participants;
+        WorkQueue& queue = *queues_[p];
+        std::lock_guard<std::mutex> lock{queue.mutex};
+        for (std::size_t c = first; c < last; ++c) {
+            std::size_t begin = c * chunkSize;
+            queue.chunks.push_back({begin, std::min(begin + chunkSize, count)});
+        }
+    }
+
+    // Wake the workers
+    {
+        std::lock_guard<std::mutex> lock{stateMutex_};
+        job_ = &fn;
+        generation_++;
+        busyWorkers_ = static_cast<unsigned>(workers_.size());
+    }
+    wake_.notify_all();
+
+    // The caller works too
+    runChunks(0);
+
+    // Every queue is empty now, but workers may still be inside a chunk
+    std::unique_lock<std::mutex> lock{stateMutex_};
+    done_.wait(lock, [this] { return busyWorkers_ == 0; });
+    job_ = nullptr;
+}
+
+// Workers
+
+void ThreadPool::workerLoop(unsigned self) {
+    std::uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock{stateMutex_};
+            wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+            if (stopping_) {
+                return;
+            }
+            seen = generation_;
+        }
+
+        runChunks(self);
+
+        {
+            std::lock_guard<std::mutex> lock{stateMutex_};
+            if (--busyWorkers_ == 0) {
+                done_.notify_one();
+            }
+        }
+    }
+}
+
+void ThreadPool::runChunks(unsigned self) {
+    const RangeFn& fn = *job_;
+    Chunk chunk;
+    while (popOwn(self, chunk) || steal(self, chunk)) {
+        fn(chunk.begin, chunk.end);
+    }
+}
+
+// Own queue: take from the front (chunks stay in ascending order)
+bool ThreadPool::popOwn(unsigned self, Chunk& out) {
+    WorkQueue& queue = *queues_[self];
+    std::lock_guard<std::mutex> lock{queue.mutex};
+    if (queue.chunks.empty()) {
+        return false;
+    }
+    out = queue.chunks.front();
+    queue.chunks.pop_front();
+    return true;
+}
+
+// Other queues: take from the back, far from where the owner is working
+bool ThreadPool::steal(unsigned self, Chunk& out) {
+    const std::size_t participants = queues_.size();
+    for (std::size_t offset = 1; offset < participants; ++offset) {
+        WorkQueue& victim = *queues_[(self + offset) % participants];
+        std::lock_guard<std::mutex> lock{victim.mutex};
+        if (!victim.chunks.empty()) {
+            out = victim.chunks.back();
+            victim.chunks.pop_back();
+            steals_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,336 @@
+#include "TileMap.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+// File Format Helpers
+
+namespace {
+constexpr char MAGIC[4] = {'D', 'C', 'M', 'P'};
+
+std::uint32_t getU32(const std::uint8_t* in) {
+    std::uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        value |= static_cast<std::uint32_t>(in[i]) << (i * 8);
+    }
+    return value;
+}
+
+std::uint64_t getU64(const std::uint8_t* in) {
+    std::uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) {
+        value |= static_cast<std::uint64_t>(in[i]) << (i * 8);
+    }
+    return value;
+}
+
+void putLittleEndian(std::vector<std::uint8_t>& out, std::uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        out.push_back(static_cast<std::uint8_t>(value >> (i * 8)));
+    }
+}
+}  // namespace
+
+// Construction
+
+namespace {
+bool fitsFlat(int rows, int cols) {
+    return static_cast<std::size_t>(rows) * static_cast<std::size_t>(cols) <=
+           TileMap::FLAT_MAX_TILES;
+}
+}  // namespace
+
+// Copy every chunk into a whole-world grid (small worlds only)
+template <typename Grid>
+void TileMap::loadFlat(Grid& grid) const {
+    ChunkBits bits;
+    for (int chunkRow = 0; chunkRow < chunkRows_; ++chunkRow) {
+        for (int chunkCol = 0; chunkCol < chunkCols_; ++chunkCol) {
+            loadChunk(static_cast<std::uint32_t>(chunkRow * chunkCols_ + chunkCol), bits);
+            for (int r = 0; r < CHUNK_SIZE; ++r) {
+                for (int c = 0; c < CHUNK_SIZE; ++c) {
+                    int bit = r * CHUNK_SIZE + c;
+                    grid.setWalkable(chunkRow * CHUNK_SIZE + r, chunkCol * CHUNK_SIZE + c,
+                                     (bits[bit / 64] >> (bit % 64)) & 1);
+                }
+            }
+        }
+    }
+}
+
+TileMap::TileMap(int rows, int cols)
+    : rows_{rows}, cols_{cols},
+      chunkRows_{(rows + CHUNK_SIZE - 1) / CHUNK_SIZE},
+      chunkCols_{(cols + CHUNK_SIZE - 1) / CHUNK_SIZE} {
+    if (rows == RoomGrid::ROWS && cols == RoomGrid::COLS) {
+        loadFlat(flat_.emplace<RoomGrid>());
+    } else if (fitsFlat(rows, cols)) {
+        loadFlat(flat_.emplace<FlatGrid>(rows, cols));
+    } else {
+        resident_ = std::make_unique<std::atomic<const ChunkBits*>[]>(
+            static_cast<std::size_t>(chunkRows_) * chunkCols_);
+    }
+}
+
+TileMap::TileMap(const std::string& path)
+    : file_{path} {
+    if (!file_.isOpen()) {
+        error_ = file_.error();
+        return;
+    }
+    const std::uint8_t* header = file_.data();
+    if (file_.size() < HEADER_SIZE || std::memcmp(header, MAGIC, sizeof(MAGIC)) != 0) {
+        error_ = path + ": not a map file";
+        return;
+    }
+    std::uint16_t version = static_cast<std::uint16_t>(header[4] | (header[5] << 8));
+    std::uint16_t chunkSize = static_cast<std::uint16_t>(header[6] | (header[7] << 8));
+    if (version != VERSION || chunkSize != CHUNK_SIZE) {
+        error_ = path + ": unsupported map version " + std::to_string(version);
+        return;
+    }
+
+    std::uint32_t rows = getU32(header + 8);
+    std::uint32_t cols = getU32(header + 12);
+    if (rows == 0 || cols == 0 || rows > 0x7FFFFFFFu / cols) {
+        error_ = path + ": bad map size";
+        return;
+    }
+    rows_ = static_cast<int>(rows);
+    cols_ = static_cast<int>(cols);
+    chunkRows_ = (rows_ + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    chunkCols_ = (cols_ + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+    std::size_t expected = HEADER_SIZE +
+        static_cast<std::size_t>(chunkRows_) * chunkCols_ * CHUNK_BYTES;
+    if (file_.size() < expected) {
+        error_ = path + ": map truncated";
+        return;
+    }
+
+    if (fitsFlat(rows_, cols_)) {
+        loadFlat(flat_.emplace<FlatGrid>(rows_, cols_));
+        return;
+    }
+
+    resident_ = std::make_unique<std::atomic<const ChunkBits*>[]>(
+        static_cast<std::size_t>(chunkRows_) * chunkCols_);
+
+    // Chunks are read wherever the player goes, not front to back
+    file_.adviseRandom();
+}
+
+// Chunk Residency
+
+TileMap::ChunkBits& TileMap::residentChunk(std::uint32_t id) const {
+    auto it = slotOf_.find(id);
+    if (it != slotOf_.end()) {
+        return slots_[it->second];
+    }
+
+    std::uint32_t slot;
+    if (!freeSlots_.empty()) {
+        slot = freeSlots_.back();
+        freeSlots_.pop_back();
+    } else {
+        slot = static_cast<std::uint32_t>(slots_.size());
+        slots_.emplace_back();
+        slotChunk_.push_back(0);
+        slotPinned_.push_back(0);
+    }
+    slotChunk_[slot] = id;
+    slotPinned_[slot] = 0;
+    slotOf_.emplace(id, slot);
+
+    // A reused slot may still be read by a lookup that found it before it
+    // was evicted; the fence makes sure that lookup sees the table change
+    // once it has seen any of the new words, so it retries
+    ChunkBits loaded;
+    loadChunk(id, loaded);
+    ChunkBits& bits = slots_[slot];
+    std::atomic_thread_fence(std::memory_order_release);
+    for (int w = 0; w < CHUNK_WORDS; ++w) {
+        storeWord(bits[w], loaded[w]);
+    }
+    resident_[id].store(&bits, std::memory_order_release);
+    loads_++;
+    return bits;
+}
+
+void TileMap::loadChunk(std::uint32_t id, ChunkBits& bits) const {
+    if (file_.data()) {
+        const std::uint8_t* in = file_.data() + HEADER_SIZE + id * CHUNK_BYTES;
+        for (int w = 0; w < CHUNK_WORDS; ++w) {
+            bits[w] = getU64(in + w * 8);
+        }
+        return;
+    }
+
+    // Generated room: floor everywhere except the outermost ring
+    bits.fill(0);
+    const int baseRow = static_cast<int>(id / chunkCols_) * CHUNK_SIZE;
+    const int baseCol = static_cast<int>(id % chunkCols_) * CHUNK_SIZE;
+    for (int r = 0; r < CHUNK_SIZE; ++r) {
+        for (int c = 0; c < CHUNK_SIZE; ++c) {
+            int row = baseRow + r;
+            int col = baseCol + c;
+            if (row >= 1 && row < rows_ - 1 && col >= 1 && col < cols_ - 1) {
+                int bit = r * CHUNK_SIZE + c;
+                bits[bit / 64] |= std::uint64_t{1} << (bit % 64);
+            }
+        }
+    }
+}
+
+std::size_t TileMap::evictOutside(int row, int col, int radiusChunks) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    const int centerRow = row / CHUNK_SIZE;
+    const int centerCol = col / CHUNK_SIZE;
+
+    // Nothing can have become far since last time
+    const std::uint32_t center = static_cast<std::uint32_t>(centerRow * chunkCols_ + centerCol);
+    if (center == lastEvictChunk_ && radiusChunks == lastEvictRadius_ &&
+        loads_ == loadsAtLastEvict_) {
+        return 0;
+    }
+    lastEvictChunk_ = center;
+    lastEvictRadius_ = radiusChunks;
+    loadsAtLastEvict_ = loads_;
+
+    std::size_t evicted = 0;
+    for (auto it = slotOf_.begin(); it != slotOf_.end();) {
+        const int chunkRow = static_cast<int>(it->first / chunkCols_);
+        const int chunkCol = static_cast<int>(it->first % chunkCols_);
+        const bool far = std::abs(chunkRow - centerRow) > radiusChunks ||
+                         std::abs(chunkCol - centerCol) > radiusChunks;
+        if (far && !slotPinned_[it->second]) {
+            resident_[it->first].store(nullptr, std::memory_order_relaxed);
+            freeSlots_.push_back(it->second);
+            it = slotOf_.erase(it);
+            evicted++;
+        } else {
+            ++it;
+        }
+    }
+
+    // Every resident chunk is a private copy, so none of the file's pages
+    // are needed any more; the OS refaults them if a chunk is reloaded
+    if (evicted > 0) {
+        file_.dropPages(0, file_.size());
+    }
+    return evicted;
+}
+
+std::size_t TileMap::residentChunks() const {
+    std::lock_guard<std::mutex> lock{mutex_};
+    return slotOf_.size();
+}
+
+std::uint64_t TileMap::chunkLoads() const {
+    std::lock_guard<std::mutex> lock{mutex_};
+    return loads_;
+}
+
+// Tiles
+
+bool TileMap::loadAndTest(std::uint32_t id, int bit) const {
+    std::lock_guard<std::mutex> lock{mutex_};
+    const ChunkBits& bits = residentChunk(id);
+    return (bits[bit / 64] >> (bit % 64)) & 1;
+}
+
+void TileMap::setWalkable(int row, int col, bool walkable) {
+    if (!contains(row, col)) {
+        return;
+    }
+    if (RoomGrid* room = std::get_if<RoomGrid>(&flat_)) {
+        room->setWalkable(row, col, walkable);
+        return;
+    }
+    if (FlatGrid* grid = std::get_if<FlatGrid>(&flat_)) {
+        grid->setWalkable(row, col, walkable);
+        return;
+    }
+    std::lock_guard<std::mutex> lock{mutex_};
+    const std::uint32_t id = chunkId(row, col);
+    ChunkBits& bits = residentChunk(id);
+    slotPinned_[slotOf_.at(id)] = 1;
+
+    const int bit = bitIndex(row, col);
+    const std::uint64_t mask = std::uint64_t{1} << (bit % 64);
+    storeWord(bits[bit / 64], walkable ? (bits[bit / 64] | mask) : (bits[bit / 64] & ~mask));
+}
+
+bool TileMap::findWalkableNear(int row, int col, int maxRadius, int& outRow, int& outCol) const {
+    for (int radius = 0; radius <= maxRadius; ++radius) {
+        for (int r = row - radius; r <= row + radius; ++r) {
+            // Full rows at the top and bottom of the ring, ends in between
+            const bool edge = r == row - radius || r == row + radius;
+            const int step = edge ? 1 : std::max(1, 2 * radius);
+            for (int c = col - radius; c <= col + radius; c += step) {
+                if (isWalkable(r, c)) {
+                    outRow = r;
+                    outCol = c;
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+// Map Files
+
+bool TileMap::writeFile(const std::string& path, int rows, int cols,
+                        const std::function<bool(int, int)>& isWalkable,
+                        std::string& error) {
+    if (rows <= 0 || cols <= 0) {
+        error = "bad map size";
+        return false;
+    }
+    std::ofstream out{path, std::ios::binary | std::ios::trunc};
+    if (!out) {
+        error = path + ": cannot open for writing";
+        return false;
+    }
+
+    std::vector<std::uint8_t> buffer;
+    buffer.insert(buffer.end(), MAGIC, MAGIC + sizeof(MAGIC));
+    putLittleEndian(buffer, VERSION, 2);
+    putLittleEndian(buffer, CHUNK_SIZE, 2);
+    putLittleEndian(buffer, static_cast<std::uint32_t>(rows), 4);
+    putLittleEndian(buffer, static_cast<std::uint32_t>(cols), 4);
+
+    // One band of chunks at a time keeps the buffer small for huge maps
+    const int chunkRows = (rows + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    const int chunkCols = (cols + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    for (int cr = 0; cr < chunkRows; ++cr) {
+        for (int cc = 0; cc < chunkCols; ++cc) {
+            ChunkBits bits{};
+            for (int r = 0; r < CHUNK_SIZE; ++r) {
+                for (int c = 0; c < CHUNK_SIZE; ++c) {
+                    int row = cr * CHUNK_SIZE + r;
+                    int col = cc * CHUNK_SIZE + c;
+                    if (row < rows && col < cols && isWalkable(row, col)) {
+                        int bit = r * CHUNK_SIZE + c;
+                        bits[bit / 64] |= std::uint64_t{1} << (bit % 64);
+                    }
+                }
+            }
+            for (std::uint64_t word : bits) {
+                putLittleEndian(buffer, word, 8);
+            }
+        }
+        out.write(reinterpret_cast<const char*>(buffer.data()),
+                  static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+    }
+
+    if (!out) {
+        error = path + ": write failed";
+        return false;
+    }
+    return true;
+}
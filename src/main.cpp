@@ -1,14 +1,394 @@
 #include "GameState.hpp"
 #include "GameLoop.hpp"
+#include "Profiler.hpp"
 #include "Renderer.hpp"
+#include "Enemy.hpp"
+#include "EventLog.hpp"
+#include "Replay.hpp"
+#include "SaveGame.hpp"
+#include "TileMap.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
 #include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
 
 // ============================================================================
 // main.cpp
 // Entry point for the dungeon crawler game
 // ============================================================================
 
-int main() {
+// ----------------------------------------------------------------------------
+// Command Line
+// ----------------------------------------------------------------------------
+
+static void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [--record FILE] [--headless [options]]\n"
+              << "       " << program << " --replay FILE\n"
+              << "\n"
+              << "  --record FILE      Log every key plus the RNG seed to FILE\n"
+              << "  --replay FILE      Re-run a recorded session headless and verify\n"
+              << "                     its final state hash\n"
+              << "  --map FILE         Play on a map file instead of the default room\n"
+              << "                     (replays need the map they were recorded on)\n"
+              << "  --log FILE         Also write combat and level-up messages to FILE\n"
+              << "  --save FILE        Autosave to FILE every 30 s of game time and on exit\n"
+              << "  --load FILE        Resume the game saved in FILE (not with replays)\n"
+              << "  --profile NAME     Time each phase of the loop (shown on the HUD), then\n"
+              << "                     write NAME.json (Chrome trace) and NAME.csv\n"
+              << "\n"
+              << "Headless mode runs the simulation without a terminal as fast\n"
+              << "as possible and reports throughput.\n"
+              << "  --ticks N          Ticks to simulate (default 1000000)\n"
+              << "  --seed N           Seed for random input (default 1)\n"
+              << "  --script KEYS      Replay KEYS in a loop instead of random WASD\n"
+              << "  --key-interval N   Ticks between key presses (default 10)\n"
+              << "  --render-every N   Compose a frame in memory every N ticks\n"
+              << "\n"
+              << "  --enemies N        Enemies in the world (default 1)\n"
+              << "  --ai-threads N     Threads for enemy AI (default: one per core)\n";
+}
+
+// Files named on the command line (nullptr = not given)
+struct FileOptions {
+    const char* record = nullptr;
+    const char* replay = nullptr;
+    const char* map = nullptr;
+    const char* log = nullptr;
+    const char* save = nullptr;
+    const char* load = nullptr;
+    const char* profile = nullptr;
+};
+
+// Parse a non-negative integer argument, rejecting trailing junk
+static bool parseNumber(const char* text, unsigned long long& out) {
+    char* end = nullptr;
+    out = std::strtoull(text, &end, 10);
+    return end != text && *end == '\0' && text[0] != '-';
+}
+
+// ----------------------------------------------------------------------------
+// Headless Mode
+// ----------------------------------------------------------------------------
+
+// Enemy pool size for a starting population (room for at least the default)
+static std::size_t enemyPoolCapacity(std::size_t enemyCount) {
+    return std::max(enemyCount, EnemyStore::DEFAULT_CAPACITY);
+}
+
+// Open the world map from a file, or the default generated room without one
+// Returns: false (after reporting why) if the file is unusable
+static bool loadWorld(const char* mapPath, std::shared_ptr<TileMap>& world) {
+    if (!mapPath) {
+        world = std::make_shared<TileMap>(GameState::MAP_ROWS, GameState::MAP_COLS);
+        return true;
+    }
+    world = std::make_shared<TileMap>(std::string{mapPath});
+    if (!world->isValid()) {
+        std::cerr << "Cannot load map: " << world->error() << "\n";
+        return false;
+    }
+    return true;
+}
+
+// Build the starting state: the game saved in loadPath if given, else a
+// new one with enemyCount enemies spawned from seed
+// Returns: nullptr (after reporting why) if the save cannot be loaded
+static std::unique_ptr<GameState> startGame(const char* loadPath, std::size_t enemyCount,
+                                            std::uint32_t seed,
+                                            std::shared_ptr<TileMap> world) {
+    if (loadPath) {
+        SaveReader save{loadPath};
+        if (!save.isValid()) {
+            std::cerr << "Cannot load save: " << save.error() << "\n";
+            return nullptr;
+        }
+        auto state = std::make_unique<GameState>(100, 2, save.enemyCapacity(), std::move(world));
+        if (!save.restore(*state)) {
+            std::cerr << "Cannot load save: " << save.error() << "\n";
+            return nullptr;
+        }
+        return state;
+    }
+
+    // Parameters: player health, player attack damage, enemy pool size, world
+    auto state = std::make_unique<GameState>(100, 2, enemyPoolCapacity(enemyCount),
+                                             std::move(world));
+    seedEnemyRandom(*state, seed);
+    if (enemyCount > state->enemies.size()) {
+        spawnEnemies(*state, enemyCount - state->enemies.size());
+    }
+    if (state->enemies.size() < enemyCount) {
+        std::cerr << "Only " << state->enemies.size() << " of " << enemyCount
+                  << " enemies fit (no free floor tiles left away from the player)\n";
+    }
+    return state;
+}
+
+// Autosave to savePath, if given, every AUTOSAVE_SECONDS of game time
+static std::unique_ptr<AutoSaver> startAutosave(const char* savePath, const GameState& state) {
+    const std::uint64_t AUTOSAVE_SECONDS = 30;
+    if (!savePath) {
+        return nullptr;
+    }
+    return std::make_unique<AutoSaver>(
+        savePath, AUTOSAVE_SECONDS * static_cast<std::uint64_t>(state.ticksPerSecond));
+}
+
+// Wait for the last save to reach the disk and report how autosave went
+static void finishAutosave(AutoSaver* autosaver, const char* savePath) {
+    if (!autosaver) {
+        return;
+    }
+    autosaver->finish();
+    if (!autosaver->lastError().empty()) {
+        std::cerr << "Autosave failed: " << autosaver->lastError() << "\n";
+    } else if (autosaver->savesWritten() > 0) {
+        std::cout << "Game saved to " << savePath << "\n";
+    }
+}
+
+// Start copying the game's messages to a file, if one was asked for
+// Returns: false (after reporting why) if the file cannot be written
+static bool openEventLog(const char* logPath, const GameState& state,
+                         std::unique_ptr<EventLogFile>& logFile) {
+    if (!logPath) {
+        return true;
+    }
+    logFile = std::make_unique<EventLogFile>(state.log, logPath);
+    if (!logFile->isOpen()) {
+        std::cerr << "Cannot write log: " << logPath << "\n";
+        return false;
+    }
+    return true;
+}
+
+// Turn the profiler on if a profile was asked for
+static void startProfiling(const char* profileName) {
+    if (!profileName) {
+        return;
+    }
+#if GAME_PROFILING
+    Profiler::setEnabled(true);
+#else
+    std::cerr << "Profiling was left out of this build (GAME_PROFILING=0); "
+              << "--profile ignored\n";
+#endif
+}
+
+// Write the profile as NAME.json and NAME.csv and print where time went
+static void finishProfiling(const char* profileName) {
+    if (!profileName || !Profiler::isEnabled()) {
+        return;
+    }
+    Profiler::setEnabled(false);
+
+    const std::string name = profileName;
+    std::string error;
+    if (!Profiler::writeChromeTrace(name + ".json", error) ||
+        !Profiler::writeCsv(name + ".csv", error)) {
+        std::cerr << "Cannot write profile: " << error << "\n";
+        return;
+    }
+
+    std::cout << "Profile (microseconds):\n";
+    std::cout << "  phase            count      mean       p50       p99       max\n";
+    for (int p = 0; p < static_cast<int>(ProfilePhase::Count); ++p) {
+        const ProfileSummary s = Profiler::summary(static_cast<ProfilePhase>(p));
+        if (s.count == 0) {
+            continue;
+        }
+        char line[128];
+        std::snprintf(line, sizeof(line), "  %-14s %7llu %9.1f %9.1f %9.1f %9.1f\n",
+                      profilePhaseName(static_cast<ProfilePhase>(p)),
+                      static_cast<unsigned long long>(s.count), s.mean() / 1000.0,
+                      s.p50 / 1000.0, s.p99 / 1000.0, s.max / 1000.0);
+        std::cout << line;
+    }
+    std::cout << "Profile written to " << name << ".json and " << name << ".csv\n";
+}
+
+static int runHeadlessMode(const HeadlessConfig& config, std::size_t enemyCount,
+                           const FileOptions& files, std::shared_ptr<TileMap> world) {
+    // Same seed drives input and enemy spawns, so runs are reproducible
+    std::unique_ptr<GameState> game = startGame(files.load, enemyCount, config.seed,
+                                                std::move(world));
+    if (!game) {
+        return 1;
+    }
+    GameState& state = *game;
+
+    std::unique_ptr<ReplayRecorder> recorder;
+    if (files.record) {
+        recorder = std::make_unique<ReplayRecorder>(files.record, config.seed,
+                                                    state.ticksPerSecond,
+                                                    state.enemies.size());
+        if (!recorder->isOpen()) {
+            std::cerr << "Cannot write replay: " << files.record << "\n";
+            return 1;
+        }
+    }
+
+    std::unique_ptr<EventLogFile> logFile;
+    if (!openEventLog(files.log, state, logFile)) {
+        return 1;
+    }
+
+    std::unique_ptr<AutoSaver> autosaver = startAutosave(files.save, state);
+    startProfiling(files.profile);
+    HeadlessResult result = runHeadless(state, config, recorder.get(), autosaver.get());
+
+    double ticksPerSecond = result.seconds > 0.0 ? result.ticksRun / result.seconds : 0.0;
+
+    std::cout << "Headless run complete\n";
+    std::cout << "  Ticks:            " << result.ticksRun << "\n";
+    std::cout << "  Total time:       " << result.seconds << " s\n";
+    std::cout << "  Ticks/sec:        " << static_cast<unsigned long long>(ticksPerSecond) << "\n";
+    if (config.renderEvery > 0) {
+        std::cout << "  Frames rendered:  " << result.framesRendered << "\n";
+    }
+    std::cout << "Final stats:\n";
+    std::cout << "  Level:            " << state.player.level << "\n";
+    std::cout << "  Health:           " << state.player.health
+              << "/" << state.player.maxHealth << "\n";
+    std::cout << "  Attack:           " << state.player.attack << "\n";
+    std::cout << "  Experience:       " << state.player.experience << "\n";
+    std::cout << "  Enemies Defeated: " << state.enemiesDefeated << "\n";
+    std::cout << "  Player alive:     " << (state.player.health > 0 ? "yes" : "no") << "\n";
+    if (logFile) {
+        logFile.reset();  // Flush the last messages before counting them
+        std::cout << "  Log messages:     " << state.log->written() << "\n";
+    }
+    finishAutosave(autosaver.get(), files.save);
+    finishProfiling(files.profile);
+
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Replay Mode
+// ----------------------------------------------------------------------------
+
+static int runReplayMode(const char* path, const char* logPath,
+                         std::shared_ptr<TileMap> world) {
+    ReplayReader reader{path};
+    if (!reader.isValid()) {
+        std::cerr << "Cannot replay: " << reader.error() << "\n";
+        return 1;
+    }
+
+    GameState state{100, 2, enemyPoolCapacity(reader.enemyCount()), std::move(world)};
+    std::unique_ptr<EventLogFile> logFile;
+    if (!openEventLog(logPath, state, logFile)) {
+        return 1;
+    }
+
+    ReplayResult result = runReplay(state, reader);
+
+    double ticksPerSecond = result.seconds > 0.0 ? result.ticksRun / result.seconds : 0.0;
+
+    std::cout << "Replay " << (result.matched ? "OK" : "MISMATCH") << "\n";
+    std::cout << "  Ticks:            " << result.ticksRun << "\n";
+    std::cout << "  Key events:       " << result.eventsApplied << "\n";
+    std::cout << "  Total time:       " << result.seconds << " s\n";
+    std::cout << "  Ticks/sec:        " << static_cast<unsigned long long>(ticksPerSecond) << "\n";
+    std::cout << std::hex;
+    std::cout << "  Expected hash:    " << result.expectedHash << "\n";
+    std::cout << "  Actual hash:      " << result.actualHash << "\n";
+    std::cout << std::dec;
+    if (!reader.isValid()) {
+        std::cout << "  Error:            " << reader.error() << "\n";
+    }
+
+    return result.matched ? 0 : 2;
+}
+
+int main(int argc, char* argv[]) {
+    // Parse command line options
+    bool headless = false;
+    HeadlessConfig headlessConfig;
+    FileOptions files;
+    std::size_t enemyCount = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        unsigned long long number = 0;
+
+        if (std::strcmp(arg, "--headless") == 0) {
+            headless = true;
+        } else if (std::strcmp(arg, "--ticks") == 0 && value && parseNumber(value, number)) {
+            headlessConfig.ticks = number;
+            ++i;
+        } else if (std::strcmp(arg, "--seed") == 0 && value && parseNumber(value, number)) {
+            headlessConfig.seed = static_cast<std::uint32_t>(number);
+            ++i;
+        } else if (std::strcmp(arg, "--script") == 0 && value && value[0] != '\0') {
+            headlessConfig.script = value;
+            ++i;
+        } else if (std::strcmp(arg, "--key-interval") == 0 && value && parseNumber(value, number)) {
+            headlessConfig.keyInterval = static_cast<int>(number);
+            ++i;
+        } else if (std::strcmp(arg, "--render-every") == 0 && value && parseNumber(value, number)) {
+            headlessConfig.renderEvery = static_cast<int>(number);
+            ++i;
+        } else if (std::strcmp(arg, "--enemies") == 0 && value && parseNumber(value, number)) {
+            enemyCount = static_cast<std::size_t>(number);
+            ++i;
+        } else if (std::strcmp(arg, "--ai-threads") == 0 && value && parseNumber(value, number)) {
+            setEnemyAIThreads(static_cast<unsigned>(number));
+            ++i;
+        } else if (std::strcmp(arg, "--record") == 0 && value) {
+            files.record = value;
+            ++i;
+        } else if (std::strcmp(arg, "--replay") == 0 && value) {
+            files.replay = value;
+            ++i;
+        } else if (std::strcmp(arg, "--map") == 0 && value) {
+            files.map = value;
+            ++i;
+        } else if (std::strcmp(arg, "--log") == 0 && value) {
+            files.log = value;
+            ++i;
+        } else if (std::strcmp(arg, "--save") == 0 && value) {
+            files.save = value;
+            ++i;
+        } else if (std::strcmp(arg, "--load") == 0 && value) {
+            files.load = value;
+            ++i;
+        } else if (std::strcmp(arg, "--profile") == 0 && value) {
+            files.profile = value;
+            ++i;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    // Replays always start from a new game, and verify rather than play
+    if ((files.load && (files.record || files.replay)) || (files.save && files.replay)) {
+        std::cerr << "--load cannot be combined with --record or --replay, "
+                  << "nor --save with --replay\n";
+        return 1;
+    }
+
+    std::shared_ptr<TileMap> world;
+    if (!loadWorld(files.map, world)) {
+        return 1;
+    }
+
+    if (files.replay) {
+        return runReplayMode(files.replay, files.log, std::move(world));
+    }
+    if (headless) {
+        return runHeadlessMode(headlessConfig, enemyCount, files, std::move(world));
+    }
+
     // Display welcome message
     std::cout << "========================================\n";
     std::cout << "     DUNGEON CRAWLER v1.0               \n";
@@ -29,18 +409,64 @@ int main() {
     std::cin.get();
 
     // GAME INITIALIZATION
-    // Create game state with starting player stats
-    // Parameters: player health, player attack damage
-    GameState state{100, 2};
+    // Create game state with starting player stats (or resume a saved game)
+    // Pick a fresh seed each session, but remember it so the session can
+    // be recorded and replayed exactly
+    std::uint32_t seed = std::random_device{}();
+    std::unique_ptr<GameState> game = startGame(files.load, enemyCount, seed, std::move(world));
+    if (!game) {
+        return 1;
+    }
+    GameState& state = *game;
+
+    std::unique_ptr<ReplayRecorder> recorder;
+    if (files.record) {
+        recorder = std::make_unique<ReplayRecorder>(files.record, seed, state.ticksPerSecond,
+                                                    state.enemies.size());
+        if (!recorder->isOpen()) {
+            std::cerr << "Cannot write replay: " << files.record << "\n";
+            return 1;
+        }
+    }
+
+    std::unique_ptr<EventLogFile> logFile;
+    if (!openEventLog(files.log, state, logFile)) {
+        return 1;
+    }
 
     // MAIN GAME LOOP
     // Run the game loop - this handles all gameplay until exit
     // Loop ends when player quits or dies
-    runGame(state);
+    std::unique_ptr<AutoSaver> autosaver = startAutosave(files.save, state);
+    startProfiling(files.profile);
+    GameRunStats session = runGame(state, SimClockConfig{}, recorder.get(), autosaver.get());
 
     // GAME OVER
     // Display final statistics and game over message
     displayGameOver(state);
 
+    // Report how well the simulation kept to its fixed tick rate
+    const SimClockStats& timing = session.clock;
+    std::cout << "Simulation: " << timing.ticks << " ticks ("
+              << timing.lateTicks << " late, "
+              << timing.droppedTicks << " dropped)\n";
+
+    // And how quickly key presses reached the screen
+    const InputStats& input = session.input;
+    std::cout << "Input: " << input.keysRead << " keys";
+    if (input.keysDropped > 0) {
+        std::cout << " (" << input.keysDropped << " dropped)";
+    }
+    if (input.latencySamples > 0) {
+        std::cout << std::fixed << std::setprecision(1)
+                  << ", key to screen " << input.meanLatencyMs << " ms average, "
+                  << input.maxLatencyMs << " ms worst";
+    }
+    std::cout << "\n";
+
+    // After the game-over frame, which clears the screen below its origin
+    finishAutosave(autosaver.get(), files.save);
+    finishProfiling(files.profile);
+
     return 0;
 }